@@ -14,10 +14,13 @@ public:
       logger_t logger, std::vector<std::string> include_paths,
       std::string working_directory,
       const std::map<std::string, callable_symbol_s> &callable_symbols,
-      kernels::kernel_context_if *kernel_context)
+      kernels::kernel_context_if *kernel_context,
+      kernels::kernel_definition_cache_c *kernel_definitions)
       : logger_(logger), include_paths_(std::move(include_paths)),
         working_directory_(std::move(working_directory)),
         callable_symbols_(callable_symbols), kernel_context_(kernel_context),
+        kernel_definitions_(kernel_definitions ? kernel_definitions
+                                               : &own_kernel_definitions_),
         next_lambda_id_(1), loop_depth_(0) {
 
     std::vector<std::pair<std::string, slp::slp_type_e>> base_types = {
@@ -253,6 +256,8 @@ private:
   std::string working_directory_;
   const std::map<std::string, callable_symbol_s> &callable_symbols_;
   kernels::kernel_context_if *kernel_context_;
+  kernels::kernel_definition_cache_c own_kernel_definitions_;
+  kernels::kernel_definition_cache_c *kernel_definitions_;
 
   std::vector<std::map<std::string, type_info_s>> scopes_;
   std::map<std::string, type_info_s> type_symbol_map_;
@@ -318,14 +323,7 @@ type_info_s compiler_context_c::eval_type(slp::slp_object_c &object) {
     return result;
 
   case slp::slp_type_e::SOME: {
-    const std::uint8_t *base_ptr = object.get_data().data();
-    const std::uint8_t *unit_ptr = base_ptr + object.get_root_offset();
-    const slp::slp_unit_of_store_t *unit =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-    size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-    auto inner_obj = slp::slp_object_c::from_data(
-        object.get_data(), object.get_symbols(), inner_offset);
+    auto inner_obj = object.inner();
 
     result.base_type = inner_obj.type();
     return result;
@@ -471,14 +469,7 @@ type_info_s compiler_context_c::eval_type(slp::slp_object_c &object) {
   }
 
   case slp::slp_type_e::DATUM: {
-    const std::uint8_t *base_ptr = object.get_data().data();
-    const std::uint8_t *unit_ptr = base_ptr + object.get_root_offset();
-    const slp::slp_unit_of_store_t *unit =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-    size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-    auto inner_obj = slp::slp_object_c::from_data(
-        object.get_data(), object.get_symbols(), inner_offset);
+    auto inner_obj = object.inner();
 
     if (inner_obj.type() != slp::slp_type_e::PAREN_LIST) {
       result.base_type = slp::slp_type_e::DATUM;
@@ -577,28 +568,11 @@ compiler_context_c::resolve_kernel_path(const std::string &kernel_name) {
 
 bool compiler_context_c::load_kernel_types(const std::string &kernel_name,
                                            const std::string &kernel_dir) {
-  auto kernel_sxs_path = std::filesystem::path(kernel_dir) / "kernel.sxs";
-
-  std::ifstream file(kernel_sxs_path);
-  if (!file.is_open()) {
-    logger_->error("Could not open kernel.sxs: {}", kernel_sxs_path.string());
+  slp::slp_object_c kernel_obj;
+  if (!kernel_definitions_->get(kernel_dir, logger_, kernel_obj)) {
     return false;
   }
 
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  std::string source = buffer.str();
-  file.close();
-
-  auto parse_result = slp::parse(source);
-  if (parse_result.is_error()) {
-    logger_->error("Failed to parse kernel.sxs: {}",
-                   parse_result.error().message);
-    return false;
-  }
-
-  auto kernel_obj = parse_result.take();
-
   std::vector<slp::slp_object_c> datums;
 
   if (kernel_obj.type() == slp::slp_type_e::BRACKET_LIST) {
@@ -622,14 +596,7 @@ bool compiler_context_c::load_kernel_types(const std::string &kernel_name,
       continue;
     }
 
-    const std::uint8_t *base_ptr = datum.get_data().data();
-    const std::uint8_t *unit_ptr = base_ptr + datum.get_root_offset();
-    const slp::slp_unit_of_store_t *unit =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-    size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-    auto inner_obj = slp::slp_object_c::from_data(
-        datum.get_data(), datum.get_symbols(), inner_offset);
+    auto inner_obj = datum.inner();
 
     if (inner_obj.type() != slp::slp_type_e::PAREN_LIST) {
       logger_->warn("kernel.sxs: datum must contain a paren list");
@@ -698,9 +665,7 @@ bool compiler_context_c::load_kernel_types(const std::string &kernel_name,
       logger_->debug("Registered kernel form: {}", form_name);
 
     } else if (cmd_name == "define-kernel") {
-      define_kernel_obj = slp::slp_object_c::from_data(
-          inner_obj.get_data(), inner_obj.get_symbols(),
-          inner_obj.get_root_offset());
+      define_kernel_obj = inner_obj.share();
       found_define_kernel = true;
     }
   }
@@ -858,10 +823,11 @@ std::unique_ptr<compiler_context_if> create_compiler_context(
     logger_t logger, std::vector<std::string> include_paths,
     std::string working_directory,
     const std::map<std::string, callable_symbol_s> &callable_symbols,
-    kernels::kernel_context_if *kernel_context) {
-  return std::make_unique<compiler_context_c>(logger, std::move(include_paths),
-                                              std::move(working_directory),
-                                              callable_symbols, kernel_context);
+    kernels::kernel_context_if *kernel_context,
+    kernels::kernel_definition_cache_c *kernel_definitions) {
+  return std::make_unique<compiler_context_c>(
+      logger, std::move(include_paths), std::move(working_directory),
+      callable_symbols, kernel_context, kernel_definitions);
 }
 
 } // namespace pkg::core
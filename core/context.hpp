@@ -14,6 +14,7 @@ struct callable_symbol_s;
 
 namespace kernels {
 class kernel_context_if;
+class kernel_definition_cache_c;
 }
 
 typedef std::shared_ptr<spdlog::logger> logger_t;
@@ -109,6 +110,7 @@ std::unique_ptr<compiler_context_if> create_compiler_context(
     logger_t logger, std::vector<std::string> include_paths,
     std::string working_directory,
     const std::map<std::string, callable_symbol_s> &callable_symbols,
-    kernels::kernel_context_if *kernel_context = nullptr);
+    kernels::kernel_context_if *kernel_context = nullptr,
+    kernels::kernel_definition_cache_c *kernel_definitions = nullptr);
 
 } // namespace pkg::core
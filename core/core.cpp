@@ -3,12 +3,27 @@
 #include "interpreter.hpp"
 #include "kernels/kernels.hpp"
 #include "type_checker/type_checker.hpp"
+#include "vm/vm.hpp"
 #include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <iterator>
 
 namespace pkg::core {
 
+namespace {
+
+bool read_file_bytes(const std::string &path, std::vector<std::uint8_t> &out) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  out.assign(std::istreambuf_iterator<char>(file),
+             std::istreambuf_iterator<char>());
+  return true;
+}
+
+} // namespace
+
 core_c::core_c(const option_s &options) : options_(options) {
   if (!options_.logger) {
     throw std::runtime_error("Logger must be provided");
@@ -31,50 +46,33 @@ core_c::~core_c() = default;
 
 int core_c::run() {
   try {
-    options_.logger->info("Loading SLP file: {}", options_.file_path);
-
-    auto tcs_logger = options_.logger->clone("tcs");
-    type_checker::type_checker_c type_checker(
-        tcs_logger, options_.include_paths, options_.working_directory);
-
-    options_.logger->info("Validating code (types and symbols)...");
-    if (!type_checker.check(options_.file_path)) {
-      options_.logger->error("Validation failed");
-      return 1;
-    }
-
-    std::ifstream file(options_.file_path);
-    if (!file.is_open()) {
+    std::vector<std::uint8_t> bytes;
+    if (!read_file_bytes(options_.file_path, bytes)) {
       options_.logger->error("Failed to open file: {}", options_.file_path);
       return 1;
     }
+    if (vm::is_image(bytes)) {
+      return run_image(std::move(bytes));
+    }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string source = buffer.str();
-    file.close();
+    options_.logger->info("Loading SLP file: {}", options_.file_path);
 
-    options_.logger->debug("Source size: {} bytes", source.size());
+    std::string source(bytes.begin(), bytes.end());
 
-    auto parse_result = slp::parse(source);
+    options_.logger->debug("Source size: {} bytes", source.size());
 
-    if (parse_result.is_error()) {
-      const auto &error = parse_result.error();
-      options_.logger->error("Parse error: {}", error.message);
-      options_.logger->error("At byte position: {}", error.byte_position);
+    slp::slp_object_c program;
+    if (!check_program(source, program)) {
       return 1;
     }
 
-    options_.logger->info("Parse successful");
-
     auto symbols = instructions::get_standard_callable_symbols();
     auto interpreter =
         create_interpreter(symbols, &kernel_manager_->get_kernel_context());
 
     kernel_manager_->set_parent_context(interpreter.get());
 
-    auto obj = parse_result.take();
-    auto result = interpreter->eval(obj);
+    auto result = interpreter->eval(program);
 
     auto kernel_functions = kernel_manager_->get_registered_functions();
     for (const auto &[name, symbol] : kernel_functions) {
@@ -91,4 +89,93 @@ int core_c::run() {
   }
 }
 
+/*
+    Type checks the source and hands back the tree the checker parsed, so a
+    run reads and parses the file once. Kernel definitions the checker loads
+    land in the kernel manager's cache for the same reason.
+*/
+bool core_c::check_program(const std::string &source,
+                           slp::slp_object_c &program) {
+  auto tcs_logger = options_.logger->clone("tcs");
+  type_checker::type_checker_c type_checker(
+      tcs_logger, options_.include_paths, options_.working_directory,
+      &kernel_manager_->get_definition_cache());
+
+  options_.logger->info("Validating code (types and symbols)...");
+  auto source_name = std::filesystem::canonical(options_.file_path).string();
+  if (!type_checker.check_source(source, source_name, program)) {
+    options_.logger->error("Validation failed");
+    return false;
+  }
+
+  return true;
+}
+
+int core_c::run_image(std::vector<std::uint8_t> image_bytes) {
+  try {
+    options_.logger->info("Loading image: {}", options_.file_path);
+
+    auto image = vm::load_image(image_bytes);
+
+    auto symbols = instructions::get_standard_callable_symbols();
+    auto interpreter =
+        create_interpreter(symbols, &kernel_manager_->get_kernel_context());
+
+    kernel_manager_->set_parent_context(interpreter.get());
+
+    vm::vm_c machine(*interpreter, std::move(image), symbols);
+    machine.run();
+
+    options_.logger->info("Execution complete");
+
+    return 0;
+
+  } catch (const std::exception &e) {
+    options_.logger->error("Exception during execution: {}", e.what());
+    return 1;
+  }
+}
+
+int core_c::compile(const std::string &output_path) {
+  try {
+    std::vector<std::uint8_t> source;
+    if (!read_file_bytes(options_.file_path, source)) {
+      options_.logger->error("Failed to open file: {}", options_.file_path);
+      return 1;
+    }
+
+    slp::slp_object_c program;
+    if (!check_program(std::string(source.begin(), source.end()), program)) {
+      return 1;
+    }
+
+    auto symbols = instructions::get_standard_callable_symbols();
+    instructions::generation::generator_c generator(symbols);
+
+    auto image = generator.generate(program);
+    auto bytes = vm::serialize_image(image);
+
+    std::ofstream out(output_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      options_.logger->error("Failed to open output file: {}", output_path);
+      return 1;
+    }
+    out.write(reinterpret_cast<const char *>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+      options_.logger->error("Failed to write image: {}", output_path);
+      return 1;
+    }
+
+    options_.logger->info("Compiled {} ({} functions, {} bytes) -> {}",
+                          options_.file_path, image.functions.size(),
+                          bytes.size(), output_path);
+    return 0;
+
+  } catch (const std::exception &e) {
+    options_.logger->error("Exception during compilation: {}", e.what());
+    return 1;
+  }
+}
+
 } // namespace pkg::core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <slp/slp.hpp>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <vector>
@@ -27,11 +28,18 @@ public:
   explicit core_c(const option_s &options);
   ~core_c();
 
+  // Runs the file at file_path, either source or a compiled image
   int run();
 
+  // Type checks and compiles the source at file_path to an image
+  int compile(const std::string &output_path);
+
 private:
   option_s options_;
   std::unique_ptr<kernels::kernel_manager_c> kernel_manager_;
+
+  bool check_program(const std::string &source, slp::slp_object_c &program);
+  int run_image(std::vector<std::uint8_t> image_bytes);
 };
 
 } // namespace pkg::core
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "datum.hpp"
 #include "core/instructions/interpretation/interpretation.hpp"
 #include "core/instructions/typechecking/typechecking.hpp"
+#include <slp/symbols.hpp>
+#include <utility>
+#include <vector>
 
 namespace pkg::core::datum {
 
@@ -28,4 +31,34 @@ get_standard_callable_symbols() {
   return symbols;
 }
 
+namespace {
+
+struct datum_dispatch_s {
+  std::vector<std::pair<std::uint64_t, callable_symbol_s>> entries;
+
+  datum_dispatch_s() {
+    auto symbols = get_standard_callable_symbols();
+    entries.reserve(symbols.size());
+    for (auto &[name, symbol] : symbols) {
+      entries.emplace_back(slp::symbol_table().intern(name), std::move(symbol));
+    }
+  }
+};
+
+const datum_dispatch_s &datum_dispatch() {
+  static const datum_dispatch_s table;
+  return table;
+}
+
+} // namespace
+
+const callable_symbol_s *find_datum_callable(std::uint64_t symbol_id) {
+  for (const auto &[id, symbol] : datum_dispatch().entries) {
+    if (id == symbol_id) {
+      return &symbol;
+    }
+  }
+  return nullptr;
+}
+
 } // namespace pkg::core::datum
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/interpreter.hpp"
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -9,4 +10,15 @@ namespace pkg::core::datum {
 extern std::map<std::string, pkg::core::callable_symbol_s>
 get_standard_callable_symbols();
 
-}
\ No newline at end of file
+/*
+    Datum callables resolved by interned symbol id. The table is built once,
+    on first use, from get_standard_callable_symbols() and never changes, so
+    evaluating a datum costs an integer compare per entry instead of building
+    and searching a fresh string map.
+
+    Returns nullptr if the symbol is not a datum callable.
+*/
+extern const pkg::core::callable_symbol_s *
+find_datum_callable(std::uint64_t symbol_id);
+
+}
@@ -1,110 +1,371 @@
 #include "generation.hpp"
 #include "core/interpreter.hpp"
 #include "slp/slp.hpp"
+#include <cstdint>
 #include <fmt/core.h>
+#include <stdexcept>
 
 namespace pkg::core::instructions::generation {
 
-byte_vector_t make_define(callable_context_if &context,
+using vm::opcode_e;
+
+generator_c::generator_c(
+    const std::map<std::string, callable_symbol_s> &callable_symbols)
+    : callable_symbols_(callable_symbols) {}
+
+vm::image_s generator_c::generate(slp::slp_object_c &program) {
+  functions_.clear();
+  functions_.emplace_back();
+
+  byte_vector_t entry = compile(program);
+  emit(entry, opcode_e::RETURN);
+  functions_[0] = std::move(entry);
+
+  size_t root = constants_.add_list(slp::slp_type_e::BRACE_LIST,
+                                    constant_offsets_.data(),
+                                    constant_offsets_.size());
+
+  vm::image_s image;
+  image.functions = std::move(functions_);
+  image.constants = constants_.take(root);
+
+  constants_ = slp::slp_builder_c();
+  constant_offsets_.clear();
+  symbol_constants_.clear();
+  functions_.clear();
+  return image;
+}
+
+byte_vector_t generator_c::compile(slp::slp_object_c &object) {
+  byte_vector_t code;
+
+  switch (object.type()) {
+  case slp::slp_type_e::SYMBOL:
+    emit(code, opcode_e::LOAD, add_constant(object));
+    return code;
+
+  case slp::slp_type_e::SOME: {
+    // The interpreter unwraps SOME without evaluating what it holds
+    auto inner = object.inner();
+    emit(code, opcode_e::PUSH_CONST, add_constant(inner));
+    return code;
+  }
+
+  case slp::slp_type_e::DATUM:
+    return fallback(object);
+
+  case slp::slp_type_e::PAREN_LIST:
+    if (object.as_list().empty()) {
+      emit(code, opcode_e::PUSH_CONST, add_constant(object));
+      return code;
+    }
+    return compile_call(object);
+
+  case slp::slp_type_e::BRACKET_LIST:
+    return compile_sequence(object);
+
+  default:
+    emit(code, opcode_e::PUSH_CONST, add_constant(object));
+    return code;
+  }
+}
+
+byte_vector_t generator_c::compile_sequence(slp::slp_object_c &bracket_list) {
+  byte_vector_t code;
+  auto list = bracket_list.as_list();
+  if (list.empty()) {
+    emit(code, opcode_e::PUSH_NONE);
+    return code;
+  }
+
+  bool lock_emitted = false;
+  for (size_t i = 0; i < list.size(); i++) {
+    auto elem = list.at(i);
+    if (!lock_emitted && elem.type() != slp::slp_type_e::DATUM) {
+      emit(code, opcode_e::LOCK_KERNELS);
+      lock_emitted = true;
+    }
+    if (i > 0) {
+      emit(code, opcode_e::POP);
+    }
+    append(code, compile(elem));
+  }
+  return code;
+}
+
+/*
+    Builtins are fixed when the image is generated and can not be shadowed,
+    so they lower through their instruction generator. Anything else may be a
+    kernel function or a lambda, which is only known at runtime; the call
+    keeps the form (kernels receive it unevaluated) and compiles each argument
+    as its own function for when the target turns out to be a lambda.
+*/
+byte_vector_t generator_c::compile_call(slp::slp_object_c &form) {
+  auto list = form.as_list();
+  auto head = list.at(0);
+  if (head.type() != slp::slp_type_e::SYMBOL) {
+    return fallback(form);
+  }
+
+  auto builtin = callable_symbols_.find(head.as_symbol());
+  if (builtin != callable_symbols_.end()) {
+    if (builtin->second.instruction_generator) {
+      return builtin->second.instruction_generator(*this, form);
+    }
+    return builtin_call(form);
+  }
+
+  std::uint32_t form_constant = add_constant(form);
+  std::uint32_t argc = static_cast<std::uint32_t>(list.size() - 1);
+  std::uint32_t first_arg = static_cast<std::uint32_t>(functions_.size());
+  for (size_t i = 1; i < list.size(); i++) {
+    functions_.emplace_back();
+  }
+  for (size_t i = 1; i < list.size(); i++) {
+    auto arg = list.at(i);
+    byte_vector_t arg_code = compile(arg);
+    emit(arg_code, opcode_e::RETURN);
+    functions_[first_arg + i - 1] = std::move(arg_code);
+  }
+
+  byte_vector_t code;
+  emit(code, opcode_e::CALL, form_constant);
+  emit_u32(code, first_arg);
+  emit_u32(code, argc);
+  return code;
+}
+
+byte_vector_t generator_c::fallback(const slp::slp_object_c &form) {
+  byte_vector_t code;
+  emit(code, opcode_e::EVAL, add_constant(form));
+  return code;
+}
+
+byte_vector_t generator_c::builtin_call(const slp::slp_object_c &form) {
+  auto head = form.as_list().at(0);
+  byte_vector_t code;
+  emit(code, opcode_e::CALL_BUILTIN, add_constant(head));
+  emit_u32(code, add_constant(form));
+  return code;
+}
+
+std::uint32_t generator_c::add_constant(const slp::slp_object_c &object) {
+  if (object.type() == slp::slp_type_e::SYMBOL) {
+    auto it = symbol_constants_.find(object.as_symbol_id());
+    if (it != symbol_constants_.end()) {
+      return it->second;
+    }
+  }
+
+  std::uint32_t index = static_cast<std::uint32_t>(constant_offsets_.size());
+  constant_offsets_.push_back(constants_.add_object(object));
+  if (object.type() == slp::slp_type_e::SYMBOL) {
+    symbol_constants_[object.as_symbol_id()] = index;
+  }
+  return index;
+}
+
+std::uint32_t generator_c::add_function(byte_vector_t code) {
+  functions_.push_back(std::move(code));
+  return static_cast<std::uint32_t>(functions_.size() - 1);
+}
+
+void generator_c::emit(byte_vector_t &code, opcode_e op) {
+  code.push_back(static_cast<std::uint8_t>(op));
+}
+
+void generator_c::emit(byte_vector_t &code, opcode_e op,
+                       std::uint32_t operand) {
+  emit(code, op);
+  emit_u32(code, operand);
+}
+
+void generator_c::emit_u32(byte_vector_t &code, std::uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    code.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+void generator_c::emit_jump(byte_vector_t &code, opcode_e op,
+                            std::int64_t displacement) {
+  if (displacement < INT32_MIN || displacement > INT32_MAX) {
+    throw std::runtime_error("generation: jump out of range");
+  }
+  emit(code, op,
+       static_cast<std::uint32_t>(static_cast<std::int32_t>(displacement)));
+}
+
+void generator_c::append(byte_vector_t &code, const byte_vector_t &more) {
+  code.insert(code.end(), more.begin(), more.end());
+}
+
+byte_vector_t make_define(generator_c &generator,
                           slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_define\n");
-  return byte_vector_t();
+  auto list = args_list.as_list();
+  if (list.size() != 3 || list.at(1).type() != slp::slp_type_e::SYMBOL) {
+    return generator.fallback(args_list);
+  }
+
+  std::uint32_t symbol = generator.add_constant(list.at(1));
+  auto value = list.at(2);
+
+  byte_vector_t code;
+  generator_c::emit(code, opcode_e::DECLARE, symbol);
+  generator_c::append(code, generator.compile(value));
+  generator_c::emit(code, opcode_e::DEFINE, symbol);
+  return code;
 }
 
-byte_vector_t make_fn(callable_context_if &context,
-                      slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_fn\n");
-  return byte_vector_t();
+/*
+    The body becomes a function of its own. MAKE_LAMBDA still registers the
+    lambda with the runtime context (keeping the fn form as a constant) so
+    apply, kernels and interpreted code can call it; calls made from
+    bytecode run the compiled body instead.
+*/
+byte_vector_t make_fn(generator_c &generator, slp::slp_object_c &args_list) {
+  auto list = args_list.as_list();
+  if (list.size() != 4 ||
+      list.at(1).type() != slp::slp_type_e::PAREN_LIST ||
+      list.at(2).type() != slp::slp_type_e::SYMBOL ||
+      list.at(3).type() != slp::slp_type_e::BRACKET_LIST) {
+    return generator.fallback(args_list);
+  }
+
+  auto body = list.at(3);
+  byte_vector_t body_code = generator.compile(body);
+  generator_c::emit(body_code, opcode_e::RETURN);
+  std::uint32_t function = generator.add_function(std::move(body_code));
+
+  byte_vector_t code;
+  generator_c::emit(code, opcode_e::MAKE_LAMBDA,
+                    generator.add_constant(args_list));
+  generator_c::emit_u32(code, function);
+  return code;
 }
 
-byte_vector_t make_debug(callable_context_if &context,
+byte_vector_t make_debug(generator_c &generator,
                          slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_debug\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_export(callable_context_if &context,
+byte_vector_t make_export(generator_c &generator,
                           slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_export\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_if(callable_context_if &context,
-                      slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_if\n");
-  return byte_vector_t();
+byte_vector_t make_if(generator_c &generator, slp::slp_object_c &args_list) {
+  auto list = args_list.as_list();
+  if (list.size() != 4) {
+    return generator.fallback(args_list);
+  }
+
+  auto condition = list.at(1);
+  auto true_branch = list.at(2);
+  auto false_branch = list.at(3);
+
+  byte_vector_t true_code = generator.compile(true_branch);
+  byte_vector_t false_code = generator.compile(false_branch);
+
+  byte_vector_t code = generator.compile(condition);
+  generator_c::emit_jump(code, opcode_e::JUMP_IF_FALSE,
+                         static_cast<std::int64_t>(true_code.size()) +
+                             generator_c::jump_size);
+  generator_c::append(code, true_code);
+  generator_c::emit_jump(code, opcode_e::JUMP,
+                         static_cast<std::int64_t>(false_code.size()));
+  generator_c::append(code, false_code);
+  return code;
 }
 
-byte_vector_t make_reflect(callable_context_if &context,
+byte_vector_t make_reflect(generator_c &generator,
                            slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_reflect\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_try(callable_context_if &context,
-                       slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_try\n");
-  return byte_vector_t();
+byte_vector_t make_try(generator_c &generator, slp::slp_object_c &args_list) {
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_assert(callable_context_if &context,
+byte_vector_t make_assert(generator_c &generator,
                           slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_assert\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_recover(callable_context_if &context,
+byte_vector_t make_recover(generator_c &generator,
                            slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_recover\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_eval(callable_context_if &context,
+byte_vector_t make_eval(generator_c &generator,
                         slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_eval\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_apply(callable_context_if &context,
+byte_vector_t make_apply(generator_c &generator,
                          slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_apply\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_match(callable_context_if &context,
+byte_vector_t make_match(generator_c &generator,
                          slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_match\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_cast(callable_context_if &context,
+byte_vector_t make_cast(generator_c &generator,
                         slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_cast\n");
-  return byte_vector_t();
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_do(callable_context_if &context,
-                      slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_do\n");
-  return byte_vector_t();
+/*
+    LOOP_ENTER
+    start: <body>, POP
+           LOOP_CONTINUE start
+    LOOP_LEAVE
+
+    The body runs in the loop's own frame; LOOP_CONTINUE clears it and
+    advances $iterations in place between passes.
+*/
+byte_vector_t make_do(generator_c &generator, slp::slp_object_c &args_list) {
+  auto list = args_list.as_list();
+  if (list.size() != 2 ||
+      list.at(1).type() != slp::slp_type_e::BRACKET_LIST) {
+    return generator.fallback(args_list);
+  }
+
+  auto body = list.at(1);
+
+  byte_vector_t iteration = generator.compile(body);
+  generator_c::emit(iteration, opcode_e::POP);
+
+  byte_vector_t code;
+  generator_c::emit(code, opcode_e::LOOP_ENTER);
+  generator_c::append(code, iteration);
+  generator_c::emit_jump(code, opcode_e::LOOP_CONTINUE,
+                         -(static_cast<std::int64_t>(iteration.size()) +
+                           generator_c::jump_size));
+  generator_c::emit(code, opcode_e::LOOP_LEAVE);
+  return code;
 }
 
-byte_vector_t make_done(callable_context_if &context,
+byte_vector_t make_done(generator_c &generator,
                         slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_done\n");
-  return byte_vector_t();
+  auto list = args_list.as_list();
+  if (list.size() != 2) {
+    return generator.fallback(args_list);
+  }
+
+  auto value = list.at(1);
+  byte_vector_t code = generator.compile(value);
+  generator_c::emit(code, opcode_e::LOOP_DONE);
+  return code;
 }
 
-byte_vector_t make_at(callable_context_if &context,
-                      slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_at\n");
-  return byte_vector_t();
+byte_vector_t make_at(generator_c &generator, slp::slp_object_c &args_list) {
+  return generator.builtin_call(args_list);
 }
 
-byte_vector_t make_eq(callable_context_if &context,
-                      slp::slp_object_c &args_list) {
-  fmt::print("[GENERATION] make_eq\n");
-  return byte_vector_t();
+byte_vector_t make_eq(generator_c &generator, slp::slp_object_c &args_list) {
+  return generator.builtin_call(args_list);
 }
 
-} // namespace pkg::core::instructions::generation
\ No newline at end of file
+} // namespace pkg::core::instructions::generation
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "core/vm/bytecode.hpp"
+#include "slp/builder.hpp"
 #include "slp/slp.hpp"
+#include <functional>
+#include <map>
+#include <string>
 
 namespace pkg::core {
-class callable_context_if;
+struct callable_symbol_s;
 }
 
 namespace pkg::core::instructions::generation {
@@ -32,59 +37,109 @@ enum class hll_instruction_e {
 
 typedef std::vector<std::uint8_t> byte_vector_t;
 
-typedef std::function<byte_vector_t(callable_context_if &context,
+/*
+    Lowers slp objects to vm bytecode (see core/vm/bytecode.hpp). The
+    generator owns the constant pool and function table of the image being
+    built; instruction generators call back into it to compile their
+    operands and to register constants and nested functions.
+
+    Every byte_vector_t handed out is position independent (jumps are
+    relative), so generators are free to concatenate them.
+*/
+class generator_c {
+public:
+  explicit generator_c(
+      const std::map<std::string, callable_symbol_s> &callable_symbols);
+
+  // Compiles `program` as the entry function and returns the finished image
+  vm::image_s generate(slp::slp_object_c &program);
+
+  // Code leaving the value of `object` on the stack
+  byte_vector_t compile(slp::slp_object_c &object);
+
+  // Code that has the runtime context evaluate `form` as-is
+  byte_vector_t fallback(const slp::slp_object_c &form);
+
+  // Code calling the builtin at the head of `form` with the form, unevaluated
+  byte_vector_t builtin_call(const slp::slp_object_c &form);
+
+  std::uint32_t add_constant(const slp::slp_object_c &object);
+  std::uint32_t add_function(byte_vector_t code);
+
+  static void emit(byte_vector_t &code, vm::opcode_e op);
+  static void emit(byte_vector_t &code, vm::opcode_e op, std::uint32_t operand);
+  static void emit_u32(byte_vector_t &code, std::uint32_t value);
+  static void emit_jump(byte_vector_t &code, vm::opcode_e op,
+                        std::int64_t displacement);
+  static void append(byte_vector_t &code, const byte_vector_t &more);
+
+  // Size of a jump instruction, for computing displacements up front
+  static constexpr std::int64_t jump_size = 5;
+
+private:
+  const std::map<std::string, callable_symbol_s> &callable_symbols_;
+  slp::slp_builder_c constants_;
+  std::vector<size_t> constant_offsets_;
+  std::map<std::uint64_t, std::uint32_t> symbol_constants_;
+  std::vector<byte_vector_t> functions_;
+
+  byte_vector_t compile_sequence(slp::slp_object_c &bracket_list);
+  byte_vector_t compile_call(slp::slp_object_c &form);
+};
+
+typedef std::function<byte_vector_t(generator_c &generator,
                                     slp::slp_object_c &args_list)>
     instruction_generator_fn_t;
 
-extern byte_vector_t make_define(callable_context_if &context,
+extern byte_vector_t make_define(generator_c &generator,
                                  slp::slp_object_c &args_list);
 
-extern byte_vector_t make_fn(callable_context_if &context,
+extern byte_vector_t make_fn(generator_c &generator,
                              slp::slp_object_c &args_list);
 
-extern byte_vector_t make_debug(callable_context_if &context,
+extern byte_vector_t make_debug(generator_c &generator,
                                 slp::slp_object_c &args_list);
 
-extern byte_vector_t make_export(callable_context_if &context,
+extern byte_vector_t make_export(generator_c &generator,
                                  slp::slp_object_c &args_list);
 
-extern byte_vector_t make_if(callable_context_if &context,
+extern byte_vector_t make_if(generator_c &generator,
                              slp::slp_object_c &args_list);
 
-extern byte_vector_t make_reflect(callable_context_if &context,
+extern byte_vector_t make_reflect(generator_c &generator,
                                   slp::slp_object_c &args_list);
 
-extern byte_vector_t make_try(callable_context_if &context,
+extern byte_vector_t make_try(generator_c &generator,
                               slp::slp_object_c &args_list);
 
-extern byte_vector_t make_assert(callable_context_if &context,
+extern byte_vector_t make_assert(generator_c &generator,
                                  slp::slp_object_c &args_list);
 
-extern byte_vector_t make_recover(callable_context_if &context,
+extern byte_vector_t make_recover(generator_c &generator,
                                   slp::slp_object_c &args_list);
 
-extern byte_vector_t make_eval(callable_context_if &context,
+extern byte_vector_t make_eval(generator_c &generator,
                                slp::slp_object_c &args_list);
 
-extern byte_vector_t make_apply(callable_context_if &context,
+extern byte_vector_t make_apply(generator_c &generator,
                                 slp::slp_object_c &args_list);
 
-extern byte_vector_t make_match(callable_context_if &context,
+extern byte_vector_t make_match(generator_c &generator,
                                 slp::slp_object_c &args_list);
 
-extern byte_vector_t make_cast(callable_context_if &context,
+extern byte_vector_t make_cast(generator_c &generator,
                                slp::slp_object_c &args_list);
 
-extern byte_vector_t make_do(callable_context_if &context,
+extern byte_vector_t make_do(generator_c &generator,
                              slp::slp_object_c &args_list);
 
-extern byte_vector_t make_done(callable_context_if &context,
+extern byte_vector_t make_done(generator_c &generator,
                                slp::slp_object_c &args_list);
 
-extern byte_vector_t make_at(callable_context_if &context,
+extern byte_vector_t make_at(generator_c &generator,
                              slp::slp_object_c &args_list);
 
-extern byte_vector_t make_eq(callable_context_if &context,
+extern byte_vector_t make_eq(generator_c &generator,
                              slp::slp_object_c &args_list);
 
 } // namespace pkg::core::instructions::generation
\ No newline at end of file
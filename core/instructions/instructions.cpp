@@ -19,7 +19,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_define,
-      .typecheck_function = typechecking::typecheck_define};
+      .typecheck_function = typechecking::typecheck_define,
+      .handles_pending_errors = true};
 
   symbols["fn"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -30,7 +31,8 @@ get_standard_callable_symbols() {
            {.name = "body", .type = slp::slp_type_e::BRACKET_LIST}},
       .variadic = false,
       .function = interpretation::interpret_fn,
-      .typecheck_function = typechecking::typecheck_fn};
+      .typecheck_function = typechecking::typecheck_fn,
+      .handles_pending_errors = true};
 
   symbols["debug"] =
       callable_symbol_s{.return_type = slp::slp_type_e::NONE,
@@ -38,7 +40,8 @@ get_standard_callable_symbols() {
                         .required_parameters = {},
                         .variadic = true,
                         .function = interpretation::interpret_debug,
-                        .typecheck_function = typechecking::typecheck_debug};
+                        .typecheck_function = typechecking::typecheck_debug,
+                        .handles_pending_errors = true};
 
   symbols["if"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -49,7 +52,8 @@ get_standard_callable_symbols() {
            {.name = "false_branch", .type = slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_if,
-      .typecheck_function = typechecking::typecheck_if};
+      .typecheck_function = typechecking::typecheck_if,
+      .handles_pending_errors = true};
 
   symbols["reflect"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -60,7 +64,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::PAREN_LIST}},
       .variadic = true,
       .function = interpretation::interpret_reflect,
-      .typecheck_function = typechecking::typecheck_reflect};
+      .typecheck_function = typechecking::typecheck_reflect,
+      .handles_pending_errors = true};
 
   symbols["try"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -72,7 +77,8 @@ get_standard_callable_symbols() {
       .injected_symbols = {{"$error", slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_try,
-      .typecheck_function = typechecking::typecheck_try};
+      .typecheck_function = typechecking::typecheck_try,
+      .handles_pending_errors = true};
 
   symbols["assert"] = callable_symbol_s{
       .return_type = slp::slp_type_e::NONE,
@@ -83,7 +89,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::DQ_LIST}},
       .variadic = false,
       .function = interpretation::interpret_assert,
-      .typecheck_function = typechecking::typecheck_assert};
+      .typecheck_function = typechecking::typecheck_assert,
+      .handles_pending_errors = true};
 
   symbols["recover"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -95,7 +102,8 @@ get_standard_callable_symbols() {
       .injected_symbols = {{"$exception", slp::slp_type_e::DQ_LIST}},
       .variadic = false,
       .function = interpretation::interpret_recover,
-      .typecheck_function = typechecking::typecheck_recover};
+      .typecheck_function = typechecking::typecheck_recover,
+      .handles_pending_errors = true};
 
   symbols["eval"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -104,7 +112,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::DQ_LIST}},
       .variadic = false,
       .function = interpretation::interpret_eval,
-      .typecheck_function = typechecking::typecheck_eval};
+      .typecheck_function = typechecking::typecheck_eval,
+      .handles_pending_errors = true};
 
   symbols["apply"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -115,7 +124,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::BRACE_LIST}},
       .variadic = false,
       .function = interpretation::interpret_apply,
-      .typecheck_function = typechecking::typecheck_apply};
+      .typecheck_function = typechecking::typecheck_apply,
+      .handles_pending_errors = true};
 
   symbols["match"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -126,7 +136,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::PAREN_LIST}},
       .variadic = true,
       .function = interpretation::interpret_match,
-      .typecheck_function = typechecking::typecheck_match};
+      .typecheck_function = typechecking::typecheck_match,
+      .handles_pending_errors = true};
 
   symbols["cast"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -136,7 +147,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_cast,
-      .typecheck_function = typechecking::typecheck_cast};
+      .typecheck_function = typechecking::typecheck_cast,
+      .handles_pending_errors = true};
 
   symbols["do"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -146,7 +158,8 @@ get_standard_callable_symbols() {
       .injected_symbols = {{"$iterations", slp::slp_type_e::INTEGER}},
       .variadic = false,
       .function = interpretation::interpret_do,
-      .typecheck_function = typechecking::typecheck_do};
+      .typecheck_function = typechecking::typecheck_do,
+      .handles_pending_errors = true};
 
   symbols["done"] = callable_symbol_s{
       .return_type = slp::slp_type_e::NONE,
@@ -155,7 +168,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_done,
-      .typecheck_function = typechecking::typecheck_done};
+      .typecheck_function = typechecking::typecheck_done,
+      .handles_pending_errors = true};
 
   symbols["at"] = callable_symbol_s{
       .return_type = slp::slp_type_e::ABERRANT,
@@ -166,7 +180,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_at,
-      .typecheck_function = typechecking::typecheck_at};
+      .typecheck_function = typechecking::typecheck_at,
+      .handles_pending_errors = true};
 
   symbols["eq"] = callable_symbol_s{
       .return_type = slp::slp_type_e::INTEGER,
@@ -177,7 +192,8 @@ get_standard_callable_symbols() {
                                .type = slp::slp_type_e::ABERRANT}},
       .variadic = false,
       .function = interpretation::interpret_eq,
-      .typecheck_function = typechecking::typecheck_eq};
+      .typecheck_function = typechecking::typecheck_eq,
+      .handles_pending_errors = true};
 
   return symbols;
 }
@@ -1,6 +1,7 @@
 #include "interpretation.hpp"
 #include "core/interpreter.hpp"
 #include "core/kernels/kernels.hpp"
+#include "slp/constants.hpp"
 #include "slp/slp.hpp"
 #include <fmt/core.h>
 
@@ -10,23 +11,26 @@ slp::slp_object_c interpret_define(callable_context_if &context,
                                    slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error("def requires exactly 2 arguments");
+    return context.raise_error("def requires exactly 2 arguments");
   }
 
   auto symbol_obj = list.at(1);
   if (symbol_obj.type() != slp::slp_type_e::SYMBOL) {
-    throw std::runtime_error("def requires first argument to be a symbol");
+    return context.raise_error("def requires first argument to be a symbol");
   }
 
   std::string symbol_name = symbol_obj.as_symbol();
 
   if (context.has_symbol(symbol_name, true)) {
-    throw std::runtime_error(fmt::format(
+    return context.raise_error(fmt::format(
         "Symbol '{}' is already defined in current scope", symbol_name));
   }
 
   auto value_obj = list.at(2);
   auto evaluated_value = context.eval(value_obj);
+  if (context.has_pending_error()) {
+    return evaluated_value;
+  }
 
   context.define_symbol(symbol_name, evaluated_value);
 
@@ -38,7 +42,7 @@ slp::slp_object_c interpret_fn(callable_context_if &context,
                                slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 4) {
-    throw std::runtime_error(
+    return context.raise_error(
         "fn requires exactly 3 arguments: (params) :return-type [body]");
   }
 
@@ -47,20 +51,21 @@ slp::slp_object_c interpret_fn(callable_context_if &context,
   auto body_obj = list.at(3);
 
   if (params_obj.type() != slp::slp_type_e::PAREN_LIST) {
-    throw std::runtime_error("fn: first argument must be parameter list");
+    return context.raise_error("fn: first argument must be parameter list");
   }
   if (return_type_obj.type() != slp::slp_type_e::SYMBOL) {
-    throw std::runtime_error("fn: second argument must be return type symbol");
+    return context.raise_error(
+        "fn: second argument must be return type symbol");
   }
   if (body_obj.type() != slp::slp_type_e::BRACKET_LIST) {
-    throw std::runtime_error(
+    return context.raise_error(
         "fn: third argument must be bracket list (function body)");
   }
 
   std::string return_type_sym = return_type_obj.as_symbol();
   slp::slp_type_e return_type;
   if (!context.is_symbol_enscribing_valid_type(return_type_sym, return_type)) {
-    throw std::runtime_error(
+    return context.raise_error(
         fmt::format("fn: invalid return type: {}", return_type_sym));
   }
 
@@ -69,17 +74,18 @@ slp::slp_object_c interpret_fn(callable_context_if &context,
 
   for (size_t i = 0; i < params_list.size(); i += 2) {
     if (i + 1 >= params_list.size()) {
-      throw std::runtime_error("fn: parameters must be in pairs (name :type)");
+      return context.raise_error(
+          "fn: parameters must be in pairs (name :type)");
     }
 
     auto param_name_obj = params_list.at(i);
     auto param_type_obj = params_list.at(i + 1);
 
     if (param_name_obj.type() != slp::slp_type_e::SYMBOL) {
-      throw std::runtime_error("fn: parameter name must be a symbol");
+      return context.raise_error("fn: parameter name must be a symbol");
     }
     if (param_type_obj.type() != slp::slp_type_e::SYMBOL) {
-      throw std::runtime_error("fn: parameter type must be a type symbol");
+      return context.raise_error("fn: parameter type must be a type symbol");
     }
 
     std::string param_name = param_name_obj.as_symbol();
@@ -87,7 +93,7 @@ slp::slp_object_c interpret_fn(callable_context_if &context,
     slp::slp_type_e param_type;
 
     if (!context.is_symbol_enscribing_valid_type(param_type_sym, param_type)) {
-      throw std::runtime_error(
+      return context.raise_error(
           fmt::format("fn: invalid parameter type: {}", param_type_sym));
     }
 
@@ -97,14 +103,7 @@ slp::slp_object_c interpret_fn(callable_context_if &context,
   std::uint64_t lambda_id = context.allocate_lambda_id();
   context.register_lambda(lambda_id, parameters, return_type, body_obj);
 
-  slp::slp_buffer_c buffer;
-  buffer.resize(sizeof(slp::slp_unit_of_store_t));
-  auto *unit = reinterpret_cast<slp::slp_unit_of_store_t *>(buffer.data());
-  unit->header = static_cast<std::uint32_t>(slp::slp_type_e::ABERRANT);
-  unit->flags = 0;
-  unit->data.uint64 = lambda_id;
-
-  return slp::slp_object_c::from_data(buffer, {}, 0);
+  return slp::slp_object_c::create_aberrant(lambda_id);
 }
 
 slp::slp_object_c interpret_debug(callable_context_if &context,
@@ -115,6 +114,9 @@ slp::slp_object_c interpret_debug(callable_context_if &context,
   for (size_t i = 1; i < list.size(); i++) {
     auto elem = list.at(i);
     auto evaled = context.eval(elem);
+    if (context.has_pending_error()) {
+      return evaled;
+    }
 
     fmt::print(" ");
 
@@ -147,8 +149,8 @@ slp::slp_object_c interpret_if(callable_context_if &context,
                                slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 4) {
-    throw std::runtime_error("if requires exactly 3 arguments: condition, "
-                             "true-branch, false-branch");
+    return context.raise_error("if requires exactly 3 arguments: condition, "
+                               "true-branch, false-branch");
   }
 
   auto condition_obj = list.at(1);
@@ -156,6 +158,9 @@ slp::slp_object_c interpret_if(callable_context_if &context,
   auto false_branch_obj = list.at(3);
 
   auto evaluated_condition = context.eval(condition_obj);
+  if (context.has_pending_error()) {
+    return evaluated_condition;
+  }
 
   bool execute_true_branch = true;
 
@@ -165,9 +170,9 @@ slp::slp_object_c interpret_if(callable_context_if &context,
   }
 
   if (execute_true_branch) {
-    return context.eval(true_branch_obj);
+    return context.eval_tail(true_branch_obj);
   } else {
-    return context.eval(false_branch_obj);
+    return context.eval_tail(false_branch_obj);
   }
 }
 
@@ -175,31 +180,34 @@ slp::slp_object_c interpret_reflect(callable_context_if &context,
                                     slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() < 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "reflect requires at least 2 arguments: value and one handler");
   }
 
   auto value_obj = list.at(1);
   auto evaluated_value = context.eval(value_obj);
+  if (context.has_pending_error()) {
+    return evaluated_value;
+  }
   auto actual_type = evaluated_value.type();
 
   for (size_t i = 2; i < list.size(); i++) {
     auto handler = list.at(i);
 
     if (handler.type() != slp::slp_type_e::PAREN_LIST) {
-      throw std::runtime_error(
+      return context.raise_error(
           "reflect: handlers must be paren lists like (:type body)");
     }
 
     auto handler_list = handler.as_list();
     if (handler_list.size() != 2) {
-      throw std::runtime_error(
+      return context.raise_error(
           "reflect: handler must have exactly 2 elements: (:type body)");
     }
 
     auto type_symbol_obj = handler_list.at(0);
     if (type_symbol_obj.type() != slp::slp_type_e::SYMBOL) {
-      throw std::runtime_error(
+      return context.raise_error(
           "reflect: handler type must be a symbol like :int");
     }
 
@@ -207,17 +215,12 @@ slp::slp_object_c interpret_reflect(callable_context_if &context,
 
     if (actual_type == slp::slp_type_e::ABERRANT &&
         type_symbol.find(":fn<") == 0) {
-      const std::uint8_t *base_ptr = evaluated_value.get_data().data();
-      const std::uint8_t *unit_ptr =
-          base_ptr + evaluated_value.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-      std::uint64_t lambda_id = unit->data.uint64;
+      std::uint64_t lambda_id = evaluated_value.as_handle();
 
       std::string lambda_sig = context.get_lambda_signature(lambda_id);
       if (lambda_sig == type_symbol) {
         auto body = handler_list.at(1);
-        return context.eval(body);
+        return context.eval_tail(body);
       }
       continue;
     }
@@ -225,26 +228,24 @@ slp::slp_object_c interpret_reflect(callable_context_if &context,
     slp::slp_type_e handler_type;
 
     if (!context.is_symbol_enscribing_valid_type(type_symbol, handler_type)) {
-      throw std::runtime_error(
+      return context.raise_error(
           fmt::format("reflect: invalid type symbol: {}", type_symbol));
     }
 
     if (handler_type == actual_type) {
       auto body = handler_list.at(1);
-      return context.eval(body);
+      return context.eval_tail(body);
     }
   }
 
-  std::string error_msg = "@(handler not supplied for given type)";
-  auto error_parse = slp::parse(error_msg);
-  return error_parse.take();
+  return slp::constant_error("handler not supplied for given type");
 }
 
 slp::slp_object_c interpret_try(callable_context_if &context,
                                 slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "try requires exactly 2 arguments: body and handler");
   }
 
@@ -252,16 +253,12 @@ slp::slp_object_c interpret_try(callable_context_if &context,
   auto handler_obj = list.at(2);
 
   auto result = context.eval(body_obj);
+  if (context.has_pending_error()) {
+    return result;
+  }
 
   if (result.type() == slp::slp_type_e::ERROR) {
-    const std::uint8_t *base_ptr = result.get_data().data();
-    const std::uint8_t *unit_ptr = base_ptr + result.get_root_offset();
-    const slp::slp_unit_of_store_t *unit =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-    size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-    auto inner_obj = slp::slp_object_c::from_data(
-        result.get_data(), result.get_symbols(), inner_offset);
+    auto inner_obj = result.inner();
 
     if (handler_obj.type() == slp::slp_type_e::BRACKET_LIST) {
       context.push_scope();
@@ -281,7 +278,7 @@ slp::slp_object_c interpret_assert(callable_context_if &context,
                                    slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "assert requires exactly 2 arguments: condition and message");
   }
 
@@ -290,19 +287,23 @@ slp::slp_object_c interpret_assert(callable_context_if &context,
 
   auto evaluated_condition = context.eval(condition_obj);
   auto evaluated_message = context.eval(message_obj);
+  if (context.has_pending_error()) {
+    return evaluated_message;
+  }
 
   if (evaluated_condition.type() != slp::slp_type_e::INTEGER) {
-    throw std::runtime_error("assert: condition must evaluate to an integer");
+    return context.raise_error(
+        "assert: condition must evaluate to an integer");
   }
 
   if (evaluated_message.type() != slp::slp_type_e::DQ_LIST) {
-    throw std::runtime_error("assert: message must be a string");
+    return context.raise_error("assert: message must be a string");
   }
 
   std::int64_t condition_value = evaluated_condition.as_int();
   if (condition_value == 0) {
     std::string message = evaluated_message.as_string().to_string();
-    throw std::runtime_error(message);
+    return context.raise_error(message);
   }
 
   slp::slp_object_c result;
@@ -313,7 +314,7 @@ slp::slp_object_c interpret_recover(callable_context_if &context,
                                     slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "recover requires exactly 2 arguments: body and handler");
   }
 
@@ -321,56 +322,50 @@ slp::slp_object_c interpret_recover(callable_context_if &context,
   auto handler_obj = list.at(2);
 
   if (body_obj.type() != slp::slp_type_e::BRACKET_LIST) {
-    throw std::runtime_error("recover: body must be a bracket list");
+    return context.raise_error("recover: body must be a bracket list");
   }
   if (handler_obj.type() != slp::slp_type_e::BRACKET_LIST) {
-    throw std::runtime_error("recover: handler must be a bracket list");
+    return context.raise_error("recover: handler must be a bracket list");
   }
 
-  try {
-    return context.eval(body_obj);
-  } catch (const std::exception &e) {
-    std::string exception_message = e.what();
-    std::string exception_str_literal = "\"" + exception_message + "\"";
-    auto exception_str_parse = slp::parse(exception_str_literal);
-    if (exception_str_parse.is_error()) {
-      throw std::runtime_error("recover: failed to parse exception string");
-    }
-    auto exception_str_obj = exception_str_parse.take();
-
-    context.push_scope();
-    context.define_symbol("$exception", exception_str_obj);
-    auto handler_result = context.eval(handler_obj);
-    context.pop_scope();
-    return handler_result;
+  slp::slp_object_c result;
+  std::string message;
+  if (context.eval_recovering(body_obj, result, message)) {
+    return result;
   }
+
+  auto exception_str_obj = slp::create_string_direct(message);
+  context.push_scope();
+  context.define_symbol("$exception", exception_str_obj);
+  auto handler_result = context.eval(handler_obj);
+  context.pop_scope();
+  return handler_result;
 }
 
 slp::slp_object_c interpret_eval(callable_context_if &context,
                                  slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 2) {
-    throw std::runtime_error("eval requires exactly 1 argument: code string");
+    return context.raise_error(
+        "eval requires exactly 1 argument: code string");
   }
 
   auto code_obj = list.at(1);
   auto evaluated_code = context.eval(code_obj);
+  if (context.has_pending_error()) {
+    return evaluated_code;
+  }
 
   if (evaluated_code.type() != slp::slp_type_e::DQ_LIST) {
-    throw std::runtime_error("eval: argument must be a string");
+    return context.raise_error("eval: argument must be a string");
   }
 
-  std::string code_string = evaluated_code.as_string().to_string();
-
-  auto parse_result = slp::parse(code_string);
-  if (parse_result.is_error()) {
-    const auto &error = parse_result.error();
-    throw std::runtime_error(
-        fmt::format("eval: parse error: {}", error.message));
+  slp::slp_object_c parsed_obj;
+  std::string error;
+  if (!context.parse_eval_code(evaluated_code, parsed_obj, error)) {
+    return context.raise_error(fmt::format("eval: parse error: {}", error));
   }
 
-  auto parsed_obj = parse_result.take();
-
   context.push_scope();
   auto result = context.eval(parsed_obj);
   context.pop_scope();
@@ -382,7 +377,7 @@ slp::slp_object_c interpret_apply(callable_context_if &context,
                                   slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "apply requires exactly 2 arguments: lambda and args-list");
   }
 
@@ -390,137 +385,92 @@ slp::slp_object_c interpret_apply(callable_context_if &context,
   auto args_obj = list.at(2);
 
   auto evaluated_lambda = context.eval(lambda_obj);
+  if (context.has_pending_error()) {
+    return evaluated_lambda;
+  }
   if (evaluated_lambda.type() != slp::slp_type_e::ABERRANT) {
-    throw std::runtime_error(
+    return context.raise_error(
         "apply: first argument must be a lambda (aberrant type)");
   }
 
   auto evaluated_args = context.eval(args_obj);
+  if (context.has_pending_error()) {
+    return evaluated_args;
+  }
   if (evaluated_args.type() != slp::slp_type_e::BRACE_LIST) {
-    throw std::runtime_error(
+    return context.raise_error(
         "apply: second argument must be a brace list of arguments");
   }
 
   auto args_to_apply = evaluated_args.as_list();
-
-  context.push_scope();
-  context.define_symbol("apply-temp-lambda", evaluated_lambda);
-
-  std::string call_str = "(apply-temp-lambda";
+  std::vector<slp::slp_object_c> args;
+  args.reserve(args_to_apply.size());
   for (size_t i = 0; i < args_to_apply.size(); i++) {
-    call_str += " ";
-    auto arg = args_to_apply.at(i);
-    std::string arg_sym = "apply-temp-arg-" + std::to_string(i);
-    context.define_symbol(arg_sym, arg);
-    call_str += arg_sym;
-  }
-  call_str += ")";
-
-  auto parse_result = slp::parse(call_str);
-  if (parse_result.is_error()) {
-    context.pop_scope();
-    throw std::runtime_error("apply: failed to construct call");
+    args.push_back(args_to_apply.at(i));
   }
 
-  auto call_obj = parse_result.take();
-  auto result = context.eval(call_obj);
-  context.pop_scope();
-
-  return result;
+  return context.call_lambda(evaluated_lambda.as_handle(), args);
 }
 
 slp::slp_object_c interpret_match(callable_context_if &context,
                                   slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() < 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "match requires at least 2 arguments: value and one handler");
   }
 
   auto value_obj = list.at(1);
   auto evaluated_value = context.eval(value_obj);
+  if (context.has_pending_error()) {
+    return evaluated_value;
+  }
   auto actual_type = evaluated_value.type();
+  auto value_hash = evaluated_value.hash();
 
   for (size_t i = 2; i < list.size(); i++) {
     auto handler = list.at(i);
 
     if (handler.type() != slp::slp_type_e::PAREN_LIST) {
-      throw std::runtime_error(
+      return context.raise_error(
           "match: handlers must be paren lists like (pattern result)");
     }
 
     auto handler_list = handler.as_list();
     if (handler_list.size() != 2) {
-      throw std::runtime_error(
+      return context.raise_error(
           "match: handler must have exactly 2 elements: (pattern result)");
     }
 
     auto pattern_obj = handler_list.at(0);
     auto evaluated_pattern = context.eval(pattern_obj);
+    if (context.has_pending_error()) {
+      return evaluated_pattern;
+    }
 
     if (evaluated_pattern.type() != actual_type) {
       continue;
     }
 
-    bool values_match = false;
-    switch (actual_type) {
-    case slp::slp_type_e::INTEGER:
-      values_match = evaluated_value.as_int() == evaluated_pattern.as_int();
-      break;
-    case slp::slp_type_e::REAL:
-      values_match = evaluated_value.as_real() == evaluated_pattern.as_real();
-      break;
-    case slp::slp_type_e::SYMBOL: {
-      std::string val_sym = evaluated_value.as_symbol();
-      std::string pat_sym = evaluated_pattern.as_symbol();
-      values_match = (val_sym == pat_sym);
-      break;
-    }
-    case slp::slp_type_e::DQ_LIST: {
-      std::string val_str = evaluated_value.as_string().to_string();
-      std::string pat_str = evaluated_pattern.as_string().to_string();
-      values_match = (val_str == pat_str);
-      break;
-    }
-    case slp::slp_type_e::ABERRANT: {
-      const std::uint8_t *val_base = evaluated_value.get_data().data();
-      const std::uint8_t *val_unit =
-          val_base + evaluated_value.get_root_offset();
-      const slp::slp_unit_of_store_t *val_u =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(val_unit);
-      std::uint64_t val_id = val_u->data.uint64;
-
-      const std::uint8_t *pat_base = evaluated_pattern.get_data().data();
-      const std::uint8_t *pat_unit =
-          pat_base + evaluated_pattern.get_root_offset();
-      const slp::slp_unit_of_store_t *pat_u =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(pat_unit);
-      std::uint64_t pat_id = pat_u->data.uint64;
-
-      values_match = (val_id == pat_id);
-      break;
-    }
-    default:
-      values_match = false;
-      break;
-    }
+    // Most handlers differ from the value, and a hash tells them apart
+    // without walking either; only a hash hit is compared in full
+    bool values_match = evaluated_pattern.hash() == value_hash &&
+                        evaluated_value.equals(evaluated_pattern);
 
     if (values_match) {
       auto result_obj = handler_list.at(1);
-      return context.eval(result_obj);
+      return context.eval_tail(result_obj);
     }
   }
 
-  std::string error_msg = "@(no matching handler found)";
-  auto error_parse = slp::parse(error_msg);
-  return error_parse.take();
+  return slp::constant_error("no matching handler found");
 }
 
 slp::slp_object_c interpret_cast(callable_context_if &context,
                                  slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "cast requires exactly 2 arguments: type and value");
   }
 
@@ -528,18 +478,21 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
   auto value_obj = list.at(2);
 
   if (type_obj.type() != slp::slp_type_e::SYMBOL) {
-    throw std::runtime_error("cast: first argument must be a type symbol");
+    return context.raise_error("cast: first argument must be a type symbol");
   }
 
   std::string type_symbol = type_obj.as_symbol();
   slp::slp_type_e expected_type;
 
   if (!context.is_symbol_enscribing_valid_type(type_symbol, expected_type)) {
-    throw std::runtime_error(
+    return context.raise_error(
         fmt::format("cast: invalid type symbol: {}", type_symbol));
   }
 
   auto evaluated_value = context.eval(value_obj);
+  if (context.has_pending_error()) {
+    return evaluated_value;
+  }
   auto actual_type = evaluated_value.type();
 
   if (expected_type == actual_type) {
@@ -561,7 +514,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
         auto list_items = evaluated_value.as_list();
 
         if (list_items.size() != form_def.size()) {
-          throw std::runtime_error(
+          return context.raise_error(
               fmt::format("cast: form {} requires {} elements, got {}",
                           form_name, form_def.size(), list_items.size()));
         }
@@ -570,7 +523,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
           auto item = list_items.at(i);
 
           if (item.type() != form_def[i]) {
-            throw std::runtime_error(
+            return context.raise_error(
                 fmt::format("cast: form {} element {} expects type {}, got {}",
                             form_name, i, static_cast<int>(form_def[i]),
                             static_cast<int>(item.type())));
@@ -617,16 +570,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
 
   if (is_actual_list_type && is_expected_list_type) {
     if (actual_type == slp::slp_type_e::SOME) {
-      const std::uint8_t *base_ptr = evaluated_value.get_data().data();
-      const std::uint8_t *unit_ptr =
-          base_ptr + evaluated_value.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-      size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-      evaluated_value = slp::slp_object_c::from_data(
-          evaluated_value.get_data(), evaluated_value.get_symbols(),
-          inner_offset);
+      evaluated_value = evaluated_value.inner();
       actual_type = evaluated_value.type();
     }
     if (expected_type == slp::slp_type_e::DQ_LIST) {
@@ -688,7 +632,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
       } else if (item.type() == slp::slp_type_e::DQ_LIST) {
         list_str += "\"" + item.as_string().to_string() + "\"";
       } else {
-        throw std::runtime_error(
+        return context.raise_error(
             "cast: cannot convert complex list structures");
       }
     }
@@ -705,7 +649,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
 
     auto parse_result = slp::parse(cast_str);
     if (parse_result.is_error()) {
-      throw std::runtime_error("cast: failed to parse converted value");
+      return context.raise_error("cast: failed to parse converted value");
     }
     return parse_result.take();
   }
@@ -729,15 +673,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
       result_str = "?lambda";
       break;
     case slp::slp_type_e::ERROR: {
-      const std::uint8_t *base_ptr = evaluated_value.get_data().data();
-      const std::uint8_t *unit_ptr =
-          base_ptr + evaluated_value.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-      size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-      auto inner_obj = slp::slp_object_c::from_data(
-          evaluated_value.get_data(), evaluated_value.get_symbols(),
-          inner_offset);
+      auto inner_obj = evaluated_value.inner();
       context.push_scope();
       context.define_symbol("cast_temp_inner", inner_obj);
       auto inner_cast = slp::parse("(cast :str cast_temp_inner)");
@@ -745,6 +681,9 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
         auto inner_cast_obj = inner_cast.take();
         auto inner_result = context.eval(inner_cast_obj);
         context.pop_scope();
+        if (context.has_pending_error()) {
+          return inner_result;
+        }
         if (inner_result.type() == slp::slp_type_e::DQ_LIST) {
           result_str = "@(" + inner_result.as_string().to_string() + ")";
           return slp::create_string_direct(result_str);
@@ -755,15 +694,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
       break;
     }
     case slp::slp_type_e::SOME: {
-      const std::uint8_t *base_ptr = evaluated_value.get_data().data();
-      const std::uint8_t *unit_ptr =
-          base_ptr + evaluated_value.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-      size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-      auto inner_obj = slp::slp_object_c::from_data(
-          evaluated_value.get_data(), evaluated_value.get_symbols(),
-          inner_offset);
+      auto inner_obj = evaluated_value.inner();
       context.push_scope();
       context.define_symbol("cast_temp_inner", inner_obj);
       auto inner_cast = slp::parse("(cast :str cast_temp_inner)");
@@ -771,6 +702,9 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
         auto inner_cast_obj = inner_cast.take();
         auto inner_result = context.eval(inner_cast_obj);
         context.pop_scope();
+        if (context.has_pending_error()) {
+          return inner_result;
+        }
         if (inner_result.type() == slp::slp_type_e::DQ_LIST) {
           result_str = "'" + inner_result.as_string().to_string();
           return slp::create_string_direct(result_str);
@@ -781,15 +715,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
       break;
     }
     case slp::slp_type_e::DATUM: {
-      const std::uint8_t *base_ptr = evaluated_value.get_data().data();
-      const std::uint8_t *unit_ptr =
-          base_ptr + evaluated_value.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-      size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-      auto inner_obj = slp::slp_object_c::from_data(
-          evaluated_value.get_data(), evaluated_value.get_symbols(),
-          inner_offset);
+      auto inner_obj = evaluated_value.inner();
       context.push_scope();
       context.define_symbol("cast_temp_inner", inner_obj);
       auto inner_cast = slp::parse("(cast :str cast_temp_inner)");
@@ -797,6 +723,9 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
         auto inner_cast_obj = inner_cast.take();
         auto inner_result = context.eval(inner_cast_obj);
         context.pop_scope();
+        if (context.has_pending_error()) {
+          return inner_result;
+        }
         if (inner_result.type() == slp::slp_type_e::DQ_LIST) {
           result_str = "#" + inner_result.as_string().to_string();
           return slp::create_string_direct(result_str);
@@ -813,7 +742,7 @@ slp::slp_object_c interpret_cast(callable_context_if &context,
     return slp::create_string_direct(result_str);
   }
 
-  throw std::runtime_error(fmt::format(
+  return context.raise_error(fmt::format(
       "cast: type mismatch: expected {}, got {}",
       static_cast<int>(expected_type), static_cast<int>(actual_type)));
 }
@@ -822,29 +751,24 @@ slp::slp_object_c interpret_do(callable_context_if &context,
                                slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 2) {
-    throw std::runtime_error("do requires exactly 1 argument: body");
+    return context.raise_error("do requires exactly 1 argument: body");
   }
 
   auto body_obj = list.at(1);
   if (body_obj.type() != slp::slp_type_e::BRACKET_LIST) {
-    throw std::runtime_error("do: argument must be a bracket list");
+    return context.raise_error("do: argument must be a bracket list");
   }
 
+  // The loop context is the body's frame and keeps $iterations bound
   context.push_loop_context();
 
   while (true) {
-    context.push_scope();
-
-    std::int64_t current_iteration = context.get_current_iteration();
-    auto iteration_obj = slp::slp_object_c::create_int(current_iteration);
-    context.define_symbol("$iterations", iteration_obj);
-
-    auto body_copy = slp::slp_object_c::from_data(body_obj.get_data(),
-                                                  body_obj.get_symbols(),
-                                                  body_obj.get_root_offset());
-    context.eval(body_copy);
-
-    context.pop_scope();
+    auto body = body_obj.share();
+    context.eval(body);
+    if (context.has_pending_error()) {
+      context.pop_loop_context();
+      return body;
+    }
 
     if (context.should_exit_loop()) {
       break;
@@ -863,15 +787,19 @@ slp::slp_object_c interpret_done(callable_context_if &context,
                                  slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 2) {
-    throw std::runtime_error("done requires exactly 1 argument: return value");
+    return context.raise_error(
+        "done requires exactly 1 argument: return value");
   }
 
   if (!context.is_in_loop()) {
-    throw std::runtime_error("done called outside of do loop");
+    return context.raise_error("done called outside of do loop");
   }
 
   auto value_obj = list.at(1);
   auto evaluated_value = context.eval(value_obj);
+  if (context.has_pending_error()) {
+    return evaluated_value;
+  }
 
   context.signal_loop_done(evaluated_value);
 
@@ -883,7 +811,7 @@ slp::slp_object_c interpret_at(callable_context_if &context,
                                slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error(
+    return context.raise_error(
         "at requires exactly 2 arguments: index and collection");
   }
 
@@ -891,26 +819,28 @@ slp::slp_object_c interpret_at(callable_context_if &context,
   auto collection_obj = list.at(2);
 
   auto evaluated_index = context.eval(index_obj);
+  if (context.has_pending_error()) {
+    return evaluated_index;
+  }
   if (evaluated_index.type() != slp::slp_type_e::INTEGER) {
-    throw std::runtime_error("at: index must be an integer");
+    return context.raise_error("at: index must be an integer");
   }
 
   std::int64_t index = evaluated_index.as_int();
   if (index < 0) {
-    std::string error_msg = "@(index out of bounds)";
-    auto error_parse = slp::parse(error_msg);
-    return error_parse.take();
+    return slp::constant_error("index out of bounds");
   }
 
   auto evaluated_collection = context.eval(collection_obj);
+  if (context.has_pending_error()) {
+    return evaluated_collection;
+  }
   auto collection_type = evaluated_collection.type();
 
   if (collection_type == slp::slp_type_e::DQ_LIST) {
     auto str_data = evaluated_collection.as_string();
     if (static_cast<size_t>(index) >= str_data.size()) {
-      std::string error_msg = "@(index out of bounds)";
-      auto error_parse = slp::parse(error_msg);
-      return error_parse.take();
+      return slp::constant_error("index out of bounds");
     }
     unsigned char byte = static_cast<unsigned char>(str_data.at(index));
     return slp::slp_object_c::create_int(static_cast<std::int64_t>(byte));
@@ -921,21 +851,20 @@ slp::slp_object_c interpret_at(callable_context_if &context,
       collection_type == slp::slp_type_e::BRACE_LIST) {
     auto collection_list = evaluated_collection.as_list();
     if (static_cast<size_t>(index) >= collection_list.size()) {
-      std::string error_msg = "@(index out of bounds)";
-      auto error_parse = slp::parse(error_msg);
-      return error_parse.take();
+      return slp::constant_error("index out of bounds");
     }
     return collection_list.at(static_cast<size_t>(index));
   }
 
-  throw std::runtime_error("at: collection must be a list or string type");
+  return context.raise_error("at: collection must be a list or string type");
 }
 
 slp::slp_object_c interpret_eq(callable_context_if &context,
                                slp::slp_object_c &args_list) {
   auto list = args_list.as_list();
   if (list.size() != 3) {
-    throw std::runtime_error("eq requires exactly 2 arguments: lhs and rhs");
+    return context.raise_error(
+        "eq requires exactly 2 arguments: lhs and rhs");
   }
 
   auto lhs_obj = list.at(1);
@@ -943,127 +872,12 @@ slp::slp_object_c interpret_eq(callable_context_if &context,
 
   auto evaluated_lhs = context.eval(lhs_obj);
   auto evaluated_rhs = context.eval(rhs_obj);
-
-  auto lhs_type = evaluated_lhs.type();
-  auto rhs_type = evaluated_rhs.type();
-
-  if (lhs_type != rhs_type) {
-    return slp::slp_object_c::create_int(0);
-  }
-
-  if (lhs_type == slp::slp_type_e::ABERRANT) {
-    const std::uint8_t *lhs_base = evaluated_lhs.get_data().data();
-    const std::uint8_t *lhs_unit = lhs_base + evaluated_lhs.get_root_offset();
-    const slp::slp_unit_of_store_t *lhs_u =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(lhs_unit);
-    std::uint64_t lhs_id = lhs_u->data.uint64;
-
-    const std::uint8_t *rhs_base = evaluated_rhs.get_data().data();
-    const std::uint8_t *rhs_unit = rhs_base + evaluated_rhs.get_root_offset();
-    const slp::slp_unit_of_store_t *rhs_u =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(rhs_unit);
-    std::uint64_t rhs_id = rhs_u->data.uint64;
-
-    return slp::slp_object_c::create_int(lhs_id == rhs_id ? 1 : 0);
-  }
-
-  if (lhs_type == slp::slp_type_e::ERROR || lhs_type == slp::slp_type_e::SOME ||
-      lhs_type == slp::slp_type_e::DATUM) {
-    const std::uint8_t *lhs_base = evaluated_lhs.get_data().data();
-    const std::uint8_t *lhs_unit = lhs_base + evaluated_lhs.get_root_offset();
-    const slp::slp_unit_of_store_t *lhs_u =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(lhs_unit);
-    size_t lhs_inner_offset = static_cast<size_t>(lhs_u->data.uint64);
-    auto lhs_inner = slp::slp_object_c::from_data(evaluated_lhs.get_data(),
-                                                  evaluated_lhs.get_symbols(),
-                                                  lhs_inner_offset);
-
-    const std::uint8_t *rhs_base = evaluated_rhs.get_data().data();
-    const std::uint8_t *rhs_unit = rhs_base + evaluated_rhs.get_root_offset();
-    const slp::slp_unit_of_store_t *rhs_u =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(rhs_unit);
-    size_t rhs_inner_offset = static_cast<size_t>(rhs_u->data.uint64);
-    auto rhs_inner = slp::slp_object_c::from_data(evaluated_rhs.get_data(),
-                                                  evaluated_rhs.get_symbols(),
-                                                  rhs_inner_offset);
-
-    context.push_scope();
-    context.define_symbol("eq_lhs_inner", lhs_inner);
-    context.define_symbol("eq_rhs_inner", rhs_inner);
-    auto parse_result = slp::parse("(eq eq_lhs_inner eq_rhs_inner)");
-    if (!parse_result.is_error()) {
-      auto call_obj = parse_result.take();
-      auto result = context.eval(call_obj);
-      context.pop_scope();
-      return result;
-    }
-    context.pop_scope();
-    return slp::slp_object_c::create_int(0);
+  if (context.has_pending_error()) {
+    return evaluated_rhs;
   }
 
-  if (lhs_type == slp::slp_type_e::PAREN_LIST ||
-      lhs_type == slp::slp_type_e::BRACKET_LIST ||
-      lhs_type == slp::slp_type_e::BRACE_LIST) {
-    auto lhs_list = evaluated_lhs.as_list();
-    auto rhs_list = evaluated_rhs.as_list();
-
-    if (lhs_list.size() != rhs_list.size()) {
-      return slp::slp_object_c::create_int(0);
-    }
-
-    for (size_t i = 0; i < lhs_list.size(); i++) {
-      auto lhs_elem = lhs_list.at(i);
-      auto rhs_elem = rhs_list.at(i);
-
-      context.push_scope();
-      context.define_symbol("eq_lhs_elem", lhs_elem);
-      context.define_symbol("eq_rhs_elem", rhs_elem);
-      auto parse_result = slp::parse("(eq eq_lhs_elem eq_rhs_elem)");
-      if (parse_result.is_error()) {
-        context.pop_scope();
-        return slp::slp_object_c::create_int(0);
-      }
-      auto call_obj = parse_result.take();
-      auto result = context.eval(call_obj);
-      context.pop_scope();
-
-      if (result.type() != slp::slp_type_e::INTEGER || result.as_int() == 0) {
-        return slp::slp_object_c::create_int(0);
-      }
-    }
-    return slp::slp_object_c::create_int(1);
-  }
-
-  context.push_scope();
-  context.define_symbol("eq_temp_lhs", evaluated_lhs);
-  context.define_symbol("eq_temp_rhs", evaluated_rhs);
-
-  auto lhs_cast_parse = slp::parse("(cast :str eq_temp_lhs)");
-  auto rhs_cast_parse = slp::parse("(cast :str eq_temp_rhs)");
-
-  if (lhs_cast_parse.is_error() || rhs_cast_parse.is_error()) {
-    context.pop_scope();
-    return slp::slp_object_c::create_int(0);
-  }
-
-  auto lhs_cast_obj = lhs_cast_parse.take();
-  auto rhs_cast_obj = rhs_cast_parse.take();
-
-  auto lhs_cast_result = context.eval(lhs_cast_obj);
-  auto rhs_cast_result = context.eval(rhs_cast_obj);
-
-  context.pop_scope();
-
-  if (lhs_cast_result.type() != slp::slp_type_e::DQ_LIST ||
-      rhs_cast_result.type() != slp::slp_type_e::DQ_LIST) {
-    return slp::slp_object_c::create_int(0);
-  }
-
-  std::string lhs_string = lhs_cast_result.as_string().to_string();
-  std::string rhs_string = rhs_cast_result.as_string().to_string();
-
-  bool equal = (lhs_string == rhs_string);
-  return slp::slp_object_c::create_int(equal ? 1 : 0);
+  return slp::slp_object_c::create_int(
+      evaluated_lhs.equals(evaluated_rhs) ? 1 : 0);
 }
 
 slp::slp_object_c interpret_datum_load(callable_context_if &context,
@@ -1,36 +1,87 @@
 #include "interpreter.hpp"
 #include "core/instructions/datum.hpp"
 #include "core/kernels/kernels.hpp"
+#include <algorithm>
 #include <atomic>
 #include <fmt/core.h>
+#include <list>
+#include <slp/constants.hpp>
+#include <slp/symbols.hpp>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace pkg::core {
 
 struct function_definition_s {
   std::vector<callable_parameter_s> parameters;
+  std::vector<std::uint64_t> parameter_ids;
   slp::slp_type_e return_type;
   slp::slp_object_c body;
-  size_t scope_level;
 };
 
+enum class dispatch_kind_e { BUILTIN, KERNEL, LAMBDA };
+
+// A code string eval has parsed, keyed by its hash
+struct eval_cache_entry_s {
+  std::uint64_t key{0};
+  std::string code;
+  slp::slp_object_c tree;
+};
+
+// What a PAREN_LIST call site resolved to the last time it was evaluated
+struct dispatch_entry_s {
+  std::uint64_t symbol{0};
+  dispatch_kind_e kind{dispatch_kind_e::BUILTIN};
+  callable_symbol_s *callable{nullptr};
+  std::uint64_t lambda_id{0};
+  std::uint64_t binding_epoch{0};
+};
+
+/*
+    One binding in the flat environment. `shadowed` is the slot the symbol
+    resolved to before this binding was made (no_slot if it was unbound), so
+    popping a frame restores outer bindings without searching for them.
+*/
+struct binding_slot_s {
+  std::uint64_t symbol{0};
+  slp::slp_object_c value;
+  size_t shadowed{0};
+};
+
+/*
+    A scope is a range of the binding slots and a range of the lambdas
+    registered while it was innermost; popping it releases exactly those.
+*/
+struct frame_s {
+  size_t first_slot{0};
+  size_t first_lambda{0};
+};
+
+/*
+    A loop context is also the frame its body runs in, opened once per loop:
+    a scope whose first binding is $iterations. Advancing drops whatever the
+    last iteration bound or registered in it and rewrites $iterations in
+    place, so an iteration pushes no scope and makes no binding of its own.
+*/
 struct loop_context_s {
   std::atomic<bool> done_flag{false};
   slp::slp_object_c return_value;
   std::int64_t iteration{1};
+  size_t frame{0};
 
   loop_context_s() = default;
 
   loop_context_s(loop_context_s &&other) noexcept
       : done_flag(other.done_flag.load()),
         return_value(std::move(other.return_value)),
-        iteration(other.iteration) {}
+        iteration(other.iteration), frame(other.frame) {}
 
   loop_context_s &operator=(loop_context_s &&other) noexcept {
     if (this != &other) {
       done_flag.store(other.done_flag.load());
       return_value = std::move(other.return_value);
       iteration = other.iteration;
+      frame = other.frame;
     }
     return *this;
   }
@@ -44,9 +95,12 @@ public:
   interpreter_c(
       const std::map<std::string, callable_symbol_s> &callable_symbols,
       kernels::kernel_context_if *kernel_context)
-      : callable_symbols_(callable_symbols), kernel_context_(kernel_context),
-        next_lambda_id_(1), current_scope_level_(0),
-        kernels_locked_triggered_(false) {
+      : kernel_context_(kernel_context), next_lambda_id_(1),
+        kernels_locked_triggered_(false),
+        iterations_symbol_(slp::symbol_table().intern("$iterations")) {
+    for (const auto &[name, symbol] : callable_symbols) {
+      callable_symbols_[slp::symbol_table().intern(name)] = symbol;
+    }
     initialize_type_map();
     push_scope();
   }
@@ -54,6 +108,21 @@ public:
   ~interpreter_c() override = default;
 
   slp::slp_object_c eval(slp::slp_object_c &object) override {
+    auto result = evaluate(object);
+    if (pending_error_ && !builtin_.handles_pending_errors) {
+      throw_pending_error();
+    }
+    return result;
+  }
+
+  slp::slp_object_c evaluate(slp::slp_object_c &object) {
+    // Only the object a tail position was handed to is in it; whatever it
+    // evaluates on the way is not
+    bool tail = tail_position_;
+    tail_position_ = false;
+    if (pending_error_) {
+      return slp::slp_object_c();
+    }
     auto type = object.type();
 
     switch (type) {
@@ -64,14 +133,9 @@ public:
       return std::move(object);
 
     case slp::slp_type_e::SYMBOL: {
-      std::string sym = object.as_symbol();
-      for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
-        auto found = it->find(sym);
-        if (found != it->end()) {
-          return slp::slp_object_c::from_data(found->second.get_data(),
-                                              found->second.get_symbols(),
-                                              found->second.get_root_offset());
-        }
+      size_t slot = resolve_slot(object.as_symbol_id());
+      if (slot != no_slot) {
+        return slots_[slot].value.share();
       }
 
       return std::move(object);
@@ -81,14 +145,7 @@ public:
       return std::move(object);
 
     case slp::slp_type_e::SOME: {
-      const std::uint8_t *base_ptr = object.get_data().data();
-      const std::uint8_t *unit_ptr = base_ptr + object.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-      size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-      auto inner_obj = slp::slp_object_c::from_data(
-          object.get_data(), object.get_symbols(), inner_offset);
+      auto inner_obj = object.inner();
       return std::move(inner_obj);
     }
 
@@ -100,41 +157,62 @@ public:
 
       auto first = list.at(0);
       if (first.type() != slp::slp_type_e::SYMBOL) {
-        throw std::runtime_error(fmt::format("Cannot call non-symbol type: {}",
-                                             static_cast<int>(first.type())));
+        return raise_error(fmt::format("Cannot call non-symbol type: {}",
+                                       static_cast<int>(first.type())));
       }
 
-      std::string cmd = first.as_symbol();
-      auto it = callable_symbols_.find(cmd);
+      std::uint64_t symbol = first.as_symbol_id();
+      const void *site = object.get_data().data() + object.get_root_offset();
+
+      auto cached = dispatch_cache_.find(site);
+      if (cached != dispatch_cache_.end() &&
+          cached->second.symbol == symbol) {
+        dispatch_entry_s entry = cached->second;
+        switch (entry.kind) {
+        case dispatch_kind_e::BUILTIN:
+        case dispatch_kind_e::KERNEL:
+          return call_builtin(*entry.callable, object, tail);
+        case dispatch_kind_e::LAMBDA:
+          if (entry.binding_epoch == binding_epoch(symbol) &&
+              lambda_definitions_.count(entry.lambda_id)) {
+            return handle_lambda_call(entry.lambda_id, list, tail);
+          }
+          break;
+        }
+      }
+
+      auto it = callable_symbols_.find(symbol);
       if (it != callable_symbols_.end()) {
-        return it->second.function(*this, object);
+        remember_dispatch(site, {symbol, dispatch_kind_e::BUILTIN, &it->second});
+        return call_builtin(it->second, object, tail);
       }
 
-      if (kernel_context_ && kernel_context_->has_function(cmd)) {
+      std::string cmd = first.as_symbol();
+      if (kernel_context_) {
         auto *kernel_func = kernel_context_->get_function(cmd);
         if (kernel_func) {
-          return kernel_func->function(*this, object);
+          remember_dispatch(site, {symbol, dispatch_kind_e::KERNEL, kernel_func});
+          return call_builtin(*kernel_func, object, tail);
         }
       }
 
-      auto evaled_first = eval(first);
+      auto evaled_first = evaluate(first);
       if (evaled_first.type() == slp::slp_type_e::ABERRANT) {
-        return handle_aberrant_call(evaled_first, list);
+        // Kernels can still be loaded until the lock; one loaded later would
+        // take precedence over the lambda, so only cache once locked
+        if (!kernel_context_ || kernels_locked_triggered_) {
+          remember_dispatch(
+              site, {symbol, dispatch_kind_e::LAMBDA, nullptr,
+                     evaled_first.as_handle(), binding_epoch(symbol)});
+        }
+        return handle_aberrant_call(evaled_first, list, tail);
       }
 
-      throw std::runtime_error(fmt::format("Unknown callable symbol: {}", cmd));
+      return raise_error(fmt::format("Unknown callable symbol: {}", cmd));
     }
 
     case slp::slp_type_e::DATUM: {
-      const std::uint8_t *base_ptr = object.get_data().data();
-      const std::uint8_t *unit_ptr = base_ptr + object.get_root_offset();
-      const slp::slp_unit_of_store_t *unit =
-          reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-
-      size_t inner_offset = static_cast<size_t>(unit->data.uint64);
-
-      auto inner_obj = slp::slp_object_c::from_data(
-          object.get_data(), object.get_symbols(), inner_offset);
+      auto inner_obj = object.inner();
 
       if (inner_obj.type() != slp::slp_type_e::PAREN_LIST) {
         return std::move(object);
@@ -150,21 +228,18 @@ public:
         return std::move(object);
       }
 
-      std::string cmd = first.as_symbol();
-
-      auto local_it = callable_symbols_.find(cmd);
+      auto local_it = callable_symbols_.find(first.as_symbol_id());
       if (local_it != callable_symbols_.end()) {
-        return local_it->second.function(*this, inner_obj);
+        return call_builtin(local_it->second, inner_obj, false);
       }
 
-      auto datum_symbols = datum::get_standard_callable_symbols();
-      auto it = datum_symbols.find(cmd);
-      if (it == datum_symbols.end()) {
-        throw std::runtime_error(
-            fmt::format("Unknown datum callable symbol: {}", cmd));
+      auto datum_callable = datum::find_datum_callable(first.as_symbol_id());
+      if (!datum_callable) {
+        return raise_error(fmt::format("Unknown datum callable symbol: {}",
+                                       first.as_symbol()));
       }
 
-      return it->second.function(*this, inner_obj);
+      return call_builtin(*datum_callable, inner_obj, false);
     }
 
     case slp::slp_type_e::BRACKET_LIST: {
@@ -179,7 +254,11 @@ public:
           kernels_locked_triggered_ = true;
         }
 
-        result = eval(elem);
+        tail_position_ = tail && i + 1 == list.size();
+        result = evaluate(elem);
+        if (pending_error_) {
+          break;
+        }
       }
       return result;
     }
@@ -189,27 +268,153 @@ public:
     }
   }
 
-  bool has_symbol(const std::string &symbol, bool local_scope_only) override {
-    if (local_scope_only) {
-      return !scopes_.empty() &&
-             scopes_.back().find(symbol) != scopes_.back().end();
+  slp::slp_object_c eval_tail(slp::slp_object_c &object) override {
+    tail_position_ = builtin_.in_tail;
+    return eval(object);
+  }
+
+  slp::slp_object_c raise_error(const std::string &message) override {
+    if (recover_depth_ == 0) {
+      throw std::runtime_error(message);
     }
+    pending_error_ = true;
+    pending_message_ = message;
+    return slp::slp_object_c();
+  }
 
-    for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
-      if (it->find(symbol) != it->end()) {
-        return true;
-      }
+  bool has_pending_error() override { return pending_error_; }
+
+  slp::slp_object_c
+  call_lambda(std::uint64_t lambda_id,
+              std::span<const slp::slp_object_c> args) override {
+    if (pending_error_) {
+      return slp::slp_object_c();
+    }
+    auto result = call_lambda_with(lambda_id, args);
+    if (pending_error_ && !builtin_.handles_pending_errors) {
+      throw_pending_error();
+    }
+    return result;
+  }
+
+  /*
+      Evaluation under a recover. Errors raised inside are left pending and
+      come back here by ordinary returns; a throw (a fatal fault, or a
+      pending error that reached a function not handling them) is caught
+      instead. Either way the scopes and loops the abandoned evaluation had
+      open are closed before the message is handed back.
+  */
+  bool eval_recovering(slp::slp_object_c &object, slp::slp_object_c &result,
+                       std::string &message) override {
+    size_t frames = frames_.size();
+    size_t loops = loop_contexts_.size();
+    bool failed = false;
+    recover_depth_++;
+    try {
+      result = evaluate(object);
+    } catch (const std::exception &e) {
+      failed = true;
+      message = e.what();
+    }
+    recover_depth_--;
+    if (pending_error_) {
+      failed = true;
+      pending_error_ = false;
+      message = std::move(pending_message_);
+    }
+    if (!failed) {
+      return true;
+    }
+
+    while (loop_contexts_.size() > loops) {
+      pop_loop_context();
+    }
+    while (frames_.size() > frames) {
+      pop_scope();
     }
     return false;
   }
 
+  /*
+      Least recently used first out. The key is the string's structural
+      hash, which covers its bytes; the text is kept to rule out a
+      collision. A string that fails to parse is not cached.
+  */
+  bool parse_eval_code(const slp::slp_object_c &code, slp::slp_object_c &out,
+                       std::string &error) override {
+    std::uint64_t key = code.hash();
+    std::string_view text = code.as_string().view();
+
+    auto found = eval_cache_index_.find(key);
+    if (found != eval_cache_index_.end() && found->second->code == text) {
+      eval_cache_.splice(eval_cache_.begin(), eval_cache_, found->second);
+      eval_cache_stats_.hits++;
+      out = found->second->tree.share();
+      return true;
+    }
+    eval_cache_stats_.misses++;
+
+    auto parse_result = slp::parse(text);
+    if (parse_result.is_error()) {
+      error = parse_result.error().message;
+      return false;
+    }
+
+    if (found != eval_cache_index_.end()) {
+      eval_cache_.erase(found->second);
+      eval_cache_index_.erase(found);
+    } else if (eval_cache_.size() >= max_eval_cache_entries) {
+      eval_cache_index_.erase(eval_cache_.back().key);
+      eval_cache_.pop_back();
+    }
+    eval_cache_.push_front({key, std::string(text), parse_result.take()});
+    eval_cache_index_[key] = eval_cache_.begin();
+    out = eval_cache_.front().tree.share();
+    return true;
+  }
+
+  eval_cache_stats_s get_eval_cache_stats() override {
+    eval_cache_stats_s stats = eval_cache_stats_;
+    stats.entries = eval_cache_.size();
+    return stats;
+  }
+
+  bool has_symbol(const std::string &name, bool local_scope_only) override {
+    std::uint64_t symbol = slp::symbol_table().find(name);
+    if (symbol == 0) {
+      return false;
+    }
+
+    size_t slot = resolve_slot(symbol);
+    if (slot == no_slot) {
+      return false;
+    }
+    return !local_scope_only ||
+           (!frames_.empty() && slot >= frames_.back().first_slot);
+  }
+
   bool define_symbol(const std::string &symbol,
                      slp::slp_object_c &object) override {
-    if (scopes_.empty()) {
+    return define_symbol_id(slp::symbol_table().intern(symbol), object);
+  }
+
+  bool define_symbol_id(std::uint64_t symbol,
+                        slp::slp_object_c &object) override {
+    if (frames_.empty()) {
       return false;
     }
-    scopes_.back()[symbol] = slp::slp_object_c::from_data(
-        object.get_data(), object.get_symbols(), object.get_root_offset());
+    if (symbol >= symbol_slots_.size()) {
+      symbol_slots_.resize(symbol + 1, no_slot);
+    }
+
+    size_t slot = symbol_slots_[symbol];
+    if (slot != no_slot && slot >= frames_.back().first_slot) {
+      slots_[slot].value = retain(object);
+    } else {
+      symbol_slots_[symbol] = slots_.size();
+      slots_.push_back({symbol, retain(object), slot});
+    }
+    bump_binding_epoch(symbol);
     return true;
   }
 
@@ -225,18 +430,18 @@ public:
   }
 
   bool push_scope() override {
-    scopes_.emplace_back();
-    current_scope_level_++;
+    frames_.push_back({slots_.size(), frame_lambdas_.size()});
     return true;
   }
 
   bool pop_scope() override {
-    if (scopes_.empty()) {
+    if (frames_.empty()) {
       return false;
     }
-    cleanup_lambdas_at_scope(current_scope_level_);
-    scopes_.pop_back();
-    current_scope_level_--;
+    const frame_s &frame = frames_.back();
+    release_bindings(frame.first_slot);
+    release_frame_lambdas(frame.first_lambda);
+    frames_.pop_back();
     return true;
   }
 
@@ -248,11 +453,13 @@ public:
                        const slp::slp_object_c &body) override {
     function_definition_s def;
     def.parameters = parameters;
+    for (const auto &param : parameters) {
+      def.parameter_ids.push_back(slp::symbol_table().intern(param.name));
+    }
     def.return_type = return_type;
-    def.body = slp::slp_object_c::from_data(body.get_data(), body.get_symbols(),
-                                            body.get_root_offset());
-    def.scope_level = current_scope_level_;
+    def.body = retain(body);
     lambda_definitions_[id] = std::move(def);
+    frame_lambdas_.push_back(id);
     return true;
   }
 
@@ -260,6 +467,10 @@ public:
     return kernel_context_;
   }
 
+  bool has_lambda(std::uint64_t lambda_id) override {
+    return lambda_definitions_.count(lambda_id) > 0;
+  }
+
   std::string get_lambda_signature(std::uint64_t lambda_id) override {
     auto it = lambda_definitions_.find(lambda_id);
     if (it == lambda_definitions_.end()) {
@@ -313,10 +524,20 @@ public:
     return signature;
   }
 
-  void push_loop_context() override { loop_contexts_.emplace_back(); }
+  void push_loop_context() override {
+    push_scope();
+    loop_contexts_.emplace_back();
+    loop_contexts_.back().frame = frames_.size() - 1;
+    auto iteration = slp::slp_object_c::create_int(1);
+    define_symbol_id(iterations_symbol_, iteration);
+  }
 
   void pop_loop_context() override {
     if (!loop_contexts_.empty()) {
+      // Scopes a body abandoned by throwing go with the loop's own
+      while (frames_.size() > loop_contexts_.back().frame) {
+        pop_scope();
+      }
       loop_contexts_.pop_back();
     }
   }
@@ -327,8 +548,7 @@ public:
     if (loop_contexts_.empty()) {
       throw std::runtime_error("done called outside of do loop");
     }
-    loop_contexts_.back().return_value = slp::slp_object_c::from_data(
-        value.get_data(), value.get_symbols(), value.get_root_offset());
+    loop_contexts_.back().return_value = value.share();
     loop_contexts_.back().done_flag.store(true);
   }
 
@@ -343,10 +563,7 @@ public:
     if (loop_contexts_.empty()) {
       throw std::runtime_error("No loop context available");
     }
-    return slp::slp_object_c::from_data(
-        loop_contexts_.back().return_value.get_data(),
-        loop_contexts_.back().return_value.get_symbols(),
-        loop_contexts_.back().return_value.get_root_offset());
+    return loop_contexts_.back().return_value.share();
   }
 
   std::int64_t get_current_iteration() override {
@@ -357,9 +574,25 @@ public:
   }
 
   void increment_iteration() override {
-    if (!loop_contexts_.empty()) {
-      loop_contexts_.back().iteration++;
+    if (loop_contexts_.empty()) {
+      return;
+    }
+    auto &loop = loop_contexts_.back();
+    loop.iteration++;
+    while (frames_.size() > loop.frame + 1) {
+      pop_scope();
     }
+    const frame_s &frame = frames_[loop.frame];
+    release_bindings(frame.first_slot + 1);
+    release_frame_lambdas(frame.first_lambda);
+
+    // The body may have kept or rebound the last value; only a counter
+    // nothing else holds is rewritten
+    binding_slot_s &counter = slots_[frame.first_slot];
+    if (!counter.value.set_int(loop.iteration)) {
+      counter.value = slp::slp_object_c::create_int(loop.iteration);
+    }
+    bump_binding_epoch(iterations_symbol_);
   }
 
   bool define_form(const std::string &name,
@@ -385,6 +618,60 @@ public:
   }
 
 private:
+  /*
+      Environments are shallow bound: every symbol id indexes straight to the
+      slot holding its innermost binding, and frames are contiguous ranges of
+      one flat slot array. Scoping here is dynamic (a lambda body sees the
+      bindings of whoever called it), so slots are assigned when a binding is
+      made rather than by a static pass, but a lookup is still two indexed
+      loads with no hashing or string compares.
+  */
+  size_t resolve_slot(std::uint64_t symbol) const {
+    return symbol < symbol_slots_.size() ? symbol_slots_[symbol] : no_slot;
+  }
+
+  /*
+      Call sites cache what their head symbol resolved to. Builtins and kernel
+      functions are looked up before scopes so nothing can shadow them; a
+      lambda resolution stays valid until the symbol is bound or unbound in
+      any scope, which is what the per-symbol binding epoch tracks.
+  */
+  std::uint64_t binding_epoch(std::uint64_t symbol) const {
+    return symbol < binding_epochs_.size() ? binding_epochs_[symbol] : 0;
+  }
+
+  void bump_binding_epoch(std::uint64_t symbol) {
+    if (symbol >= binding_epochs_.size()) {
+      binding_epochs_.resize(symbol + 1, 0);
+    }
+    binding_epochs_[symbol]++;
+  }
+
+  void remember_dispatch(const void *site, const dispatch_entry_s &entry) {
+    // Sites from eval'd or generated code come and go; don't let them pile up
+    if (dispatch_cache_.size() >= max_dispatch_cache_entries) {
+      dispatch_cache_.clear();
+    }
+    dispatch_cache_[site] = entry;
+  }
+
+  /*
+      Bindings and lambdas made in the outermost scope live for the rest of
+      the run. A value that views into a much larger store (a list element,
+      an unwrapped error, an eval'd result) is compacted there so it does not
+      keep the rest of that store alive. Inner scopes are popped soon after,
+      and small stores are not worth walking.
+  */
+  slp::slp_object_c retain(const slp::slp_object_c &object) const {
+    constexpr std::size_t small_store_bytes = 256;
+    if (frames_.size() > 1 || !object.has_data() ||
+        object.get_data().size() <= small_store_bytes ||
+        object.footprint() * 2 >= object.get_data().size()) {
+      return object.share();
+    }
+    return object.compact();
+  }
+
   void trigger_kernel_lock() {
     if (kernel_context_) {
       kernel_context_->lock();
@@ -416,24 +703,48 @@ private:
     type_symbol_map_[":list.."] = slp::slp_type_e::PAREN_LIST;
   }
 
-  void cleanup_lambdas_at_scope(size_t level) {
-    for (auto it = lambda_definitions_.begin();
-         it != lambda_definitions_.end();) {
-      if (it->second.scope_level >= level) {
-        it = lambda_definitions_.erase(it);
-      } else {
-        ++it;
-      }
+  void release_bindings(size_t first_slot) {
+    while (slots_.size() > first_slot) {
+      binding_slot_s &binding = slots_.back();
+      symbol_slots_[binding.symbol] = binding.shadowed;
+      bump_binding_epoch(binding.symbol);
+      slots_.pop_back();
     }
   }
 
+  void release_frame_lambdas(size_t first_lambda) {
+    for (size_t i = first_lambda; i < frame_lambdas_.size(); i++) {
+      lambda_definitions_.erase(frame_lambdas_[i]);
+    }
+    frame_lambdas_.resize(first_lambda);
+  }
+
+  /*
+      Runs a builtin or kernel function, letting eval know whether the call
+      it is serving sits in tail position and whether the function handles
+      pending errors. The state is put back however the function leaves, as
+      recover can catch a throw from a nested call.
+  */
+  slp::slp_object_c call_builtin(const callable_symbol_s &callable,
+                                 slp::slp_object_c &object, bool tail) {
+    struct restore_s {
+      builtin_state_s &state;
+      builtin_state_s saved;
+      ~restore_s() { state = saved; }
+    } restore{builtin_, builtin_};
+    builtin_ = {tail, callable.handles_pending_errors};
+    return callable.function(*this, object);
+  }
+
+  [[noreturn]] void throw_pending_error() {
+    pending_error_ = false;
+    throw std::runtime_error(std::move(pending_message_));
+  }
+
   slp::slp_object_c handle_aberrant_call(slp::slp_object_c &aberrant_obj,
-                                         slp::slp_object_c::list_c list) {
-    const std::uint8_t *base_ptr = aberrant_obj.get_data().data();
-    const std::uint8_t *unit_ptr = base_ptr + aberrant_obj.get_root_offset();
-    const slp::slp_unit_of_store_t *unit =
-        reinterpret_cast<const slp::slp_unit_of_store_t *>(unit_ptr);
-    std::uint64_t id = unit->data.uint64;
+                                         slp::slp_object_c::list_c list,
+                                         bool tail) {
+    std::uint64_t id = aberrant_obj.as_handle();
 
     /*
       Note: We will handle other compelxt types here. For now, we are just
@@ -441,73 +752,227 @@ private:
     */
     auto lambda_it = lambda_definitions_.find(id);
     if (lambda_it != lambda_definitions_.end()) {
-      return handle_lambda_call(id, list);
+      return handle_lambda_call(id, list, tail);
     }
 
-    throw std::runtime_error("Unknown function");
+    return raise_error("Unknown function");
   }
 
+  /*
+      Arguments are evaluated in the caller's scope onto arg_stack_. A call
+      in tail position of a lambda body goes no further: it is left pending
+      for the invoke_lambda already running, which picks it up once the body
+      unwinds, so tail recursion never nests on the native stack.
+  */
   slp::slp_object_c handle_lambda_call(std::uint64_t lambda_id,
-                                       slp::slp_object_c::list_c list) {
+                                       slp::slp_object_c::list_c list,
+                                       bool tail) {
     const auto &func_def = lambda_definitions_[lambda_id];
 
     if (list.size() - 1 != func_def.parameters.size()) {
-      throw std::runtime_error(
-          fmt::format("Function expects {} arguments, got {}",
-                      func_def.parameters.size(), list.size() - 1));
+      return raise_error(fmt::format("Function expects {} arguments, got {}",
+                                     func_def.parameters.size(),
+                                     list.size() - 1));
     }
 
-    std::vector<slp::slp_object_c> arg_values;
+    arg_stack_guard_s guard{arg_stack_, arg_stack_.size()};
     for (size_t i = 1; i < list.size(); i++) {
       auto arg = list.at(i);
-      auto evaled_arg = eval(arg);
-
-      const auto &param = func_def.parameters[i - 1];
-      if (param.type != slp::slp_type_e::NONE &&
-          evaled_arg.type() != param.type) {
-        throw std::runtime_error(fmt::format(
-            "Argument {} type mismatch: expected {}, got {}", i,
-            static_cast<int>(param.type), static_cast<int>(evaled_arg.type())));
+      auto evaled_arg = evaluate(arg);
+      if (pending_error_) {
+        return evaled_arg;
       }
 
-      arg_values.push_back(std::move(evaled_arg));
+      if (!push_argument(func_def, i - 1, std::move(evaled_arg))) {
+        return slp::slp_object_c();
+      }
     }
 
-    push_scope();
+    if (tail) {
+      guard.keep = true;
+      tail_call_ = lambda_id;
+      return slp::slp_object_c();
+    }
+    return invoke_lambda(lambda_id, guard.base);
+  }
 
-    for (size_t i = 0; i < func_def.parameters.size(); i++) {
-      define_symbol(func_def.parameters[i].name, arg_values[i]);
+  slp::slp_object_c
+  call_lambda_with(std::uint64_t lambda_id,
+                   std::span<const slp::slp_object_c> args) {
+    auto lambda_it = lambda_definitions_.find(lambda_id);
+    if (lambda_it == lambda_definitions_.end()) {
+      return raise_error("Unknown function");
     }
+    const auto &func_def = lambda_it->second;
 
-    auto body_copy = slp::slp_object_c::from_data(
-        func_def.body.get_data(), func_def.body.get_symbols(),
-        func_def.body.get_root_offset());
-    auto result = eval(body_copy);
+    if (args.size() != func_def.parameters.size()) {
+      return raise_error(fmt::format("Function expects {} arguments, got {}",
+                                     func_def.parameters.size(), args.size()));
+    }
 
-    if (func_def.return_type != slp::slp_type_e::NONE &&
-        result.type() != func_def.return_type) {
-      std::string error_msg =
-          "@(internal function error: returned unexpected type)";
-      auto error_parse = slp::parse(error_msg);
-      pop_scope();
-      return error_parse.take();
+    arg_stack_guard_s guard{arg_stack_, arg_stack_.size()};
+    for (size_t i = 0; i < args.size(); i++) {
+      if (!push_argument(func_def, i, args[i].share())) {
+        return slp::slp_object_c();
+      }
+    }
+    return invoke_lambda(lambda_id, guard.base);
+  }
+
+  // Raises and returns false when arg doesn't have the parameter's type
+  bool push_argument(const function_definition_s &func_def, size_t index,
+                     slp::slp_object_c arg) {
+    const auto &param = func_def.parameters[index];
+    if (param.type != slp::slp_type_e::NONE && arg.type() != param.type) {
+      raise_error(fmt::format("Argument {} type mismatch: expected {}, got {}",
+                              index + 1, static_cast<int>(param.type),
+                              static_cast<int>(arg.type())));
+      return false;
+    }
+    arg_stack_.push_back(std::move(arg));
+    return true;
+  }
+
+  /*
+      The explicit call loop. Each pass binds the arguments at args_base in a
+      fresh frame and evaluates the body with its last form in tail position;
+      if that left a call pending, the loop takes it instead of returning.
+
+      Scoping is dynamic, so the callee of a tail call could see the caller's
+      bindings. The caller's frame is dropped before the callee's is pushed
+      only when nothing in it can be seen that way: it registered no lambdas
+      and every binding in it is shadowed by a parameter of the callee, as
+      with plain self recursion. Otherwise the callee's frame goes on top and
+      all of them are popped when the chain returns.
+
+      Return types are checked innermost first once the chain returns, as
+      the nested calls would have; a run of one type is checked once.
+  */
+  slp::slp_object_c invoke_lambda(std::uint64_t lambda_id, size_t args_base) {
+    arg_stack_guard_s guard{arg_stack_, args_base};
+    size_t base_frame = frames_.size();
+    size_t checks_base = return_checks_.size();
+    struct checks_guard_s {
+      std::vector<slp::slp_type_e> &checks;
+      size_t base;
+      ~checks_guard_s() { checks.resize(base); }
+    } checks_guard{return_checks_, checks_base};
+
+    slp::slp_object_c result;
+    while (true) {
+      const auto &func_def = lambda_definitions_[lambda_id];
+      if (return_checks_.size() == checks_base ||
+          return_checks_.back() != func_def.return_type) {
+        return_checks_.push_back(func_def.return_type);
+      }
+
+      if (frames_.size() > base_frame && frame_is_unobservable(func_def)) {
+        pop_scope();
+      }
+      push_scope();
+      for (size_t i = 0; i < func_def.parameters.size(); i++) {
+        define_symbol_id(func_def.parameter_ids[i], arg_stack_[args_base + i]);
+      }
+      arg_stack_.resize(args_base);
+
+      auto body = func_def.body.share();
+      tail_position_ = true;
+      result = evaluate(body);
+
+      if (tail_call_ == 0 || pending_error_) {
+        tail_call_ = 0;
+        break;
+      }
+      lambda_id = tail_call_;
+      tail_call_ = 0;
     }
 
-    pop_scope();
+    while (frames_.size() > base_frame) {
+      pop_scope();
+    }
+    if (pending_error_) {
+      return result;
+    }
 
+    for (size_t i = return_checks_.size(); i > checks_base; i--) {
+      slp::slp_type_e return_type = return_checks_[i - 1];
+      if (return_type != slp::slp_type_e::NONE &&
+          result.type() != return_type) {
+        result = slp::constant_error(
+            "internal function error: returned unexpected type");
+      }
+    }
     return result;
   }
 
-  std::map<std::string, callable_symbol_s> callable_symbols_;
-  std::vector<std::map<std::string, slp::slp_object_c>> scopes_;
-  std::map<std::uint64_t, function_definition_s> lambda_definitions_;
+  bool frame_is_unobservable(const function_definition_s &callee) const {
+    const frame_s &frame = frames_.back();
+    if (frame.first_lambda != frame_lambdas_.size()) {
+      return false;
+    }
+    for (size_t slot = frame.first_slot; slot < slots_.size(); slot++) {
+      if (std::find(callee.parameter_ids.begin(), callee.parameter_ids.end(),
+                    slots_[slot].symbol) == callee.parameter_ids.end()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Drops arguments left behind by a call that threw or has been bound
+  struct arg_stack_guard_s {
+    std::vector<slp::slp_object_c> &stack;
+    size_t base;
+    bool keep{false};
+    ~arg_stack_guard_s() {
+      if (!keep) {
+        stack.resize(base);
+      }
+    }
+  };
+
+  // keyed by interned symbol id
+  std::unordered_map<std::uint64_t, callable_symbol_s> callable_symbols_;
+  static constexpr size_t no_slot = static_cast<size_t>(-1);
+  std::vector<binding_slot_s> slots_;
+  std::vector<frame_s> frames_;
+  std::vector<size_t> symbol_slots_;  // symbol id -> innermost slot
+  std::unordered_map<std::uint64_t, function_definition_s> lambda_definitions_;
+  std::vector<std::uint64_t> frame_lambdas_; // ids, grouped by frame
   std::map<std::string, slp::slp_type_e> type_symbol_map_;
   std::map<std::string, std::vector<slp::slp_type_e>> form_definitions_;
   std::uint64_t next_lambda_id_;
-  size_t current_scope_level_;
   kernels::kernel_context_if *kernel_context_;
   bool kernels_locked_triggered_;
   std::vector<loop_context_s> loop_contexts_;
+  std::uint64_t iterations_symbol_;
+
+  static constexpr std::size_t max_dispatch_cache_entries = 4096;
+  std::unordered_map<const void *, dispatch_entry_s> dispatch_cache_;
+  std::vector<std::uint64_t> binding_epochs_;
+
+  static constexpr std::size_t max_eval_cache_entries = 64;
+  std::list<eval_cache_entry_s> eval_cache_; // most recently used first
+  std::unordered_map<std::uint64_t, std::list<eval_cache_entry_s>::iterator>
+      eval_cache_index_;
+  eval_cache_stats_s eval_cache_stats_;
+
+  // Set by eval for the object a tail position was handed to
+  bool tail_position_{false};
+
+  // What call_builtin knows about the builtin running innermost
+  struct builtin_state_s {
+    bool in_tail{false};
+    bool handles_pending_errors{false};
+  } builtin_;
+  std::uint64_t tail_call_{0}; // lambda id; arguments are atop arg_stack_
+  std::vector<slp::slp_object_c> arg_stack_;
+  std::vector<slp::slp_type_e> return_checks_;
+
+  // Raised errors only wait here while a recover is running to take them
+  std::size_t recover_depth_{0};
+  bool pending_error_{false};
+  std::string pending_message_;
 };
 
 std::unique_ptr<callable_context_if> create_interpreter(
@@ -4,6 +4,7 @@
 #include <map>
 #include <memory>
 #include <slp/slp.hpp>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,12 @@ struct callable_parameter_s {
   slp::slp_type_e type;
 };
 
+struct eval_cache_stats_s {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};
+  std::size_t entries{0};
+};
+
 class callable_context_if {
 public:
   virtual ~callable_context_if() = default;
@@ -45,6 +52,43 @@ public:
   // lookup
   virtual slp::slp_object_c eval(slp::slp_object_c &object) = 0;
 
+  // eval for an object whose value the calling function returns unchanged
+  // (the taken branch of an if, say). When that function was itself called
+  // in tail position of a lambda body, a lambda call made here replaces the
+  // running call instead of nesting on the native stack.
+  virtual slp::slp_object_c eval_tail(slp::slp_object_c &object) = 0;
+
+  // Script errors (a failed assert, a bad argument count, an unknown
+  // callable) are raised rather than thrown. Under a recover the error is
+  // left pending and evaluation unwinds by returning: eval does nothing while
+  // one is pending, and functions that set handles_pending_errors return as
+  // soon as an eval they make leaves one. Anywhere else it is thrown as a
+  // std::runtime_error, as is a pending error that reaches a function not
+  // handling them. Returns none for the raising function to return.
+  virtual slp::slp_object_c raise_error(const std::string &message) = 0;
+  virtual bool has_pending_error() = 0;
+
+  // eval that takes any error raised or thrown while evaluating: returns
+  // false with its message, the scopes and loops it left open closed again
+  virtual bool eval_recovering(slp::slp_object_c &object,
+                               slp::slp_object_c &result,
+                               std::string &message) = 0;
+
+  // calls a registered lambda with arguments that are already values, checked
+  // against its parameters as they would be for a call written in source.
+  // Errors are raised as eval raises them
+  virtual slp::slp_object_c
+  call_lambda(std::uint64_t lambda_id,
+              std::span<const slp::slp_object_c> args) = 0;
+
+  // The tree for eval's code string (a DQ_LIST). Strings are parsed once and
+  // kept in a small cache of the most recently used, so evaluating one
+  // again reuses its tree and the call sites already resolved in it. Sets
+  // out to a view of the tree, or returns false with the parse error
+  virtual bool parse_eval_code(const slp::slp_object_c &code,
+                               slp::slp_object_c &out, std::string &error) = 0;
+  virtual eval_cache_stats_s get_eval_cache_stats() = 0;
+
   virtual bool has_symbol(const std::string &symbol,
                           bool local_scope_only = false) = 0;
 
@@ -52,6 +96,10 @@ public:
   virtual bool define_symbol(const std::string &symbol,
                              slp::slp_object_c &object) = 0;
 
+  // same as define_symbol for a symbol already interned in slp::symbol_table()
+  virtual bool define_symbol_id(std::uint64_t symbol_id,
+                                slp::slp_object_c &object) = 0;
+
   // when the function gets something that it needs to determin is a valid type
   // or not it calls this if returns true the out_type will be set tot he slp
   // type that the symbol encodes (example: :int :real :str etc)
@@ -71,6 +119,11 @@ public:
 
   virtual std::string get_lambda_signature(std::uint64_t lambda_id) = 0;
 
+  // false once the scope that registered the lambda has been popped
+  virtual bool has_lambda(std::uint64_t lambda_id) = 0;
+
+  // A loop context opens the scope its body runs in, with $iterations bound;
+  // increment_iteration() clears that scope for the next pass
   virtual void push_loop_context() = 0;
   virtual void pop_loop_context() = 0;
   virtual bool is_in_loop() = 0;
@@ -112,6 +165,11 @@ struct callable_symbol_s {
   std::function<type_info_s(compiler_context_if &context,
                             slp::slp_object_c &args_list)>
       typecheck_function;
+
+  // set when the function raises its errors through raise_error and returns
+  // as soon as an eval it makes leaves one pending; functions that don't
+  // only ever see errors as exceptions
+  bool handles_pending_errors{false};
 };
 
 std::unique_ptr<callable_context_if> create_interpreter(
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <kernel_api.hpp>
 #include <slp/slp.hpp>
+#include <slp/symbols.hpp>
 #include <sstream>
 
 /*
@@ -65,6 +66,14 @@ slp::slp_object_c eval_callback(pkg::kernel::context_t ctx,
   return context->eval(const_cast<slp::slp_object_c &>(obj));
 }
 
+slp::slp_object_c call_lambda_callback(pkg::kernel::context_t ctx,
+                                       std::uint64_t lambda_id,
+                                       const slp::slp_object_c *args,
+                                       std::size_t count) {
+  auto *context = static_cast<callable_context_if *>(ctx);
+  return context->call_lambda(lambda_id, {args, count});
+}
+
 const pkg::kernel::system_info_s *
 get_system_info_callback(pkg::kernel::system_t sys) {
   auto *system_ctx = static_cast<system_context_s *>(sys);
@@ -252,6 +261,7 @@ kernel_manager_c::kernel_manager_c(logger_t logger,
   api_table_->eval = eval_callback;
   api_table_->get_system_info = get_system_info_callback;
   api_table_->system = &g_system_context;
+  api_table_->call_lambda = call_lambda_callback;
 }
 
 kernel_manager_c::~kernel_manager_c() {
@@ -287,6 +297,48 @@ callable_context_if *kernel_manager_c::get_parent_context() const {
   return parent_context_;
 }
 
+kernel_definition_cache_c &kernel_manager_c::get_definition_cache() {
+  return definition_cache_;
+}
+
+bool kernel_definition_cache_c::get(const std::string &kernel_dir,
+                                    logger_t logger, slp::slp_object_c &out) {
+  auto kernel_sxs_path = std::filesystem::path(kernel_dir) / "kernel.sxs";
+
+  std::error_code ec;
+  auto key = std::filesystem::weakly_canonical(kernel_sxs_path, ec).string();
+  if (ec) {
+    key = kernel_sxs_path.string();
+  }
+
+  auto it = definitions_.find(key);
+  if (it != definitions_.end()) {
+    out = it->second.share();
+    return true;
+  }
+
+  std::ifstream file(kernel_sxs_path);
+  if (!file.is_open()) {
+    logger->error("Could not open kernel.sxs: {}", kernel_sxs_path.string());
+    return false;
+  }
+
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  file.close();
+
+  auto parse_result = slp::parse(buffer.str());
+  if (parse_result.is_error()) {
+    logger->error("Failed to parse kernel.sxs: {}",
+                  parse_result.error().message);
+    return false;
+  }
+
+  out = parse_result.take();
+  definitions_.emplace(key, out.share());
+  return true;
+}
+
 std::string
 kernel_manager_c::resolve_kernel_path(const std::string &kernel_name) {
   std::filesystem::path kernel_file = "kernel.sxs";
@@ -317,28 +369,11 @@ kernel_manager_c::resolve_kernel_path(const std::string &kernel_name) {
 
 bool kernel_manager_c::load_kernel_dylib(const std::string &kernel_name,
                                          const std::string &kernel_dir) {
-  auto kernel_sxs_path = std::filesystem::path(kernel_dir) / "kernel.sxs";
-
-  std::ifstream file(kernel_sxs_path);
-  if (!file.is_open()) {
-    logger_->error("Could not open kernel.sxs: {}", kernel_sxs_path.string());
+  slp::slp_object_c kernel_obj;
+  if (!definition_cache_.get(kernel_dir, logger_, kernel_obj)) {
     return false;
   }
 
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  std::string source = buffer.str();
-  file.close();
-
-  auto parse_result = slp::parse(source);
-  if (parse_result.is_error()) {
-    logger_->error("Failed to parse kernel.sxs: {}",
-                   parse_result.error().message);
-    return false;
-  }
-
-  auto kernel_obj = parse_result.take();
-
   kernel_definition_context_s def_ctx;
   def_ctx.manager = this;
   def_ctx.kernel_name = kernel_name;
@@ -389,6 +424,15 @@ bool kernel_manager_c::load_kernel_dylib(const std::string &kernel_name,
     return false;
   }
 
+  // The kernel carries its own copy of slp; point it at our symbol table so
+  // symbol ids mean the same thing on both sides of the boundary
+  typedef void (*bind_symbols_fn_t)(void *);
+  auto bind_symbols = reinterpret_cast<bind_symbols_fn_t>(
+      dlsym(handle, "slp_bind_symbol_table"));
+  if (bind_symbols) {
+    bind_symbols(&slp::symbol_table());
+  }
+
   typedef void (*kernel_init_fn_t)(pkg::kernel::registry_t,
                                    const pkg::kernel::api_table_s *);
   auto kernel_init =
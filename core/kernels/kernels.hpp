@@ -28,6 +28,22 @@ public:
   virtual callable_symbol_s *get_function(const std::string &name) = 0;
 };
 
+/*
+    Parsed kernel.sxs files keyed by path. The type checker and the kernel
+    manager both need a kernel's declarations; sharing one cache means each
+    kernel.sxs is read and parsed once per run.
+*/
+class kernel_definition_cache_c {
+public:
+  // Sets out to the parsed kernel.sxs in kernel_dir, reading it on first use.
+  // Logs and returns false if the file can not be read or parsed
+  bool get(const std::string &kernel_dir, logger_t logger,
+           slp::slp_object_c &out);
+
+private:
+  std::map<std::string, slp::slp_object_c> definitions_;
+};
+
 class kernel_manager_c {
 public:
   explicit kernel_manager_c(logger_t logger,
@@ -48,6 +64,8 @@ public:
 
   callable_context_if *get_parent_context() const;
 
+  kernel_definition_cache_c &get_definition_cache();
+
   void register_kernel_function(const std::string &kernel_name,
                                 const std::string &function_name,
                                 void *function_ptr, int return_type,
@@ -66,6 +84,7 @@ private:
   std::set<std::string> loaded_kernels_;
   std::map<std::string, void *> loaded_dylibs_;
   std::map<std::string, callable_symbol_s> registered_functions_;
+  kernel_definition_cache_c definition_cache_;
   callable_context_if *parent_context_;
   std::unique_ptr<pkg::kernel::api_table_s> api_table_;
   std::map<std::string, void (*)(const pkg::kernel::api_table_s *)>
@@ -10,9 +10,11 @@ namespace pkg::core::type_checker {
 
 type_checker_c::type_checker_c(logger_t logger,
                                std::vector<std::string> include_paths,
-                               std::string working_directory)
+                               std::string working_directory,
+                               kernels::kernel_definition_cache_c *kernel_definitions)
     : logger_(logger), include_paths_(std::move(include_paths)),
-      working_directory_(std::move(working_directory)) {}
+      working_directory_(std::move(working_directory)),
+      kernel_definitions_(kernel_definitions) {}
 
 type_checker_c::~type_checker_c() = default;
 
@@ -40,6 +42,13 @@ bool type_checker_c::check(const std::string &file_path) {
 
 bool type_checker_c::check_source(const std::string &source,
                                   const std::string &source_name) {
+  slp::slp_object_c program;
+  return check_source(source, source_name, program);
+}
+
+bool type_checker_c::check_source(const std::string &source,
+                                  const std::string &source_name,
+                                  slp::slp_object_c &program) {
   logger_->info("Type checking: {}", source_name);
 
   auto parse_result = slp::parse(source);
@@ -54,12 +63,14 @@ bool type_checker_c::check_source(const std::string &source,
     auto datum_symbols = datum::get_standard_callable_symbols();
     symbols.insert(datum_symbols.begin(), datum_symbols.end());
 
-    auto context = create_compiler_context(logger_, include_paths_,
-                                           working_directory_, symbols);
+    auto context =
+        create_compiler_context(logger_, include_paths_, working_directory_,
+                                symbols, nullptr, kernel_definitions_);
 
     context->set_current_file(source_name);
 
-    auto obj = parse_result.take();
+    program = parse_result.take();
+    auto obj = program.share();
     context->eval_type(obj);
 
     logger_->info("Type checking passed: {}", source_name);
@@ -82,8 +93,9 @@ type_info_s type_checker_c::check_expression(const std::string &source,
   auto datum_symbols = datum::get_standard_callable_symbols();
   symbols.insert(datum_symbols.begin(), datum_symbols.end());
 
-  auto context = create_compiler_context(logger_, include_paths_,
-                                         working_directory_, symbols);
+  auto context =
+      create_compiler_context(logger_, include_paths_, working_directory_,
+                              symbols, nullptr, kernel_definitions_);
 
   context->set_current_file(source_name);
 
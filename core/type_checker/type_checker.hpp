@@ -9,9 +9,12 @@ namespace pkg::core::type_checker {
 
 class type_checker_c {
 public:
-  explicit type_checker_c(logger_t logger,
-                          std::vector<std::string> include_paths,
-                          std::string working_directory);
+  // kernel_definitions, when given, is shared with the kernel manager so
+  // kernel.sxs files read while checking are not parsed again at run time
+  explicit type_checker_c(
+      logger_t logger, std::vector<std::string> include_paths,
+      std::string working_directory,
+      kernels::kernel_definition_cache_c *kernel_definitions = nullptr);
   ~type_checker_c();
 
   bool check(const std::string &file_path);
@@ -19,6 +22,11 @@ public:
   bool check_source(const std::string &source,
                     const std::string &source_name = "<string>");
 
+  // Same as check_source, but hands back the parsed program so the caller
+  // can run it without parsing the source a second time
+  bool check_source(const std::string &source, const std::string &source_name,
+                    slp::slp_object_c &program);
+
   type_info_s check_expression(const std::string &source,
                                const std::string &source_name = "<expr>");
 
@@ -26,6 +34,7 @@ private:
   logger_t logger_;
   std::vector<std::string> include_paths_;
   std::string working_directory_;
+  kernels::kernel_definition_cache_c *kernel_definitions_;
 };
 
 } // namespace pkg::core::type_checker
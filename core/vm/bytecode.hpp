@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <slp/slp.hpp>
+#include <string>
+#include <vector>
+
+namespace pkg::core::vm {
+
+typedef std::vector<std::uint8_t> byte_vector_t;
+
+/*
+    Stack machine opcodes. Every compiled expression leaves exactly one value
+    on the stack. Operands follow the opcode inline, little end first:
+
+      u32  index into the constant pool
+      u32  index into the function table
+      i32  jump displacement, relative to the end of the jump instruction
+
+    Forms the compiler does not lower are kept as constants and handed back
+    to the runtime context (EVAL, CALL_BUILTIN), so an image always runs
+    with the same semantics as the tree walking interpreter.
+*/
+enum class opcode_e : std::uint8_t {
+  NOP = 0,
+  PUSH_CONST,    // u32 constant                -> value
+  PUSH_NONE,     //                             -> none
+  LOAD,          // u32 symbol constant         -> bound value or the symbol
+  POP,           // value                       ->
+  DECLARE,       // u32 symbol constant; throws if bound in the current scope
+  DEFINE,        // u32 symbol constant; value  -> none
+  JUMP,          // i32
+  JUMP_IF_FALSE, // i32; value                  -> (false is integer 0)
+  PUSH_SCOPE,
+  POP_SCOPE,
+  LOCK_KERNELS,  // first non-datum element of a bracket list
+  LOOP_ENTER,     // opens the loop frame with $iterations bound
+  LOOP_CONTINUE,  // i32; jumps back unless done was signalled
+  LOOP_LEAVE,     //                            -> loop result
+  LOOP_DONE,      // value                      -> none
+  MAKE_LAMBDA,    // u32 fn form constant, u32 body function -> aberrant
+  CALL,           // u32 form constant, u32 first arg function, u32 argc
+  CALL_BUILTIN,   // u32 name constant, u32 form constant
+  EVAL,           // u32 form constant
+  RETURN,         // value                      -> (returned to caller)
+};
+
+/*
+    A compiled program. Function 0 is the entry point; lambda bodies and
+    call arguments are functions of their own. Constants live in one shared
+    store whose root is a BRACE_LIST of every constant, in index order.
+*/
+struct image_s {
+  std::vector<byte_vector_t> functions;
+  slp::slp_object_c constants;
+};
+
+// "SXSB", then a u32 format version
+inline constexpr std::uint8_t image_magic[4] = {'S', 'X', 'S', 'B'};
+inline constexpr std::uint32_t image_version = 3;
+
+extern bool is_image(const byte_vector_t &bytes);
+
+extern byte_vector_t serialize_image(const image_s &image);
+
+// Throws std::runtime_error on a malformed or foreign image
+extern image_s load_image(const byte_vector_t &bytes);
+
+} // namespace pkg::core::vm
@@ -0,0 +1,137 @@
+#include "bytecode.hpp"
+#include <cstring>
+#include <fmt/core.h>
+#include <slp/image.hpp>
+#include <stdexcept>
+
+namespace pkg::core::vm {
+
+namespace {
+
+void write_u32(byte_vector_t &out, std::uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+void write_u64(byte_vector_t &out, std::uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+void write_bytes(byte_vector_t &out, const std::uint8_t *data, size_t size) {
+  out.insert(out.end(), data, data + size);
+}
+
+struct reader_s {
+  const byte_vector_t &bytes;
+  size_t pos{0};
+
+  const std::uint8_t *take(size_t count) {
+    if (count > bytes.size() - pos) {
+      throw std::runtime_error(
+          fmt::format("truncated image at byte {}", pos));
+    }
+    const std::uint8_t *at = bytes.data() + pos;
+    pos += count;
+    return at;
+  }
+
+  std::uint32_t u32() {
+    const std::uint8_t *at = take(4);
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+      value |= static_cast<std::uint32_t>(at[i]) << (i * 8);
+    }
+    return value;
+  }
+
+  std::uint64_t u64() {
+    const std::uint8_t *at = take(8);
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+      value |= static_cast<std::uint64_t>(at[i]) << (i * 8);
+    }
+    return value;
+  }
+};
+
+} // namespace
+
+bool is_image(const byte_vector_t &bytes) {
+  return bytes.size() >= sizeof(image_magic) &&
+         std::memcmp(bytes.data(), image_magic, sizeof(image_magic)) == 0;
+}
+
+/*
+    Layout:
+      magic, u32 version
+      u32 function count, then per function: u32 size, code
+      u64 size, then the constants as an slp image (slp/image.hpp)
+
+    The slp image carries the symbols the constants use, so the loader can
+    remap them onto the ids of the process running the image.
+*/
+byte_vector_t serialize_image(const image_s &image) {
+  byte_vector_t out;
+  write_bytes(out, image_magic, sizeof(image_magic));
+  write_u32(out, image_version);
+
+  write_u32(out, static_cast<std::uint32_t>(image.functions.size()));
+  for (const auto &code : image.functions) {
+    write_u32(out, static_cast<std::uint32_t>(code.size()));
+    write_bytes(out, code.data(), code.size());
+  }
+
+  auto constants = slp::write_image(image.constants);
+  if (constants.empty()) {
+    throw std::runtime_error("image constants are too large");
+  }
+  write_u64(out, constants.size());
+  write_bytes(out, constants.data(), constants.size());
+
+  return out;
+}
+
+image_s load_image(const byte_vector_t &bytes) {
+  if (!is_image(bytes)) {
+    throw std::runtime_error("not an sxs image");
+  }
+
+  reader_s reader{bytes, sizeof(image_magic)};
+  std::uint32_t version = reader.u32();
+  if (version != image_version) {
+    throw std::runtime_error(fmt::format(
+        "unsupported image version {} (expected {})", version, image_version));
+  }
+
+  image_s image;
+  std::uint32_t function_count = reader.u32();
+  image.functions.reserve(function_count);
+  for (std::uint32_t i = 0; i < function_count; i++) {
+    std::uint32_t size = reader.u32();
+    const std::uint8_t *code = reader.take(size);
+    image.functions.emplace_back(code, code + size);
+  }
+  if (image.functions.empty()) {
+    throw std::runtime_error("image has no entry function");
+  }
+
+  std::uint64_t constants_size = reader.u64();
+  const std::uint8_t *constants = reader.take(constants_size);
+  std::string error;
+  if (!slp::read_image(
+          std::string_view(reinterpret_cast<const char *>(constants),
+                           constants_size),
+          image.constants, error)) {
+    throw std::runtime_error(fmt::format("image constants: {}", error));
+  }
+  if (image.constants.type() != slp::slp_type_e::BRACE_LIST) {
+    throw std::runtime_error("image constant root is not a brace list");
+  }
+
+  return image;
+}
+
+} // namespace pkg::core::vm
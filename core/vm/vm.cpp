@@ -0,0 +1,529 @@
+#include "vm.hpp"
+#include "core/kernels/kernels.hpp"
+#include <algorithm>
+#include <fmt/core.h>
+#include <iterator>
+#include <slp/constants.hpp>
+#include <stdexcept>
+
+namespace pkg::core::vm {
+
+namespace {
+
+inline std::uint32_t read_u32(const std::uint8_t *&pc) {
+  std::uint32_t value = static_cast<std::uint32_t>(pc[0]) |
+                        static_cast<std::uint32_t>(pc[1]) << 8 |
+                        static_cast<std::uint32_t>(pc[2]) << 16 |
+                        static_cast<std::uint32_t>(pc[3]) << 24;
+  pc += 4;
+  return value;
+}
+
+inline std::int32_t read_i32(const std::uint8_t *&pc) {
+  return static_cast<std::int32_t>(read_u32(pc));
+}
+
+enum class operands_e { NONE, CONSTANT, JUMP, LAMBDA, CALL, BUILTIN };
+
+operands_e operands_of(opcode_e op) {
+  switch (op) {
+  case opcode_e::PUSH_CONST:
+  case opcode_e::LOAD:
+  case opcode_e::DECLARE:
+  case opcode_e::DEFINE:
+  case opcode_e::EVAL:
+    return operands_e::CONSTANT;
+  case opcode_e::JUMP:
+  case opcode_e::JUMP_IF_FALSE:
+  case opcode_e::LOOP_CONTINUE:
+    return operands_e::JUMP;
+  case opcode_e::MAKE_LAMBDA:
+    return operands_e::LAMBDA;
+  case opcode_e::CALL:
+    return operands_e::CALL;
+  case opcode_e::CALL_BUILTIN:
+    return operands_e::BUILTIN;
+  case opcode_e::NOP:
+  case opcode_e::PUSH_NONE:
+  case opcode_e::POP:
+  case opcode_e::PUSH_SCOPE:
+  case opcode_e::POP_SCOPE:
+  case opcode_e::LOCK_KERNELS:
+  case opcode_e::LOOP_ENTER:
+  case opcode_e::LOOP_LEAVE:
+  case opcode_e::LOOP_DONE:
+  case opcode_e::RETURN:
+    return operands_e::NONE;
+  }
+  throw std::runtime_error(
+      fmt::format("vm: unknown opcode {}", static_cast<int>(op)));
+}
+
+size_t operand_bytes(operands_e operands) {
+  switch (operands) {
+  case operands_e::NONE:
+    return 0;
+  case operands_e::CONSTANT:
+  case operands_e::JUMP:
+    return 4;
+  case operands_e::LAMBDA:
+  case operands_e::BUILTIN:
+    return 8;
+  case operands_e::CALL:
+    return 12;
+  }
+  return 0;
+}
+
+} // namespace
+
+vm_c::vm_c(callable_context_if &context, image_s image,
+           const std::map<std::string, callable_symbol_s> &callable_symbols)
+    : context_(context), image_(std::move(image)),
+      callable_symbols_(callable_symbols) {
+  auto pool = image_.constants.as_list();
+  constants_.reserve(pool.size());
+  names_.resize(pool.size());
+  for (size_t i = 0; i < pool.size(); i++) {
+    constants_.push_back(pool.at(i));
+    if (constants_[i].type() == slp::slp_type_e::SYMBOL) {
+      names_[i] = constants_[i].as_symbol();
+    }
+  }
+  builtins_.resize(constants_.size(), nullptr);
+  call_sites_.resize(constants_.size());
+
+  verify();
+}
+
+/*
+    Checks every operand once up front so execute() can trust the image:
+    constants and functions are in range and of the kind the opcode expects,
+    and jumps land on an instruction boundary of the same function.
+*/
+void vm_c::verify() const {
+  auto fail = [](size_t function, size_t at, const std::string &why) {
+    throw std::runtime_error(fmt::format(
+        "vm: invalid image (function {} byte {}): {}", function, at, why));
+  };
+
+  for (size_t f = 0; f < image_.functions.size(); f++) {
+    const auto &code = image_.functions[f];
+    if (code.empty() ||
+        static_cast<opcode_e>(code.back()) != opcode_e::RETURN) {
+      fail(f, code.size(), "function does not end in RETURN");
+    }
+
+    std::vector<bool> boundary(code.size(), false);
+    std::vector<std::pair<size_t, std::int64_t>> jumps;
+
+    size_t at = 0;
+    while (at < code.size()) {
+      boundary[at] = true;
+      opcode_e op = static_cast<opcode_e>(code[at]);
+      operands_e operands = operands_e::NONE;
+      try {
+        operands = operands_of(op);
+      } catch (const std::exception &e) {
+        fail(f, at, e.what());
+      }
+      size_t size = 1 + operand_bytes(operands);
+      if (at + size > code.size()) {
+        fail(f, at, "truncated instruction");
+      }
+
+      const std::uint8_t *pc = code.data() + at + 1;
+      auto constant = [&](slp::slp_type_e expected, bool typed) {
+        std::uint32_t index = read_u32(pc);
+        if (index >= constants_.size()) {
+          fail(f, at, fmt::format("constant {} out of range", index));
+        }
+        if (typed && constants_[index].type() != expected) {
+          fail(f, at, fmt::format("constant {} has the wrong type", index));
+        }
+        return index;
+      };
+      auto function = [&](std::uint32_t index) {
+        if (index >= image_.functions.size()) {
+          fail(f, at, fmt::format("function {} out of range", index));
+        }
+      };
+
+      switch (operands) {
+      case operands_e::NONE:
+        break;
+      case operands_e::CONSTANT: {
+        bool symbol = op == opcode_e::LOAD || op == opcode_e::DECLARE ||
+                      op == opcode_e::DEFINE;
+        constant(slp::slp_type_e::SYMBOL, symbol);
+        break;
+      }
+      case operands_e::JUMP:
+        jumps.emplace_back(at, static_cast<std::int64_t>(at + size) +
+                                   read_i32(pc));
+        break;
+      case operands_e::LAMBDA: {
+        std::uint32_t form = constant(slp::slp_type_e::PAREN_LIST, true);
+        auto list = constants_[form].as_list();
+        if (list.size() != 4 ||
+            list.at(1).type() != slp::slp_type_e::PAREN_LIST ||
+            list.at(2).type() != slp::slp_type_e::SYMBOL ||
+            list.at(3).type() != slp::slp_type_e::BRACKET_LIST) {
+          fail(f, at, "malformed fn form");
+        }
+        function(read_u32(pc));
+        break;
+      }
+      case operands_e::CALL: {
+        std::uint32_t form = constant(slp::slp_type_e::PAREN_LIST, true);
+        auto list = constants_[form].as_list();
+        if (list.empty() || list.at(0).type() != slp::slp_type_e::SYMBOL) {
+          fail(f, at, "call form has no symbol head");
+        }
+        std::uint32_t first_arg = read_u32(pc);
+        std::uint32_t argc = read_u32(pc);
+        if (argc != list.size() - 1) {
+          fail(f, at, "argument count does not match the call form");
+        }
+        if (argc > 0) {
+          function(first_arg);
+          function(first_arg + argc - 1);
+        }
+        break;
+      }
+      case operands_e::BUILTIN:
+        constant(slp::slp_type_e::SYMBOL, true);
+        constant(slp::slp_type_e::PAREN_LIST, true);
+        break;
+      }
+
+      at += size;
+    }
+
+    for (const auto &[from, target] : jumps) {
+      if (target < 0 || static_cast<size_t>(target) >= code.size() ||
+          !boundary[static_cast<size_t>(target)]) {
+        fail(f, from, "jump target is not an instruction");
+      }
+    }
+  }
+}
+
+slp::slp_object_c vm_c::run() {
+  stack_.clear();
+  return execute(0);
+}
+
+slp::slp_object_c vm_c::execute(std::uint32_t function) {
+  const byte_vector_t &code = image_.functions[function];
+  const std::uint8_t *pc = code.data();
+  const size_t base = stack_.size();
+
+  while (true) {
+    opcode_e op = static_cast<opcode_e>(*pc++);
+
+    switch (op) {
+    case opcode_e::NOP:
+      break;
+
+    case opcode_e::PUSH_CONST:
+      stack_.push_back(constants_[read_u32(pc)].share());
+      break;
+
+    case opcode_e::PUSH_NONE:
+      stack_.emplace_back();
+      break;
+
+    case opcode_e::LOAD: {
+      auto symbol = constants_[read_u32(pc)].share();
+      stack_.push_back(context_.eval(symbol));
+      break;
+    }
+
+    case opcode_e::POP:
+      stack_.pop_back();
+      break;
+
+    case opcode_e::DECLARE: {
+      const std::string &name = names_[read_u32(pc)];
+      if (context_.has_symbol(name, true)) {
+        throw std::runtime_error(fmt::format(
+            "Symbol '{}' is already defined in current scope", name));
+      }
+      break;
+    }
+
+    case opcode_e::DEFINE:
+      context_.define_symbol_id(constants_[read_u32(pc)].as_symbol_id(),
+                                stack_.back());
+      stack_.back() = slp::slp_object_c();
+      break;
+
+    case opcode_e::JUMP: {
+      std::int32_t displacement = read_i32(pc);
+      pc += displacement;
+      break;
+    }
+
+    case opcode_e::JUMP_IF_FALSE: {
+      std::int32_t displacement = read_i32(pc);
+      const auto &condition = stack_.back();
+      bool is_false = condition.type() == slp::slp_type_e::INTEGER &&
+                      condition.as_int() == 0;
+      stack_.pop_back();
+      if (is_false) {
+        pc += displacement;
+      }
+      break;
+    }
+
+    case opcode_e::PUSH_SCOPE:
+      context_.push_scope();
+      break;
+
+    case opcode_e::POP_SCOPE:
+      context_.pop_scope();
+      break;
+
+    case opcode_e::LOCK_KERNELS:
+      if (!kernels_locked_) {
+        kernels_locked_ = true;
+        if (auto *kernel_context = context_.get_kernel_context()) {
+          kernel_context->lock();
+        }
+      }
+      break;
+
+    case opcode_e::LOOP_ENTER:
+      context_.push_loop_context();
+      break;
+
+    case opcode_e::LOOP_CONTINUE: {
+      std::int32_t displacement = read_i32(pc);
+      if (!context_.should_exit_loop()) {
+        context_.increment_iteration();
+        pc += displacement;
+      }
+      break;
+    }
+
+    case opcode_e::LOOP_LEAVE: {
+      auto result = context_.get_loop_return_value();
+      context_.pop_loop_context();
+      stack_.push_back(std::move(result));
+      break;
+    }
+
+    case opcode_e::LOOP_DONE:
+      if (!context_.is_in_loop()) {
+        throw std::runtime_error("done called outside of do loop");
+      }
+      context_.signal_loop_done(stack_.back());
+      stack_.back() = slp::slp_object_c();
+      break;
+
+    case opcode_e::MAKE_LAMBDA: {
+      std::uint32_t form = read_u32(pc);
+      std::uint32_t body = read_u32(pc);
+      stack_.push_back(make_lambda(form, body));
+      break;
+    }
+
+    case opcode_e::CALL: {
+      std::uint32_t form = read_u32(pc);
+      std::uint32_t first_arg = read_u32(pc);
+      std::uint32_t argc = read_u32(pc);
+      stack_.push_back(call(form, first_arg, argc));
+      break;
+    }
+
+    case opcode_e::CALL_BUILTIN: {
+      std::uint32_t name = read_u32(pc);
+      std::uint32_t form = read_u32(pc);
+      stack_.push_back(call_builtin(name, form));
+      break;
+    }
+
+    case opcode_e::EVAL: {
+      auto form = constants_[read_u32(pc)].share();
+      stack_.push_back(context_.eval(form));
+      break;
+    }
+
+    case opcode_e::RETURN: {
+      auto result = std::move(stack_.back());
+      stack_.resize(base);
+      return result;
+    }
+    }
+  }
+}
+
+/*
+    Same resolution order as the interpreter: kernel functions, then a
+    symbol bound to a lambda. Lambdas this vm compiled run their bytecode
+    body; anything else is handed to the context with the original form.
+*/
+slp::slp_object_c vm_c::call(std::uint32_t form, std::uint32_t first_arg,
+                             std::uint32_t argc) {
+  call_site_s &site = call_sites_[form];
+
+  if (!site.kernel && !site.no_kernel) {
+    if (site.name.empty()) {
+      site.name = constants_[form].as_list().at(0).as_symbol();
+    }
+    if (auto *kernel_context = context_.get_kernel_context()) {
+      site.kernel = kernel_context->get_function(site.name);
+    }
+    // The set of kernel functions is final once kernels are locked
+    site.no_kernel = !site.kernel && kernels_locked_;
+  }
+
+  if (site.kernel) {
+    auto args = constants_[form].share();
+    return site.kernel->function(context_, args);
+  }
+
+  auto head = constants_[form].as_list().at(0);
+  auto target = context_.eval(head);
+  if (target.type() == slp::slp_type_e::ABERRANT) {
+    std::uint64_t handle = target.as_handle();
+    auto it = lambdas_.find(handle);
+    if (it != lambdas_.end() && context_.has_lambda(handle)) {
+      return call_lambda(*it->second, first_arg, argc);
+    }
+  }
+
+  auto args = constants_[form].share();
+  return context_.eval(args);
+}
+
+slp::slp_object_c vm_c::call_lambda(const lambda_s &lambda,
+                                    std::uint32_t first_arg,
+                                    std::uint32_t argc) {
+  if (argc != lambda.parameters.size()) {
+    throw std::runtime_error(
+        fmt::format("Function expects {} arguments, got {}",
+                    lambda.parameters.size(), argc));
+  }
+
+  const size_t args_base = stack_.size();
+  for (std::uint32_t i = 0; i < argc; i++) {
+    auto value = execute(first_arg + i);
+
+    const auto &param = lambda.parameters[i];
+    if (param.type != slp::slp_type_e::NONE && value.type() != param.type) {
+      throw std::runtime_error(fmt::format(
+          "Argument {} type mismatch: expected {}, got {}", i + 1,
+          static_cast<int>(param.type), static_cast<int>(value.type())));
+    }
+
+    stack_.push_back(std::move(value));
+  }
+
+  context_.push_scope();
+  for (std::uint32_t i = 0; i < argc; i++) {
+    context_.define_symbol_id(lambda.names[i], stack_[args_base + i]);
+  }
+  stack_.resize(args_base);
+
+  auto result = execute(lambda.function);
+
+  if (lambda.return_type != slp::slp_type_e::NONE &&
+      result.type() != lambda.return_type) {
+    context_.pop_scope();
+    return slp::constant_error(
+        "internal function error: returned unexpected type");
+  }
+
+  context_.pop_scope();
+  return result;
+}
+
+slp::slp_object_c vm_c::call_builtin(std::uint32_t name, std::uint32_t form) {
+  const callable_symbol_s *builtin = builtins_[name];
+  if (!builtin) {
+    auto it = callable_symbols_.find(names_[name]);
+    if (it == callable_symbols_.end()) {
+      throw std::runtime_error(
+          fmt::format("Unknown callable symbol: {}", names_[name]));
+    }
+    builtin = builtins_[name] = &it->second;
+  }
+
+  auto args = constants_[form].share();
+  return builtin->function(context_, args);
+}
+
+slp::slp_object_c vm_c::make_lambda(std::uint32_t form,
+                                    std::uint32_t function) {
+  lambda_s &lambda = lambda_sites_[form];
+  if (!lambda.resolved) {
+    lambda.function = function;
+    resolve_lambda(lambda, form);
+  }
+
+  std::uint64_t id = context_.allocate_lambda_id();
+  context_.register_lambda(id, lambda.parameters, lambda.return_type,
+                           constants_[form].as_list().at(3));
+
+  // Ids are never reused, so entries for lambdas the context has released
+  // are only dead weight; drop them whenever the table doubles.
+  if (lambdas_.size() >= next_lambda_sweep_) {
+    for (auto it = lambdas_.begin(); it != lambdas_.end();) {
+      it = context_.has_lambda(it->first) ? std::next(it) : lambdas_.erase(it);
+    }
+    next_lambda_sweep_ = std::max<size_t>(1024, lambdas_.size() * 2);
+  }
+  lambdas_[id] = &lambda;
+
+  return slp::slp_object_c::create_aberrant(id);
+}
+
+// Mirrors interpret_fn; done once per fn site since type symbols never change
+// meaning once defined
+void vm_c::resolve_lambda(lambda_s &lambda, std::uint32_t form) {
+  auto list = constants_[form].as_list();
+  lambda.names.clear();
+  lambda.parameters.clear();
+
+  std::string return_type_sym = list.at(2).as_symbol();
+  if (!context_.is_symbol_enscribing_valid_type(return_type_sym,
+                                                lambda.return_type)) {
+    throw std::runtime_error(
+        fmt::format("fn: invalid return type: {}", return_type_sym));
+  }
+
+  auto params = list.at(1);
+  auto params_list = params.as_list();
+  for (size_t i = 0; i < params_list.size(); i += 2) {
+    if (i + 1 >= params_list.size()) {
+      throw std::runtime_error("fn: parameters must be in pairs (name :type)");
+    }
+
+    auto param_name_obj = params_list.at(i);
+    auto param_type_obj = params_list.at(i + 1);
+
+    if (param_name_obj.type() != slp::slp_type_e::SYMBOL) {
+      throw std::runtime_error("fn: parameter name must be a symbol");
+    }
+    if (param_type_obj.type() != slp::slp_type_e::SYMBOL) {
+      throw std::runtime_error("fn: parameter type must be a type symbol");
+    }
+
+    std::string param_type_sym = param_type_obj.as_symbol();
+    slp::slp_type_e param_type;
+    if (!context_.is_symbol_enscribing_valid_type(param_type_sym,
+                                                  param_type)) {
+      throw std::runtime_error(
+          fmt::format("fn: invalid parameter type: {}", param_type_sym));
+    }
+
+    lambda.names.push_back(param_name_obj.as_symbol_id());
+    lambda.parameters.push_back({param_name_obj.as_symbol(), param_type});
+  }
+
+  lambda.resolved = true;
+}
+
+} // namespace pkg::core::vm
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "bytecode.hpp"
+#include "core/interpreter.hpp"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pkg::core::vm {
+
+/*
+    Runs an image against a runtime context. Bindings, scopes, loops and
+    lambda registration all go through the context, so compiled and
+    interpreted code share one environment and can call each other; the
+    vm only replaces walking the program tree.
+
+    Lambdas created by MAKE_LAMBDA are remembered so that calls made from
+    bytecode run their compiled bodies directly.
+*/
+class vm_c {
+public:
+  vm_c(callable_context_if &context, image_s image,
+       const std::map<std::string, callable_symbol_s> &callable_symbols);
+
+  vm_c(const vm_c &) = delete;
+  vm_c &operator=(const vm_c &) = delete;
+
+  slp::slp_object_c run();
+
+private:
+  struct lambda_s {
+    bool resolved{false};
+    std::vector<std::uint64_t> names;
+    std::vector<callable_parameter_s> parameters;
+    slp::slp_type_e return_type{slp::slp_type_e::NONE};
+    std::uint32_t function{0};
+  };
+
+  struct call_site_s {
+    std::string name;
+    callable_symbol_s *kernel{nullptr};
+    bool no_kernel{false};
+  };
+
+  callable_context_if &context_;
+  image_s image_;
+  std::map<std::string, callable_symbol_s> callable_symbols_;
+
+  // Indexed by constant
+  std::vector<slp::slp_object_c> constants_;
+  std::vector<std::string> names_;
+  std::vector<const callable_symbol_s *> builtins_;
+  std::vector<call_site_s> call_sites_;
+
+  std::unordered_map<std::uint32_t, lambda_s> lambda_sites_;
+  std::unordered_map<std::uint64_t, const lambda_s *> lambdas_;
+  size_t next_lambda_sweep_{1024};
+
+  std::vector<slp::slp_object_c> stack_;
+  bool kernels_locked_{false};
+
+  void verify() const;
+
+  slp::slp_object_c execute(std::uint32_t function);
+  slp::slp_object_c call(std::uint32_t form, std::uint32_t first_arg,
+                         std::uint32_t argc);
+  slp::slp_object_c call_lambda(const lambda_s &lambda,
+                                std::uint32_t first_arg, std::uint32_t argc);
+  slp::slp_object_c call_builtin(std::uint32_t name, std::uint32_t form);
+  slp::slp_object_c make_lambda(std::uint32_t form, std::uint32_t function);
+  void resolve_lambda(lambda_s &lambda, std::uint32_t form);
+};
+
+} // namespace pkg::core::vm
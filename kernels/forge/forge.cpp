@@ -15,8 +15,7 @@ static bool is_list_type(slp::slp_type_e type) {
 static slp::slp_object_c upcast_to_list(pkg::kernel::context_t ctx,
                                         const slp::slp_object_c &obj) {
   if (is_list_type(obj.type())) {
-    return slp::slp_object_c::from_data(obj.get_data(), obj.get_symbols(),
-                                        obj.get_root_offset());
+    return obj.share();
   }
 
   std::vector<slp::slp_object_c> single;
@@ -25,6 +24,15 @@ static slp::slp_object_c upcast_to_list(pkg::kernel::context_t ctx,
   return slp::slp_object_c::create_paren_list(single.data(), 1);
 }
 
+// Lists are edited through slp_object_c, which writes in place when the
+// evaluated target is not viewed by anything else and copies once otherwise.
+// Strings and upcast scalars still go through create_list_of_type.
+static bool is_editable_list(const slp::slp_object_c &obj) {
+  return obj.type() == slp::slp_type_e::PAREN_LIST ||
+         obj.type() == slp::slp_type_e::BRACKET_LIST ||
+         obj.type() == slp::slp_type_e::BRACE_LIST;
+}
+
 static slp::slp_object_c
 create_list_of_type(slp::slp_type_e type,
                     const std::vector<slp::slp_object_c> &items) {
@@ -53,28 +61,6 @@ create_list_of_type(slp::slp_type_e type,
   }
 }
 
-static bool objects_equal(const slp::slp_object_c &a,
-                          const slp::slp_object_c &b) {
-  if (a.type() != b.type()) {
-    return false;
-  }
-
-  switch (a.type()) {
-  case slp::slp_type_e::INTEGER:
-    return a.as_int() == b.as_int();
-  case slp::slp_type_e::REAL:
-    return a.as_real() == b.as_real();
-  case slp::slp_type_e::SYMBOL:
-    return std::strcmp(a.as_symbol(), b.as_symbol()) == 0;
-  case slp::slp_type_e::DQ_LIST:
-    return a.as_string().to_string() == b.as_string().to_string();
-  case slp::slp_type_e::NONE:
-    return true;
-  default:
-    return false;
-  }
-}
-
 static slp::slp_object_c forge_resize(pkg::kernel::context_t ctx,
                                       const slp::slp_object_c &args) {
   auto list = args.as_list();
@@ -95,6 +81,18 @@ static slp::slp_object_c forge_resize(pkg::kernel::context_t ctx,
     new_size = 0;
   }
 
+  if (is_editable_list(target)) {
+    size_t size = target.as_list().size();
+    size_t wanted = static_cast<size_t>(new_size);
+    if (wanted < size) {
+      target.splice(wanted, size - wanted, nullptr, 0);
+    }
+    for (size_t i = size; i < wanted; i++) {
+      target.append(default_val);
+    }
+    return target;
+  }
+
   auto upcast = upcast_to_list(ctx, target);
   auto orig_list = upcast.as_list();
   slp::slp_type_e orig_type = target.type();
@@ -105,13 +103,9 @@ static slp::slp_object_c forge_resize(pkg::kernel::context_t ctx,
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < static_cast<size_t>(new_size); i++) {
     if (i < orig_list.size()) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     } else {
-      items.push_back(slp::slp_object_c::from_data(
-          default_val.get_data(), default_val.get_symbols(),
-          default_val.get_root_offset()));
+      items.push_back(default_val.share());
     }
   }
 
@@ -128,6 +122,11 @@ static slp::slp_object_c forge_pf(pkg::kernel::context_t ctx,
   auto target = g_api->eval(ctx, list.at(1));
   auto obj = g_api->eval(ctx, list.at(2));
 
+  if (is_editable_list(target)) {
+    target.splice(0, 0, &obj, 1);
+    return target;
+  }
+
   auto upcast = upcast_to_list(ctx, target);
   auto orig_list = upcast.as_list();
   slp::slp_type_e orig_type = target.type();
@@ -138,9 +137,7 @@ static slp::slp_object_c forge_pf(pkg::kernel::context_t ctx,
   std::vector<slp::slp_object_c> items;
   items.push_back(std::move(obj));
   for (size_t i = 0; i < orig_list.size(); i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-        orig_list.at(i).get_root_offset()));
+    items.push_back(orig_list.at(i).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -156,6 +153,11 @@ static slp::slp_object_c forge_pb(pkg::kernel::context_t ctx,
   auto target = g_api->eval(ctx, list.at(1));
   auto obj = g_api->eval(ctx, list.at(2));
 
+  if (is_editable_list(target)) {
+    target.append(obj);
+    return target;
+  }
+
   auto upcast = upcast_to_list(ctx, target);
   auto orig_list = upcast.as_list();
   slp::slp_type_e orig_type = target.type();
@@ -165,9 +167,7 @@ static slp::slp_object_c forge_pb(pkg::kernel::context_t ctx,
 
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < orig_list.size(); i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-        orig_list.at(i).get_root_offset()));
+    items.push_back(orig_list.at(i).share());
   }
   items.push_back(std::move(obj));
 
@@ -182,6 +182,13 @@ static slp::slp_object_c forge_rf(pkg::kernel::context_t ctx,
   }
 
   auto target = g_api->eval(ctx, list.at(1));
+  if (is_editable_list(target)) {
+    if (!target.as_list().empty()) {
+      target.remove(0);
+    }
+    return target;
+  }
+
   auto upcast = upcast_to_list(ctx, target);
   auto orig_list = upcast.as_list();
   slp::slp_type_e orig_type = target.type();
@@ -196,9 +203,7 @@ static slp::slp_object_c forge_rf(pkg::kernel::context_t ctx,
 
   std::vector<slp::slp_object_c> items;
   for (size_t i = 1; i < orig_list.size(); i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-        orig_list.at(i).get_root_offset()));
+    items.push_back(orig_list.at(i).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -212,6 +217,13 @@ static slp::slp_object_c forge_rb(pkg::kernel::context_t ctx,
   }
 
   auto target = g_api->eval(ctx, list.at(1));
+  if (is_editable_list(target)) {
+    if (!target.as_list().empty()) {
+      target.remove(target.as_list().size() - 1);
+    }
+    return target;
+  }
+
   auto upcast = upcast_to_list(ctx, target);
   auto orig_list = upcast.as_list();
   slp::slp_type_e orig_type = target.type();
@@ -226,9 +238,7 @@ static slp::slp_object_c forge_rb(pkg::kernel::context_t ctx,
 
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < orig_list.size() - 1; i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-        orig_list.at(i).get_root_offset()));
+    items.push_back(orig_list.at(i).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -269,18 +279,14 @@ static slp::slp_object_c forge_lsh(pkg::kernel::context_t ctx,
   if (actual_shift == 0) {
     std::vector<slp::slp_object_c> items;
     for (size_t i = 0; i < orig_list.size(); i++) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
     return create_list_of_type(orig_type, items);
   }
 
   std::vector<slp::slp_object_c> items;
   for (size_t i = actual_shift; i < orig_list.size(); i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-        orig_list.at(i).get_root_offset()));
+    items.push_back(orig_list.at(i).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -321,9 +327,7 @@ static slp::slp_object_c forge_rsh(pkg::kernel::context_t ctx,
   if (actual_shift == 0) {
     std::vector<slp::slp_object_c> items;
     for (size_t i = 0; i < orig_list.size(); i++) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
     return create_list_of_type(orig_type, items);
   }
@@ -331,9 +335,7 @@ static slp::slp_object_c forge_rsh(pkg::kernel::context_t ctx,
   size_t new_size = orig_list.size() - actual_shift;
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < new_size; i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-        orig_list.at(i).get_root_offset()));
+    items.push_back(orig_list.at(i).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -368,9 +370,7 @@ static slp::slp_object_c forge_rotr(pkg::kernel::context_t ctx,
   if (orig_list.empty() || orig_list.size() == 1) {
     std::vector<slp::slp_object_c> items;
     for (size_t i = 0; i < orig_list.size(); i++) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
     return create_list_of_type(orig_type, items);
   }
@@ -379,9 +379,7 @@ static slp::slp_object_c forge_rotr(pkg::kernel::context_t ctx,
   if (actual_rotations == 0) {
     std::vector<slp::slp_object_c> items;
     for (size_t i = 0; i < orig_list.size(); i++) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
     return create_list_of_type(orig_type, items);
   }
@@ -390,9 +388,7 @@ static slp::slp_object_c forge_rotr(pkg::kernel::context_t ctx,
   size_t start_pos = orig_list.size() - actual_rotations;
   for (size_t i = 0; i < orig_list.size(); i++) {
     size_t idx = (start_pos + i) % orig_list.size();
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(idx).get_data(), orig_list.at(idx).get_symbols(),
-        orig_list.at(idx).get_root_offset()));
+    items.push_back(orig_list.at(idx).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -427,9 +423,7 @@ static slp::slp_object_c forge_rotl(pkg::kernel::context_t ctx,
   if (orig_list.empty() || orig_list.size() == 1) {
     std::vector<slp::slp_object_c> items;
     for (size_t i = 0; i < orig_list.size(); i++) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
     return create_list_of_type(orig_type, items);
   }
@@ -438,9 +432,7 @@ static slp::slp_object_c forge_rotl(pkg::kernel::context_t ctx,
   if (actual_rotations == 0) {
     std::vector<slp::slp_object_c> items;
     for (size_t i = 0; i < orig_list.size(); i++) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
     return create_list_of_type(orig_type, items);
   }
@@ -448,9 +440,7 @@ static slp::slp_object_c forge_rotl(pkg::kernel::context_t ctx,
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < orig_list.size(); i++) {
     size_t idx = (actual_rotations + i) % orig_list.size();
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(idx).get_data(), orig_list.at(idx).get_symbols(),
-        orig_list.at(idx).get_root_offset()));
+    items.push_back(orig_list.at(idx).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -473,9 +463,7 @@ static slp::slp_object_c forge_rev(pkg::kernel::context_t ctx,
 
   std::vector<slp::slp_object_c> items;
   for (size_t i = orig_list.size(); i > 0; i--) {
-    items.push_back(slp::slp_object_c::from_data(
-        orig_list.at(i - 1).get_data(), orig_list.at(i - 1).get_symbols(),
-        orig_list.at(i - 1).get_root_offset()));
+    items.push_back(orig_list.at(i - 1).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -524,14 +512,10 @@ static slp::slp_object_c forge_concat(pkg::kernel::context_t ctx,
 
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < list1.size(); i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        list1.at(i).get_data(), list1.at(i).get_symbols(),
-        list1.at(i).get_root_offset()));
+    items.push_back(list1.at(i).share());
   }
   for (size_t i = 0; i < list2.size(); i++) {
-    items.push_back(slp::slp_object_c::from_data(
-        list2.at(i).get_data(), list2.at(i).get_symbols(),
-        list2.at(i).get_root_offset()));
+    items.push_back(list2.at(i).share());
   }
 
   return create_list_of_type(orig_type, items);
@@ -548,6 +532,15 @@ static slp::slp_object_c forge_replace(pkg::kernel::context_t ctx,
   auto match = g_api->eval(ctx, list.at(2));
   auto replacement = g_api->eval(ctx, list.at(3));
 
+  if (is_editable_list(target)) {
+    for (size_t i = 0; i < target.as_list().size(); i++) {
+      if (target.as_list().at(i).equals(match)) {
+        target.set(i, replacement);
+      }
+    }
+    return target;
+  }
+
   auto upcast = upcast_to_list(ctx, target);
   auto orig_list = upcast.as_list();
   slp::slp_type_e orig_type = target.type();
@@ -558,13 +551,10 @@ static slp::slp_object_c forge_replace(pkg::kernel::context_t ctx,
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < orig_list.size(); i++) {
     auto item = orig_list.at(i);
-    if (objects_equal(item, match)) {
-      items.push_back(slp::slp_object_c::from_data(
-          replacement.get_data(), replacement.get_symbols(),
-          replacement.get_root_offset()));
+    if (item.equals(match)) {
+      items.push_back(replacement.share());
     } else {
-      items.push_back(slp::slp_object_c::from_data(
-          item.get_data(), item.get_symbols(), item.get_root_offset()));
+      items.push_back(item.share());
     }
   }
 
@@ -591,7 +581,7 @@ static slp::slp_object_c forge_drop_match(pkg::kernel::context_t ctx,
   std::vector<slp::slp_object_c> items;
   for (size_t i = 0; i < orig_list.size(); i++) {
     auto item = g_api->eval(ctx, orig_list.at(i));
-    if (!objects_equal(item, match)) {
+    if (!item.equals(match)) {
       items.push_back(std::move(item));
     }
   }
@@ -633,9 +623,7 @@ static slp::slp_object_c forge_drop_period(pkg::kernel::context_t ctx,
   for (size_t i = 0; i < orig_list.size(); i++) {
     long long idx = static_cast<long long>(i);
     if (idx < start || (idx - start) % period != 0) {
-      items.push_back(slp::slp_object_c::from_data(
-          orig_list.at(i).get_data(), orig_list.at(i).get_symbols(),
-          orig_list.at(i).get_root_offset()));
+      items.push_back(orig_list.at(i).share());
     }
   }
 
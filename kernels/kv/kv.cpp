@@ -3,14 +3,14 @@
 #include <kernel_api.hpp>
 #include <map>
 #include <memory>
+#include <slp/constants.hpp>
+#include <slp/image.hpp>
 #include <string>
 
 static const struct pkg::kernel::api_table_s *g_api = nullptr;
 
 static slp::slp_object_c create_error(const std::string &message) {
-  std::string error_str = "@(" + message + ")";
-  auto parse_result = slp::parse(error_str);
-  return parse_result.take();
+  return slp::constant_error(message);
 }
 
 static std::map<std::string, std::shared_ptr<kvds::kv_c_distributor_c>>
@@ -29,33 +29,19 @@ parse_symbol_key(const char *symbol_str) {
   return {s.substr(0, colon_pos), s.substr(colon_pos + 1)};
 }
 
-static std::string serialize_slp_object(const slp::slp_object_c &obj) {
-  const auto &buffer = obj.get_data();
-  const auto &symbols = obj.get_symbols();
-  size_t root_offset = obj.get_root_offset();
-
-  std::string result;
-
-  size_t buffer_size = buffer.size();
-  result.append(reinterpret_cast<const char *>(&buffer_size), sizeof(size_t));
-  result.append(reinterpret_cast<const char *>(buffer.data()), buffer_size);
-
-  size_t symbols_count = symbols.size();
-  result.append(reinterpret_cast<const char *>(&symbols_count), sizeof(size_t));
-
-  for (const auto &[key, value] : symbols) {
-    result.append(reinterpret_cast<const char *>(&key), sizeof(uint64_t));
-    size_t value_len = value.size();
-    result.append(reinterpret_cast<const char *>(&value_len), sizeof(size_t));
-    result.append(value);
-  }
-
-  result.append(reinterpret_cast<const char *>(&root_offset), sizeof(size_t));
-
-  return result;
+/*
+    Values are stored as slp images (slp/image.hpp), which hold only the
+    value's own units and symbols. Values written before images were used
+    hold the raw store in the old 16 byte unit layout, its symbol map and
+    root offset; they are still read.
+*/
+static std::string serialize_slp_object(const slp::slp_object_c &value) {
+  auto image = slp::write_image(value);
+  return std::string(image.begin(), image.end());
 }
 
-static slp::slp_object_c deserialize_slp_object(const std::string &serialized) {
+static slp::slp_object_c
+deserialize_legacy_slp_object(const std::string &serialized) {
   const char *data = serialized.data();
   size_t pos = 0;
 
@@ -115,7 +101,25 @@ static slp::slp_object_c deserialize_slp_object(const std::string &serialized) {
   size_t root_offset;
   std::memcpy(&root_offset, data + pos, sizeof(size_t));
 
-  return slp::slp_object_c::from_data(buffer, symbols, root_offset);
+  slp::slp_object_c value;
+  std::string error;
+  if (!slp::read_legacy_units(buffer, root_offset, symbols, value, error)) {
+    return create_error("deserialize: " + error);
+  }
+  return value;
+}
+
+static slp::slp_object_c deserialize_slp_object(const std::string &serialized) {
+  if (!slp::is_image(serialized)) {
+    return deserialize_legacy_slp_object(serialized);
+  }
+
+  slp::slp_object_c value;
+  std::string error;
+  if (!slp::read_image(serialized, value, error)) {
+    return create_error("deserialize: " + error);
+  }
+  return value;
 }
 
 static slp::slp_object_c kv_open_memory(pkg::kernel::context_t ctx,
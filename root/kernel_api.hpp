@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 #if defined(SXS_KERNEL_BUILD)
 #include <slp/slp.hpp>
@@ -28,6 +29,13 @@ using register_fn_t = void (*)(registry_t registry, const char *name,
 using eval_fn_t = slp::slp_object_c (*)(context_t ctx,
                                         const slp::slp_object_c &obj);
 
+// Calls the lambda a handle (aberrant) object names with count arguments that
+// are already values
+using call_lambda_fn_t = slp::slp_object_c (*)(context_t ctx,
+                                               std::uint64_t lambda_id,
+                                               const slp::slp_object_c *args,
+                                               std::size_t count);
+
 using get_system_info_fn_t = const system_info_s *(*)(system_t sys);
 
 struct api_table_s {
@@ -35,6 +43,7 @@ struct api_table_s {
   eval_fn_t eval;
   get_system_info_fn_t get_system_info;
   system_t system;
+  call_lambda_fn_t call_lambda;
 };
 
 } // namespace pkg::kernel
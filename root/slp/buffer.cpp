@@ -4,12 +4,13 @@
 
 namespace slp {
 
-slp_buffer_c::slp_buffer_c() : data_(nullptr), size_(0), capacity_(0) {}
+slp_buffer_c::slp_buffer_c()
+    : data_(inline_), size_(0), capacity_(inline_capacity) {}
 
 slp_buffer_c::~slp_buffer_c() { free_data(); }
 
 slp_buffer_c::slp_buffer_c(const slp_buffer_c &other)
-    : data_(nullptr), size_(0), capacity_(0) {
+    : data_(inline_), size_(0), capacity_(inline_capacity) {
   if (other.size_ > 0) {
     reserve(other.size_);
     std::memcpy(data_, other.data_, other.size_);
@@ -32,10 +33,16 @@ slp_buffer_c &slp_buffer_c::operator=(const slp_buffer_c &other) {
 }
 
 slp_buffer_c::slp_buffer_c(slp_buffer_c &&other) noexcept
-    : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
-  other.data_ = nullptr;
+    : data_(other.data_), size_(other.size_), capacity_(other.capacity_),
+      borrowed_(other.borrowed_) {
+  if (other.is_inline()) {
+    data_ = inline_;
+    std::memcpy(inline_, other.inline_, other.size_);
+  }
+  other.data_ = other.inline_;
   other.size_ = 0;
-  other.capacity_ = 0;
+  other.capacity_ = inline_capacity;
+  other.borrowed_ = false;
 }
 
 slp_buffer_c &slp_buffer_c::operator=(slp_buffer_c &&other) noexcept {
@@ -44,13 +51,31 @@ slp_buffer_c &slp_buffer_c::operator=(slp_buffer_c &&other) noexcept {
     data_ = other.data_;
     size_ = other.size_;
     capacity_ = other.capacity_;
-    other.data_ = nullptr;
+    borrowed_ = other.borrowed_;
+    if (other.is_inline()) {
+      data_ = inline_;
+      std::memcpy(inline_, other.inline_, other.size_);
+    }
+    other.data_ = other.inline_;
     other.size_ = 0;
-    other.capacity_ = 0;
+    other.capacity_ = inline_capacity;
+    other.borrowed_ = false;
   }
   return *this;
 }
 
+slp_buffer_c slp_buffer_c::borrow(const std::uint8_t *data, std::size_t size) {
+  slp_buffer_c buffer;
+  // capacity_ 0 sends the first write of any size through grow_to
+  buffer.data_ = const_cast<std::uint8_t *>(data);
+  buffer.size_ = size;
+  buffer.capacity_ = 0;
+  buffer.borrowed_ = true;
+  return buffer;
+}
+
+bool slp_buffer_c::borrowed() const { return borrowed_; }
+
 std::uint8_t *slp_buffer_c::data() { return data_; }
 
 const std::uint8_t *slp_buffer_c::data() const { return data_; }
@@ -65,7 +90,7 @@ void slp_buffer_c::resize(std::size_t new_size) {
   if (new_size > capacity_) {
     grow_to(new_size);
   }
-  if (new_size > size_ && data_ != nullptr) {
+  if (new_size > size_) {
     std::memset(data_ + size_, 0, new_size - size_);
   }
   size_ = new_size;
@@ -121,19 +146,22 @@ void slp_buffer_c::insert(std::size_t pos, const std::uint8_t *data,
 }
 
 void slp_buffer_c::grow_to(std::size_t min_capacity) {
-  std::size_t new_capacity = capacity_;
-
-  if (new_capacity == 0) {
-    new_capacity = 16;
-  }
-
+  // Doubling from at least the inline size; see slp_buffer_c
+  std::size_t new_capacity = std::max(capacity_, inline_capacity);
   while (new_capacity < min_capacity) {
     new_capacity *= 2;
   }
+  // A borrowed buffer has no capacity but may already hold more than asked
+  new_capacity = std::max(new_capacity, size_);
+
+  std::uint8_t *new_data = inline_;
+  if (new_capacity > inline_capacity) {
+    new_data = new std::uint8_t[new_capacity];
+  } else {
+    new_capacity = inline_capacity;
+  }
 
-  std::uint8_t *new_data = new std::uint8_t[new_capacity];
-
-  if (data_ != nullptr && size_ > 0) {
+  if (size_ > 0 && new_data != data_) {
     std::memcpy(new_data, data_, size_);
   }
 
@@ -143,11 +171,12 @@ void slp_buffer_c::grow_to(std::size_t min_capacity) {
 }
 
 void slp_buffer_c::free_data() {
-  if (data_ != nullptr) {
+  if (!is_inline() && !borrowed_) {
     delete[] data_;
-    data_ = nullptr;
   }
-  capacity_ = 0;
+  data_ = inline_;
+  borrowed_ = false;
+  capacity_ = inline_capacity;
 }
 
 } // namespace slp
@@ -5,8 +5,20 @@
 
 namespace slp {
 
+/*
+    Byte buffer behind every store. Up to inline_capacity bytes live inside
+    the buffer itself, which holds any scalar (one unit and its 8 byte wide
+    slot), so objects that small never allocate. Past that the bytes move
+    to the heap, and whenever the buffer has to grow its capacity at least
+    doubles: n bytes appended one at a time copy fewer than 2n bytes in
+    all. Moving a buffer that is still inline copies its bytes, so pointers
+    into it are only stable while it stays where it is (a store never
+    moves).
+*/
 class slp_buffer_c {
 public:
+  static constexpr std::size_t inline_capacity = 16;
+
   slp_buffer_c();
   ~slp_buffer_c();
 
@@ -16,6 +28,12 @@ public:
   slp_buffer_c(slp_buffer_c &&other) noexcept;
   slp_buffer_c &operator=(slp_buffer_c &&other) noexcept;
 
+  // Views memory owned elsewhere (a mapped image) without copying it. The
+  // buffer never frees it, and anything that grows the buffer moves it into
+  // memory of its own first.
+  static slp_buffer_c borrow(const std::uint8_t *data, std::size_t size);
+  bool borrowed() const;
+
   std::uint8_t *data();
   const std::uint8_t *data() const;
 
@@ -23,6 +41,7 @@ public:
   std::size_t capacity() const;
   bool empty() const;
 
+  // New bytes are zeroed; insert() at size() appends without that
   void resize(std::size_t new_size);
   void reserve(std::size_t new_capacity);
   void clear();
@@ -39,6 +58,10 @@ private:
   std::uint8_t *data_;
   std::size_t size_;
   std::size_t capacity_;
+  bool borrowed_{false};
+  alignas(8) std::uint8_t inline_[inline_capacity];
+
+  bool is_inline() const { return data_ == inline_; }
 
   void grow_to(std::size_t min_capacity);
   void free_data();
@@ -0,0 +1,375 @@
+#include "slp/builder.hpp"
+#include "slp/symbols.hpp"
+#include "slp/walk.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace slp {
+
+namespace {
+
+/*
+    Stores come and go at the rate scalars are made (every create_int), and
+    a scalar's bytes sit inside its buffer, so the store and its shared_ptr
+    control block are the only allocation it has. Freed blocks are kept per
+    thread for the next store instead of going back to the heap. A block
+    freed on another thread simply joins that thread's cache.
+*/
+template <size_t Size> struct block_cache_s {
+  static constexpr size_t limit = 64;
+  void *blocks[limit];
+  size_t count;
+  bool closed;
+};
+
+template <size_t Size> block_cache_s<Size> &block_cache() {
+  // Trivially destructible, so it stays usable while the thread's other
+  // thread_locals (which may hold objects) are torn down
+  thread_local block_cache_s<Size> cache{};
+  return cache;
+}
+
+template <size_t Size> struct block_cache_reaper_s {
+  ~block_cache_reaper_s() {
+    auto &cache = block_cache<Size>();
+    for (size_t i = 0; i < cache.count; i++) {
+      ::operator delete(cache.blocks[i]);
+    }
+    cache.count = 0;
+    cache.closed = true;
+  }
+};
+
+template <typename T> struct store_allocator_s {
+  using value_type = T;
+
+  store_allocator_s() = default;
+  template <typename U> store_allocator_s(const store_allocator_s<U> &) {}
+
+  T *allocate(size_t n) {
+    auto &cache = block_cache<sizeof(T)>();
+    if (n == 1 && cache.count > 0) {
+      return static_cast<T *>(cache.blocks[--cache.count]);
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *block, size_t n) {
+    auto &cache = block_cache<sizeof(T)>();
+    if (n == 1 && !cache.closed && cache.count < cache.limit) {
+      thread_local block_cache_reaper_s<sizeof(T)> reaper;
+      (void)reaper;
+      cache.blocks[cache.count++] = block;
+      return;
+    }
+    ::operator delete(block);
+  }
+
+  template <typename U> bool operator==(const store_allocator_s<U> &) const {
+    return true;
+  }
+};
+
+} // namespace
+
+slp_builder_c::slp_builder_c() : hash_consing_(false) {}
+
+slp_builder_c::slp_builder_c(slp_buffer_c &&data)
+    : data_(std::move(data)), hash_consing_(false) {}
+
+void slp_builder_c::reserve(size_t bytes) { data_.reserve(bytes); }
+
+size_t slp_builder_c::size() const { return data_.size(); }
+
+void slp_builder_c::set_hash_consing(bool enabled) {
+  hash_consing_ = enabled;
+  if (!enabled) {
+    runs_.clear();
+  }
+}
+
+std::uint32_t slp_builder_c::word(size_t offset) const {
+  return static_cast<std::uint32_t>(offset / sizeof(slp_unit_of_store_t));
+}
+
+// Called with the run just written, from offset to the end. Returns where
+// the unit should point: an earlier copy of the same bytes when there is one
+// (the new run is dropped), the run itself otherwise.
+size_t slp_builder_c::settle(size_t offset) {
+  if (!hash_consing_) {
+    return offset;
+  }
+  size_t length = data_.size() - offset;
+  std::uint64_t key = hash_bytes(0, &data_[offset], length);
+  auto [first, last] = runs_.equal_range(key);
+  for (auto it = first; it != last; ++it) {
+    if (it->second + length <= offset &&
+        std::memcmp(&data_[it->second], &data_[offset], length) == 0) {
+      data_.resize(offset);
+      return it->second;
+    }
+  }
+  runs_.emplace(key, offset);
+  return offset;
+}
+
+size_t slp_builder_c::place(const slp_unit_of_store_t &unit) {
+  size_t offset = data_.size();
+  data_.insert(offset, reinterpret_cast<const std::uint8_t *>(&unit),
+               sizeof(unit));
+  return offset;
+}
+
+slp_unit_of_store_t slp_builder_c::wide_unit(slp_type_e type,
+                                             std::uint32_t field,
+                                             std::uint64_t bits) {
+  size_t offset = data_.size();
+  data_.insert(offset, reinterpret_cast<const std::uint8_t *>(&bits),
+               sizeof(bits));
+  return make_unit(type, field | SLP_UNIT_FLAG_WIDE, word(settle(offset)));
+}
+
+// Room for the elements or bytes of a list or string, behind a 64 bit count
+// when the unit's field cannot hold it. Returns the offset the unit points
+// at; padding keeps everything after it 8 byte aligned.
+size_t slp_builder_c::add_extent(size_t count, size_t bytes,
+                                 std::uint32_t &field) {
+  size_t offset = data_.size();
+  size_t header = 0;
+  field = static_cast<std::uint32_t>(count);
+  if (count >= SLP_UNIT_FIELD_LONG) {
+    header = sizeof(std::uint64_t);
+    field = SLP_UNIT_FIELD_LONG;
+  }
+  data_.resize(offset + header + ((bytes + 7) & ~static_cast<size_t>(7)));
+  if (header) {
+    std::uint64_t long_count = count;
+    std::memcpy(&data_[offset], &long_count, sizeof(long_count));
+  }
+  return offset;
+}
+
+slp_unit_of_store_t slp_builder_c::int_unit(std::int64_t value) {
+  if (value >= std::numeric_limits<std::int32_t>::min() &&
+      value <= std::numeric_limits<std::int32_t>::max()) {
+    return make_unit(slp_type_e::INTEGER, 0,
+                     static_cast<std::uint32_t>(static_cast<std::int32_t>(value)));
+  }
+  return wide_unit(slp_type_e::INTEGER, 0, static_cast<std::uint64_t>(value));
+}
+
+slp_unit_of_store_t slp_builder_c::real_unit(double value) {
+  if (std::fabs(value) <= std::numeric_limits<float>::max()) {
+    float narrow = static_cast<float>(value);
+    if (static_cast<double>(narrow) == value) {
+      std::uint32_t bits;
+      std::memcpy(&bits, &narrow, sizeof(bits));
+      return make_unit(slp_type_e::REAL, 0, bits);
+    }
+  }
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return wide_unit(slp_type_e::REAL, 0, bits);
+}
+
+slp_unit_of_store_t slp_builder_c::symbol_unit(std::uint64_t symbol_id) {
+  // The symbol table hands out far fewer than 2^32 ids
+  return make_unit(slp_type_e::SYMBOL, 0,
+                   static_cast<std::uint32_t>(symbol_id));
+}
+
+slp_unit_of_store_t slp_builder_c::string_unit(std::string_view value) {
+  if (value.empty()) {
+    return make_unit(slp_type_e::DQ_LIST, 0, 0);
+  }
+  std::uint32_t field = 0;
+  size_t target = add_extent(value.size(), value.size(), field);
+  size_t start =
+      target + (field == SLP_UNIT_FIELD_LONG ? sizeof(std::uint64_t) : 0);
+  std::memcpy(&data_[start], value.data(), value.size());
+  return make_unit(slp_type_e::DQ_LIST, field, word(settle(target)));
+}
+
+slp_unit_of_store_t
+slp_builder_c::list_unit(slp_type_e type, const slp_unit_of_store_t *elements,
+                         size_t count) {
+  if (count == 0) {
+    return make_unit(type, 0, 0);
+  }
+  std::uint32_t field = 0;
+  size_t target =
+      add_extent(count, count * sizeof(slp_unit_of_store_t), field);
+  size_t start =
+      target + (field == SLP_UNIT_FIELD_LONG ? sizeof(std::uint64_t) : 0);
+  std::memcpy(&data_[start], elements, count * sizeof(slp_unit_of_store_t));
+  return make_unit(type, field, word(settle(target)));
+}
+
+slp_unit_of_store_t
+slp_builder_c::wrapper_unit(slp_type_e type, const slp_unit_of_store_t &inner) {
+  return make_unit(type, 0, word(settle(place(inner))));
+}
+
+slp_unit_of_store_t slp_builder_c::handle_unit(std::uint64_t handle) {
+  if (handle <= std::numeric_limits<std::uint32_t>::max()) {
+    return make_unit(slp_type_e::ABERRANT, SLP_UNIT_FLAG_HANDLE,
+                     static_cast<std::uint32_t>(handle));
+  }
+  return wide_unit(slp_type_e::ABERRANT, SLP_UNIT_FLAG_HANDLE, handle);
+}
+
+slp_unit_of_store_t slp_builder_c::object_unit(const slp_object_c &object) {
+  if (object.type() == slp_type_e::NONE) {
+    return list_unit(slp_type_e::PAREN_LIST, nullptr, 0);
+  }
+  return copy_unit(object.get_data(), *object.view_);
+}
+
+size_t slp_builder_c::add_int(std::int64_t value) {
+  return place(int_unit(value));
+}
+
+size_t slp_builder_c::add_real(double value) {
+  return place(real_unit(value));
+}
+
+size_t slp_builder_c::add_symbol(std::string_view name) {
+  return add_symbol_id(symbol_table().intern(name));
+}
+
+size_t slp_builder_c::add_symbol_id(std::uint64_t symbol_id) {
+  return place(symbol_unit(symbol_id));
+}
+
+size_t slp_builder_c::add_string(std::string_view value) {
+  return place(string_unit(value));
+}
+
+size_t slp_builder_c::add_list(slp_type_e type, const size_t *element_offsets,
+                               size_t count) {
+  if (count == 0) {
+    return place(make_unit(type, 0, 0));
+  }
+  std::uint32_t field = 0;
+  size_t target =
+      add_extent(count, count * sizeof(slp_unit_of_store_t), field);
+  size_t start =
+      target + (field == SLP_UNIT_FIELD_LONG ? sizeof(std::uint64_t) : 0);
+  for (size_t i = 0; i < count; i++) {
+    std::memcpy(&data_[start + i * sizeof(slp_unit_of_store_t)],
+                &data_[element_offsets[i]], sizeof(slp_unit_of_store_t));
+  }
+  return place(make_unit(type, field, word(settle(target))));
+}
+
+size_t slp_builder_c::add_wrapper(slp_type_e type, size_t inner_offset) {
+  return place(make_unit(type, 0, word(inner_offset)));
+}
+
+size_t slp_builder_c::add_handle(std::uint64_t handle) {
+  return place(handle_unit(handle));
+}
+
+size_t slp_builder_c::add_object(const slp_object_c &object) {
+  return place(object_unit(object));
+}
+
+slp_unit_of_store_t slp_builder_c::copy_unit(const slp_buffer_c &source,
+                                             const slp_unit_of_store_t &unit) {
+  slp_type_e type = unit_type(unit);
+  if (!unit_has_target(unit)) {
+    return unit;
+  }
+
+  switch (type) {
+  case slp_type_e::DQ_LIST: {
+    size_t start = 0;
+    size_t length = unit_extent(source, unit, start);
+    return string_unit(std::string_view(
+        reinterpret_cast<const char *>(&source[start]), length));
+  }
+
+  case slp_type_e::PAREN_LIST:
+  case slp_type_e::BRACKET_LIST:
+  case slp_type_e::BRACE_LIST: {
+    size_t source_start = 0;
+    size_t count = unit_extent(source, unit, source_start);
+
+    // Hash consing needs the elements written last to find their twin
+    if (hash_consing_) {
+      std::vector<slp_unit_of_store_t> elements(count);
+      for (size_t i = 0; i < count; i++) {
+        elements[i] = copy_unit(
+            source, *reinterpret_cast<const slp_unit_of_store_t *>(
+                        &source[source_start + i * sizeof(slp_unit_of_store_t)]));
+      }
+      return list_unit(type, elements.data(), count);
+    }
+
+    // Elements are copied straight into their slots; whatever they point at
+    // lands after the slots
+    std::uint32_t field = 0;
+    size_t target =
+        add_extent(count, count * sizeof(slp_unit_of_store_t), field);
+    size_t start =
+        target + (field == SLP_UNIT_FIELD_LONG ? sizeof(std::uint64_t) : 0);
+    for (size_t i = 0; i < count; i++) {
+      const auto &element = *reinterpret_cast<const slp_unit_of_store_t *>(
+          &source[source_start + i * sizeof(slp_unit_of_store_t)]);
+      slp_unit_of_store_t copied = copy_unit(source, element);
+      std::memcpy(&data_[start + i * sizeof(slp_unit_of_store_t)], &copied,
+                  sizeof(copied));
+    }
+    return make_unit(type, field, word(target));
+  }
+
+  case slp_type_e::SOME:
+  case slp_type_e::ERROR:
+  case slp_type_e::DATUM:
+  case slp_type_e::ABERRANT:
+    if (!(unit_field(unit) & SLP_UNIT_FLAG_HANDLE)) {
+      const auto &inner = *reinterpret_cast<const slp_unit_of_store_t *>(
+          &source[unit_target(unit)]);
+      return wrapper_unit(type, copy_unit(source, inner));
+    }
+    [[fallthrough]];
+
+  default:
+    // A wide value
+    return wide_unit(type, unit_field(unit) & ~SLP_UNIT_FLAG_WIDE,
+                     read_word(&source[unit_target(unit)]));
+  }
+}
+
+size_t slp_builder_c::extend(size_t count) {
+  size_t offset = data_.size();
+  data_.resize(offset + count);
+  return offset;
+}
+
+std::uint8_t *slp_builder_c::bytes(size_t offset) { return &data_[offset]; }
+
+const std::uint8_t *slp_builder_c::bytes(size_t offset) const {
+  return &data_[offset];
+}
+
+slp_object_c slp_builder_c::take(size_t root_offset) {
+  auto store =
+      std::allocate_shared<slp_store_s>(store_allocator_s<slp_store_s>());
+  store->data = std::move(data_);
+  runs_.clear();
+
+  return slp_object_c(std::move(store), root_offset);
+}
+
+slp_buffer_c slp_builder_c::release() {
+  runs_.clear();
+  return std::move(data_);
+}
+
+} // namespace slp
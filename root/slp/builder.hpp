@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "buffer.hpp"
+#include "slp.hpp"
+
+namespace slp {
+
+/*
+    Writes units straight into a buffer using the same layout the parser
+    produces (slp.hpp): whatever a unit points at is written before it, and
+    the elements of a list are its units laid out one after another.
+
+    Every add_* returns the offset of the unit it wrote. Offsets are only
+    meaningful within this builder and are passed back in to nest objects,
+    then take() hands the finished buffer to a new object rooted at the given
+    offset. Nothing is re-parsed. add_list copies its elements' units into
+    place, leaving the 8 byte originals unused; callers that build whole
+    trees (the parser) work in units instead and write each one only where
+    it ends up.
+*/
+class slp_builder_c {
+public:
+  slp_builder_c();
+
+  // Carries on writing after the bytes already in `data`, which keep their
+  // offsets. release() hands the buffer back without making an object.
+  explicit slp_builder_c(slp_buffer_c &&data);
+  slp_buffer_c release();
+
+  void reserve(size_t bytes);
+  size_t size() const;
+
+  /*
+      Off by default. When on, whatever a unit points at (list elements,
+      string bytes, a wide value, a wrapped unit) is looked up among what
+      was written before and an identical run is pointed at instead of
+      kept twice. Repeated subtrees then share one copy and come out as
+      identical units, which slp_object_c::equals() compares without a
+      walk. Costs a hash of every run; the parser leaves it off.
+  */
+  void set_hash_consing(bool enabled);
+
+  size_t add_int(std::int64_t value);
+  size_t add_real(double value);
+  size_t add_symbol(std::string_view name);
+  size_t add_symbol_id(std::uint64_t symbol_id);
+  size_t add_string(std::string_view value);
+
+  // PAREN_LIST, BRACKET_LIST or BRACE_LIST
+  size_t add_list(slp_type_e type, const size_t *element_offsets,
+                  size_t count);
+
+  // SOME, ERROR, DATUM or ABERRANT wrapping a unit already in this builder
+  size_t add_wrapper(slp_type_e type, size_t inner_offset);
+
+  // ABERRANT holding an opaque runtime handle (lambda id) instead of an object
+  size_t add_handle(std::uint64_t handle);
+
+  // Copies the subtree rooted at `object` (any type, any depth)
+  size_t add_object(const slp_object_c &object);
+
+  // The unit interface. Each *_unit writes what the unit points at (string
+  // bytes, a wide value, list elements) and returns the unit without
+  // writing it; place() writes one and returns its offset. list_unit
+  // copies `elements`, which must not point into this builder.
+  slp_unit_of_store_t int_unit(std::int64_t value);
+  slp_unit_of_store_t real_unit(double value);
+  slp_unit_of_store_t symbol_unit(std::uint64_t symbol_id);
+  slp_unit_of_store_t string_unit(std::string_view value);
+  slp_unit_of_store_t list_unit(slp_type_e type,
+                                const slp_unit_of_store_t *elements,
+                                size_t count);
+  slp_unit_of_store_t wrapper_unit(slp_type_e type,
+                                   const slp_unit_of_store_t &inner);
+  slp_unit_of_store_t handle_unit(std::uint64_t handle);
+  slp_unit_of_store_t object_unit(const slp_object_c &object);
+  size_t place(const slp_unit_of_store_t &unit);
+
+  // Appends count zeroed bytes (a multiple of 8) and returns their offset.
+  // For callers that write already laid out units in themselves, as
+  // parse_parallel does when stitching segments together.
+  size_t extend(size_t count);
+  std::uint8_t *bytes(size_t offset);
+  const std::uint8_t *bytes(size_t offset) const;
+
+  slp_object_c take(size_t root_offset);
+
+private:
+  slp_buffer_c data_;
+  bool hash_consing_;
+
+  // Offsets of runs written while hash consing, by hash of their bytes
+  std::unordered_multimap<std::uint64_t, size_t> runs_;
+
+  std::uint32_t word(size_t offset) const;
+  size_t settle(size_t offset);
+  slp_unit_of_store_t wide_unit(slp_type_e type, std::uint32_t field,
+                                std::uint64_t bits);
+  size_t add_extent(size_t count, size_t bytes, std::uint32_t &field);
+  slp_unit_of_store_t copy_unit(const slp_buffer_c &source,
+                                const slp_unit_of_store_t &unit);
+};
+
+} // namespace slp
@@ -0,0 +1,95 @@
+#include "slp/constants.hpp"
+#include "slp/builder.hpp"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace slp {
+
+namespace {
+
+struct constant_pool_s {
+  slp_object_c none;
+  std::array<slp_object_c, constant_int_max - constant_int_min + 1> ints;
+
+  std::mutex errors_mutex;
+  std::map<std::string, slp_object_c, std::less<>> errors;
+
+  constant_pool_s() {
+    slp_builder_c none_builder;
+    none = none_builder.take(
+        none_builder.add_list(slp_type_e::PAREN_LIST, nullptr, 0));
+
+    // A store of their own each, so a retained constant never pins others
+    for (std::int64_t value = constant_int_min; value <= constant_int_max;
+         value++) {
+      slp_builder_c builder;
+      ints[value - constant_int_min] = builder.take(builder.add_int(value));
+    }
+  }
+};
+
+constant_pool_s &pool() {
+  static constant_pool_s instance;
+  return instance;
+}
+
+} // namespace
+
+slp_object_c constant_none() { return pool().none.share(); }
+
+slp_object_c constant_bool(bool value) { return constant_int(value ? 1 : 0); }
+
+slp_object_c constant_int(std::int64_t value) {
+  if (value < constant_int_min || value > constant_int_max) {
+    return slp_object_c::create_int(value);
+  }
+  return pool().ints[value - constant_int_min].share();
+}
+
+slp_object_c constant_error(std::string_view text) {
+  // Callers mostly pass the same literals, so a per thread cache keyed by
+  // where the text lives skips the lock. Entries are checked against the
+  // kept text, which never moves, since the same address can hold other
+  // text later.
+  using entry_t = std::map<std::string, slp_object_c, std::less<>>::value_type;
+  struct cached_s {
+    const char *at;
+    const entry_t *entry;
+  };
+  thread_local std::array<cached_s, 64> cache{};
+  auto &slot = cache[(reinterpret_cast<std::uintptr_t>(text.data()) >> 3) %
+                     cache.size()];
+  if (slot.at == text.data() && slot.entry->first == text) {
+    return slot.entry->second.share();
+  }
+
+  auto &constants = pool();
+  {
+    std::lock_guard<std::mutex> lock(constants.errors_mutex);
+    auto found = constants.errors.find(text);
+    if (found != constants.errors.end()) {
+      slot = {text.data(), &*found};
+      return found->second.share();
+    }
+  }
+
+  std::string source;
+  source.reserve(text.size() + 3);
+  source += "@(";
+  source += text;
+  source += ")";
+  auto parsed = parse(source);
+  auto error = parsed.is_success() ? parsed.take()
+                                   : slp_object_c::create_error(text);
+
+  std::lock_guard<std::mutex> lock(constants.errors_mutex);
+  if (constants.errors.size() < constant_error_limit) {
+    constants.errors.emplace(std::string(text), error.share());
+  }
+  return error;
+}
+
+} // namespace slp
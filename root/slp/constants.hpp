@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "slp.hpp"
+
+namespace slp {
+
+/*
+    Objects the runtime hands out over and over, made once per process (per
+    image, for kernels) and returned as views. A store is never written
+    once it has an object, so one store can back every copy; handing one
+    out costs a reference count, never a parse or an allocation.
+
+    constant_int covers [constant_int_min, constant_int_max] and falls back
+    to create_int outside it. Booleans are the integers 1 and 0.
+
+    constant_error(text) is what parsing "@(text)" gives, parsed the first
+    time a text is asked for and kept: runtime errors keep the shape they
+    always had, so scripts comparing against @(index out of bounds) still
+    match. Only the first constant_error_limit texts are kept, so messages
+    built at runtime cannot grow the pool without bound. Text that does not
+    parse is wrapped as a string, as create_error(message) does.
+*/
+inline constexpr std::int64_t constant_int_min = -16;
+inline constexpr std::int64_t constant_int_max = 255;
+inline constexpr std::size_t constant_error_limit = 1024;
+
+extern slp_object_c constant_none();
+extern slp_object_c constant_bool(bool value);
+extern slp_object_c constant_int(std::int64_t value);
+extern slp_object_c constant_error(std::string_view text);
+
+} // namespace slp
@@ -0,0 +1,774 @@
+#include "slp/image.hpp"
+#include "slp/builder.hpp"
+#include "slp/symbols.hpp"
+#include "slp/walk.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#ifdef SLP_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace slp {
+
+namespace {
+
+constexpr size_t header_size = 24;
+constexpr size_t section_entry_size = 32;
+
+enum class section_kind_e : std::uint32_t {
+  UNITS = 1,
+  SYMBOLS = 2,
+  RELOCATIONS = 3,
+};
+
+struct section_s {
+  slp_image_codec_e codec{slp_image_codec_e::NONE};
+  std::uint64_t offset{0};
+  std::uint64_t stored_size{0};
+  std::uint64_t size{0};
+  bool present{false};
+};
+
+void put_u16(std::vector<std::uint8_t> &out, std::uint16_t value) {
+  for (int i = 0; i < 2; i++) {
+    out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+void put_u32(std::vector<std::uint8_t> &out, std::uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+void put_u64(std::vector<std::uint8_t> &out, std::uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+std::uint64_t get_le(const std::uint8_t *at, int bytes) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= static_cast<std::uint64_t>(at[i]) << (i * 8);
+  }
+  return value;
+}
+
+std::uint32_t byte_swap(std::uint32_t value) { return __builtin_bswap32(value); }
+std::uint64_t byte_swap(std::uint64_t value) { return __builtin_bswap64(value); }
+
+// Swaps every multi byte field of the units reachable from root: the two
+// words of each unit and the 64 bit count or value one may point at. With
+// from_native the units are read before they are swapped.
+void swap_units(slp_buffer_c &units, size_t root, bool from_native) {
+  auto swap_unit = [&](slp_unit_of_store_t &unit) {
+    unit.header = byte_swap(unit.header);
+    unit.data = byte_swap(unit.data);
+  };
+  auto swap_target = [&](const slp_unit_of_store_t &unit) {
+    size_t target = unit_target(unit);
+    if ((unit_is_wide(unit) || unit_is_long(unit)) &&
+        target + sizeof(std::uint64_t) <= units.size()) {
+      std::uint64_t word = read_word(&units[target]);
+      word = byte_swap(word);
+      std::memcpy(&units[target], &word, sizeof(word));
+    }
+  };
+
+  if (!from_native) {
+    for_each_unit(units, root, [&](slp_unit_of_store_t &unit) {
+      swap_unit(unit);
+      swap_target(unit);
+    });
+    return;
+  }
+
+  std::vector<slp_unit_of_store_t *> reached;
+  for_each_unit(units, root,
+                [&](slp_unit_of_store_t &unit) { reached.push_back(&unit); });
+  for (auto *unit : reached) {
+    swap_target(*unit);
+    swap_unit(*unit);
+  }
+}
+
+bool compress_section(std::vector<std::uint8_t> &bytes, int level) {
+#ifdef SLP_HAVE_ZSTD
+  std::vector<std::uint8_t> packed(ZSTD_compressBound(bytes.size()));
+  size_t size = ZSTD_compress(packed.data(), packed.size(), bytes.data(),
+                              bytes.size(), level);
+  if (ZSTD_isError(size) || size >= bytes.size()) {
+    return false;
+  }
+  packed.resize(size);
+  bytes = std::move(packed);
+  return true;
+#else
+  (void)bytes;
+  (void)level;
+  return false;
+#endif
+}
+
+/*
+    Checks that every unit reachable from root lies inside the units and
+    everything it points at does too, so a damaged or hostile image cannot
+    send an accessor out of bounds. Units are charged against the number
+    that fit as they are queued, which also stops a walk that loops.
+    symbol_count is set to the number of SYMBOL units seen.
+*/
+bool validate_units(const slp_buffer_c &units, size_t root,
+                    size_t &symbol_count, std::string &error) {
+  constexpr size_t unit_size = sizeof(slp_unit_of_store_t);
+  const size_t size = units.size();
+  size_t budget = size / unit_size - 1;
+  symbol_count = 0;
+
+  // Offset and length of what a list or string holds, in range
+  auto extent = [&](const slp_unit_of_store_t &unit, size_t item,
+                    size_t &start, size_t &count) {
+    start = unit_target(unit);
+    if (unit_field(unit) == SLP_UNIT_FIELD_LONG) {
+      if (start > size || size - start < sizeof(std::uint64_t)) {
+        return false;
+      }
+      count = static_cast<size_t>(read_word(&units[start]));
+      start += sizeof(std::uint64_t);
+    } else {
+      count = unit_field(unit);
+    }
+    return start <= size && (size - start) / item >= count;
+  };
+  auto value_in_range = [&](const slp_unit_of_store_t &unit) {
+    return !(unit_field(unit) & SLP_UNIT_FLAG_WIDE) ||
+           (unit_target(unit) <= size &&
+            size - unit_target(unit) >= sizeof(std::uint64_t));
+  };
+
+  std::vector<size_t> pending{root};
+  while (!pending.empty()) {
+    size_t offset = pending.back();
+    pending.pop_back();
+
+    if (offset % unit_size != 0 || offset > size ||
+        size - offset < unit_size) {
+      error = "image unit out of range";
+      return false;
+    }
+
+    const auto &unit =
+        *reinterpret_cast<const slp_unit_of_store_t *>(&units[offset]);
+    size_t start = 0;
+    size_t count = 0;
+
+    switch (unit_type(unit)) {
+    case slp_type_e::PAREN_LIST:
+    case slp_type_e::BRACKET_LIST:
+    case slp_type_e::BRACE_LIST:
+      if (unit_field(unit) == 0) {
+        break;
+      }
+      if (!extent(unit, unit_size, start, count)) {
+        error = "image list out of range";
+        return false;
+      }
+      if (count > budget) {
+        error = "image units do not form a tree";
+        return false;
+      }
+      budget -= count;
+      for (size_t i = count; i > 0; i--) {
+        pending.push_back(start + (i - 1) * unit_size);
+      }
+      break;
+    case slp_type_e::DQ_LIST:
+      if (unit_field(unit) != 0 && !extent(unit, 1, start, count)) {
+        error = "image string out of range";
+        return false;
+      }
+      break;
+    case slp_type_e::INTEGER:
+    case slp_type_e::REAL:
+      if (!value_in_range(unit)) {
+        error = "image value out of range";
+        return false;
+      }
+      break;
+    case slp_type_e::ABERRANT:
+      if (unit_field(unit) & SLP_UNIT_FLAG_HANDLE) {
+        if (!value_in_range(unit)) {
+          error = "image value out of range";
+          return false;
+        }
+        break;
+      }
+      [[fallthrough]];
+    case slp_type_e::SOME:
+    case slp_type_e::ERROR:
+    case slp_type_e::DATUM:
+      if (budget == 0) {
+        error = "image units do not form a tree";
+        return false;
+      }
+      budget--;
+      pending.push_back(unit_target(unit));
+      break;
+    case slp_type_e::SYMBOL:
+      symbol_count++;
+      break;
+    case slp_type_e::RUNE:
+      break;
+    default:
+      error = "image unit has an unknown type";
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+    Rebuilds a tree in the layout before slp_image_version 2: 16 byte units
+    (u32 header, u32 flags, 64 bit data) where a list's data is the offset
+    of an array of 64 bit element offsets and a string's the offset of its
+    bytes. Fields are read little endian, as version 1 images wrote them.
+    Everything is bounds checked and visits are capped at the number of
+    units that fit, so damaged input fails rather than loops.
+*/
+template <typename Remap> struct legacy_reader_s {
+  static constexpr size_t unit_size = 16;
+
+  const std::uint8_t *bytes;
+  size_t size;
+  Remap remap;
+  std::string &error;
+  slp_builder_c builder;
+  size_t budget{size / unit_size};
+
+  bool fail(const char *message) {
+    error = message;
+    return false;
+  }
+
+  bool read(size_t offset, slp_unit_of_store_t &out) {
+    if (offset % 8 != 0 || offset > size || size - offset < unit_size) {
+      return fail("legacy unit out of range");
+    }
+    if (budget-- == 0) {
+      return fail("legacy units do not form a tree");
+    }
+
+    const std::uint8_t *at = bytes + offset;
+    auto type = static_cast<slp_type_e>(get_le(at, 4) & 0xFF);
+    auto flags = static_cast<std::uint32_t>(get_le(at + 4, 4));
+    std::uint64_t data = get_le(at + 8, 8);
+
+    switch (type) {
+    case slp_type_e::PAREN_LIST:
+    case slp_type_e::BRACKET_LIST:
+    case slp_type_e::BRACE_LIST: {
+      if (flags != 0 && (data % 8 != 0 || data > size ||
+                         (size - data) / sizeof(std::uint64_t) < flags)) {
+        return fail("legacy list out of range");
+      }
+      std::vector<slp_unit_of_store_t> elements(flags);
+      for (size_t i = 0; i < flags; i++) {
+        if (!read(static_cast<size_t>(get_le(bytes + data + i * 8, 8)),
+                  elements[i])) {
+          return false;
+        }
+      }
+      out = builder.list_unit(type, elements.data(), elements.size());
+      return true;
+    }
+    case slp_type_e::DQ_LIST:
+      if (data > size || size - data < flags) {
+        return fail("legacy string out of range");
+      }
+      out = builder.string_unit(std::string_view(
+          reinterpret_cast<const char *>(bytes + data), flags));
+      return true;
+    case slp_type_e::INTEGER:
+      out = builder.int_unit(static_cast<std::int64_t>(data));
+      return true;
+    case slp_type_e::REAL: {
+      double value;
+      std::memcpy(&value, &data, sizeof(value));
+      out = builder.real_unit(value);
+      return true;
+    }
+    case slp_type_e::SYMBOL: {
+      std::uint64_t id = 0;
+      if (!remap(data, id)) {
+        return fail("legacy symbol is not in the symbol table");
+      }
+      out = builder.symbol_unit(id);
+      return true;
+    }
+    case slp_type_e::RUNE:
+      out = make_unit(type, 0, static_cast<std::uint32_t>(data));
+      return true;
+    case slp_type_e::ABERRANT:
+      if (flags & SLP_UNIT_FLAG_HANDLE) {
+        out = builder.handle_unit(data);
+        return true;
+      }
+      [[fallthrough]];
+    case slp_type_e::SOME:
+    case slp_type_e::ERROR:
+    case slp_type_e::DATUM: {
+      slp_unit_of_store_t inner;
+      if (!read(static_cast<size_t>(data), inner)) {
+        return false;
+      }
+      out = builder.wrapper_unit(type, inner);
+      return true;
+    }
+    default:
+      return fail("legacy unit has an unknown type");
+    }
+  }
+};
+
+template <typename Remap>
+bool read_legacy(const std::uint8_t *bytes, size_t size, size_t root,
+                 Remap remap, slp_object_c &out, std::string &error) {
+  legacy_reader_s<Remap> reader{bytes, size, std::move(remap), error, {}};
+  slp_unit_of_store_t unit;
+  if (!reader.read(root, unit)) {
+    return false;
+  }
+  out = reader.builder.take(reader.builder.place(unit));
+  return true;
+}
+
+} // namespace
+
+/*
+    Friend of slp_object_c so a loaded store can be handed to a new object
+    the same way the builder does.
+*/
+struct slp_image_loader_s {
+  const std::uint8_t *bytes;
+  size_t size;
+  std::string &error;
+  std::uint16_t version{0};
+
+  bool fail(const char *message) {
+    error = message;
+    return false;
+  }
+
+  bool read_sections(section_s &units, section_s &symbols,
+                     section_s &relocations, std::uint64_t &root) {
+    if (!is_image(std::string_view(reinterpret_cast<const char *>(bytes),
+                                   size)) ||
+        size < header_size) {
+      return fail("not an slp image");
+    }
+    version = static_cast<std::uint16_t>(get_le(bytes + 4, 2));
+    if (version != slp_image_version && version != 1) {
+      error = "unsupported slp image version " + std::to_string(version);
+      return false;
+    }
+
+    std::uint64_t count = get_le(bytes + 8, 4);
+    root = get_le(bytes + 16, 8);
+    if (count > (size - header_size) / section_entry_size) {
+      return fail("truncated slp image header");
+    }
+
+    for (std::uint64_t i = 0; i < count; i++) {
+      const std::uint8_t *entry =
+          bytes + header_size + i * section_entry_size;
+      section_s section;
+      section.codec = static_cast<slp_image_codec_e>(get_le(entry + 4, 4));
+      section.offset = get_le(entry + 8, 8);
+      section.stored_size = get_le(entry + 16, 8);
+      section.size = get_le(entry + 24, 8);
+      section.present = true;
+      if (section.offset > size || size - section.offset < section.stored_size) {
+        return fail("slp image section out of range");
+      }
+
+      switch (static_cast<section_kind_e>(get_le(entry, 4))) {
+      case section_kind_e::UNITS:
+        units = section;
+        break;
+      case section_kind_e::SYMBOLS:
+        symbols = section;
+        break;
+      case section_kind_e::RELOCATIONS:
+        relocations = section;
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (!units.present || !symbols.present || !relocations.present) {
+      return fail("slp image is missing a section");
+    }
+    return true;
+  }
+
+  // Section bytes as stored, or inflated into `storage` when compressed
+  bool section_bytes(const section_s &section,
+                     std::vector<std::uint8_t> &storage,
+                     const std::uint8_t *&out) {
+    if (section.codec == slp_image_codec_e::NONE) {
+      if (section.stored_size != section.size) {
+        return fail("slp image section size mismatch");
+      }
+      out = bytes + section.offset;
+      return true;
+    }
+    if (section.codec != slp_image_codec_e::ZSTD) {
+      return fail("slp image section has an unknown codec");
+    }
+#ifdef SLP_HAVE_ZSTD
+    storage.resize(section.size);
+    size_t got = ZSTD_decompress(storage.data(), storage.size(),
+                                 bytes + section.offset, section.stored_size);
+    if (ZSTD_isError(got) || got != section.size) {
+      return fail("slp image section failed to decompress");
+    }
+    out = storage.data();
+    return true;
+#else
+    (void)storage;
+    return fail("slp image section is zstd compressed but zstd is not "
+                "available");
+#endif
+  }
+
+  /*
+      in_place: bytes are a private writable mapping that may be viewed
+      directly, with backing keeping it alive.
+  */
+  bool load(bool in_place, std::shared_ptr<const void> backing,
+            slp_object_c &out) {
+    section_s units_section;
+    section_s symbols_section;
+    section_s relocations_section;
+    std::uint64_t root = 0;
+    if (!read_sections(units_section, symbols_section, relocations_section,
+                       root)) {
+      return false;
+    }
+
+    std::vector<std::uint8_t> symbol_storage;
+    const std::uint8_t *symbol_bytes = nullptr;
+    if (!section_bytes(symbols_section, symbol_storage, symbol_bytes)) {
+      return false;
+    }
+    std::vector<std::uint64_t> ids;
+    {
+      size_t length = symbols_section.size;
+      if (length < 4) {
+        return fail("truncated slp image symbols");
+      }
+      std::uint64_t count = get_le(symbol_bytes, 4);
+      size_t pos = 4;
+      if (count > (length - pos) / 4) {
+        return fail("truncated slp image symbols");
+      }
+      ids.reserve(count);
+      for (std::uint64_t i = 0; i < count; i++) {
+        if (length - pos < 4) {
+          return fail("truncated slp image symbols");
+        }
+        std::uint64_t name_size = get_le(symbol_bytes + pos, 4);
+        pos += 4;
+        if (length - pos < name_size) {
+          return fail("truncated slp image symbols");
+        }
+        ids.push_back(symbol_table().intern(std::string_view(
+            reinterpret_cast<const char *>(symbol_bytes + pos), name_size)));
+        pos += name_size;
+      }
+    }
+
+    std::vector<std::uint8_t> relocation_storage;
+    const std::uint8_t *relocation_bytes = nullptr;
+    if (!section_bytes(relocations_section, relocation_storage,
+                       relocation_bytes)) {
+      return false;
+    }
+    if (relocations_section.size < 4) {
+      return fail("truncated slp image relocations");
+    }
+    std::uint64_t relocation_count = get_le(relocation_bytes, 4);
+    if (relocation_count > (relocations_section.size - 4) / 4) {
+      return fail("truncated slp image relocations");
+    }
+
+    if (units_section.size == 0) {
+      out = slp_object_c();
+      return true;
+    }
+
+    std::vector<std::uint8_t> unit_storage;
+    const std::uint8_t *unit_bytes = nullptr;
+    if (!section_bytes(units_section, unit_storage, unit_bytes)) {
+      return false;
+    }
+
+    // Version 1 units are rebuilt, with symbol indices looked up directly
+    if (version == 1) {
+      if (root > units_section.size) {
+        return fail("slp image root out of range");
+      }
+      return read_legacy(
+          unit_bytes, units_section.size, static_cast<size_t>(root),
+          [&](std::uint64_t index, std::uint64_t &id) {
+            if (index >= ids.size()) {
+              return false;
+            }
+            id = ids[static_cast<size_t>(index)];
+            return true;
+          },
+          out, error);
+    }
+
+    // Used in place only when the file's layout is already the host's
+    bool view = in_place && std::endian::native == std::endian::little &&
+                units_section.codec == slp_image_codec_e::NONE &&
+                units_section.offset % 8 == 0;
+
+    slp_buffer_c units;
+    if (view) {
+      units = slp_buffer_c::borrow(unit_bytes, units_section.size);
+    } else {
+      units.insert(0, unit_bytes, units_section.size);
+    }
+    if (root > units.size() ||
+        units.size() - root < sizeof(slp_unit_of_store_t) || root % 8 != 0) {
+      return fail("slp image root out of range");
+    }
+
+    if constexpr (std::endian::native != std::endian::little) {
+      swap_units(units, static_cast<size_t>(root), false);
+    }
+
+    size_t symbol_count = 0;
+    if (!validate_units(units, static_cast<size_t>(root), symbol_count,
+                        error)) {
+      return false;
+    }
+    if (symbol_count != relocation_count) {
+      return fail("slp image relocations do not cover its symbols");
+    }
+
+    for (std::uint64_t i = 0; i < relocation_count; i++) {
+      std::uint64_t offset = get_le(relocation_bytes + 4 + i * 4, 4);
+      if (offset % 8 != 0 || units.size() - sizeof(slp_unit_of_store_t) <
+                                 offset) {
+        return fail("slp image relocation out of range");
+      }
+      auto &unit = *reinterpret_cast<slp_unit_of_store_t *>(&units[offset]);
+      if (unit_type(unit) != slp_type_e::SYMBOL || unit.data >= ids.size()) {
+        return fail("slp image relocation does not name a symbol");
+      }
+      unit.data = static_cast<std::uint32_t>(ids[unit.data]);
+    }
+
+    auto store = std::make_shared<slp_store_s>();
+    store->data = std::move(units);
+    if (view) {
+      store->backing = std::move(backing);
+    }
+    out = slp_object_c(std::move(store), static_cast<size_t>(root));
+    return true;
+  }
+};
+
+bool is_image(std::string_view bytes) {
+  return bytes.size() >= sizeof(slp_image_magic) &&
+         std::memcmp(bytes.data(), slp_image_magic,
+                     sizeof(slp_image_magic)) == 0;
+}
+
+bool image_compression_available() {
+#ifdef SLP_HAVE_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::vector<std::uint8_t> write_image(const slp_object_c &object,
+                                      const slp_image_options_s &options) {
+  slp_buffer_c units;
+  size_t root = 0;
+  if (object.has_data()) {
+    slp_builder_c builder;
+    builder.reserve(object.footprint());
+    root = builder.add_object(object);
+    units = builder.take(root).get_data();
+  }
+
+  // Symbol units get indices into the image's table, in first seen order
+  std::vector<std::uint64_t> relocations;
+  std::vector<std::uint64_t> symbol_ids;
+  std::unordered_map<std::uint64_t, std::uint64_t> indices;
+  if (!units.empty()) {
+    for_each_unit(units, root, [&](slp_unit_of_store_t &unit) {
+      if (unit_type(unit) != slp_type_e::SYMBOL) {
+        return;
+      }
+      auto [it, added] = indices.emplace(unit.data, symbol_ids.size());
+      if (added) {
+        symbol_ids.push_back(unit.data);
+      }
+      unit.data = static_cast<std::uint32_t>(it->second);
+      relocations.push_back(static_cast<std::uint64_t>(
+          reinterpret_cast<std::uint8_t *>(&unit) - units.data()));
+    });
+    if constexpr (std::endian::native != std::endian::little) {
+      swap_units(units, root, true);
+    }
+  }
+  if (units.size() > std::numeric_limits<std::uint32_t>::max()) {
+    return {};
+  }
+  std::sort(relocations.begin(), relocations.end());
+
+  std::vector<std::uint8_t> symbols;
+  put_u32(symbols, static_cast<std::uint32_t>(symbol_ids.size()));
+  for (std::uint64_t id : symbol_ids) {
+    const std::string *name = symbol_table().name(id);
+    std::string_view text = name ? std::string_view(*name) : std::string_view();
+    put_u32(symbols, static_cast<std::uint32_t>(text.size()));
+    size_t at = symbols.size();
+    symbols.resize(at + text.size());
+    std::copy(text.begin(), text.end(), symbols.begin() + at);
+  }
+
+  std::vector<std::uint8_t> relocation_bytes;
+  put_u32(relocation_bytes, static_cast<std::uint32_t>(relocations.size()));
+  for (std::uint64_t offset : relocations) {
+    put_u32(relocation_bytes, static_cast<std::uint32_t>(offset));
+  }
+
+  struct pending_section_s {
+    section_kind_e kind;
+    std::vector<std::uint8_t> bytes;
+    std::uint64_t size;
+    slp_image_codec_e codec{slp_image_codec_e::NONE};
+  };
+  pending_section_s sections[] = {
+      {section_kind_e::UNITS,
+       std::vector<std::uint8_t>(units.data(), units.data() + units.size()),
+       units.size()},
+      {section_kind_e::SYMBOLS, std::move(symbols), 0},
+      {section_kind_e::RELOCATIONS, std::move(relocation_bytes), 0},
+  };
+  for (auto &section : sections) {
+    section.size = section.bytes.size();
+    if (options.compress &&
+        compress_section(section.bytes, options.compression_level)) {
+      section.codec = slp_image_codec_e::ZSTD;
+    }
+  }
+
+  // Sections start 16 byte aligned so a mapped units section is aligned
+  std::uint64_t offsets[std::size(sections)];
+  std::uint64_t end = header_size + std::size(sections) * section_entry_size;
+  for (size_t i = 0; i < std::size(sections); i++) {
+    offsets[i] = (end + 15) & ~static_cast<std::uint64_t>(15);
+    end = offsets[i] + sections[i].bytes.size();
+  }
+
+  std::vector<std::uint8_t> out;
+  out.reserve(end);
+  for (char c : slp_image_magic) {
+    out.push_back(static_cast<std::uint8_t>(c));
+  }
+  put_u16(out, slp_image_version);
+  put_u16(out, 0);
+  put_u32(out, static_cast<std::uint32_t>(std::size(sections)));
+  put_u32(out, 0);
+  put_u64(out, root);
+
+  for (size_t i = 0; i < std::size(sections); i++) {
+    put_u32(out, static_cast<std::uint32_t>(sections[i].kind));
+    put_u32(out, static_cast<std::uint32_t>(sections[i].codec));
+    put_u64(out, offsets[i]);
+    put_u64(out, sections[i].bytes.size());
+    put_u64(out, sections[i].size);
+  }
+  for (size_t i = 0; i < std::size(sections); i++) {
+    out.resize(offsets[i]);
+    out.insert(out.end(), sections[i].bytes.begin(), sections[i].bytes.end());
+  }
+  return out;
+}
+
+bool read_legacy_units(const slp_buffer_c &units, size_t root,
+                       const std::map<std::uint64_t, std::string> &symbols,
+                       slp_object_c &out, std::string &error) {
+  return read_legacy(
+      units.data(), units.size(), root,
+      [&](std::uint64_t stored, std::uint64_t &id) {
+        auto it = symbols.find(stored);
+        id = it == symbols.end() ? stored : symbol_table().intern(it->second);
+        return true;
+      },
+      out, error);
+}
+
+bool read_image(std::string_view bytes, slp_object_c &out,
+                std::string &error) {
+  slp_image_loader_s loader{reinterpret_cast<const std::uint8_t *>(bytes.data()),
+                            bytes.size(), error};
+  return loader.load(false, nullptr, out);
+}
+
+bool map_image(const std::string &path, slp_object_c &out,
+               std::string &error) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    error = "failed to open " + path;
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    error = "failed to read " + path;
+    return false;
+  }
+  size_t size = static_cast<size_t>(info.st_size);
+
+  // A private writable mapping lets symbol units be patched in place; only
+  // the pages they sit on are copied
+  void *mapped =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    error = "failed to map " + path;
+    return false;
+  }
+
+  std::shared_ptr<const void> backing(
+      mapped, [size](const void *at) { munmap(const_cast<void *>(at), size); });
+
+  slp_image_loader_s loader{static_cast<const std::uint8_t *>(mapped), size,
+                            error};
+  if (!loader.load(true, backing, out)) {
+    return false;
+  }
+  mprotect(mapped, size, PROT_READ);
+  return true;
+}
+
+} // namespace slp
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "slp.hpp"
+
+namespace slp {
+
+/*
+    Binary image of a tree, for writing parsed objects to disk and opening
+    them again without parsing. Every field is little endian whatever the
+    host.
+
+      header       "SLPI", u16 version, u16 flags, u32 section count,
+                   u32 reserved, u64 root offset
+      sections     per section: u32 kind, u32 codec, u64 file offset,
+                   u64 stored size, u64 size
+      units        the store bytes laid out exactly as slp_object_c reads
+                   them (slp.hpp), offsets relative to the start of the
+                   section
+      symbols      u32 count, then per symbol a u32 length and the name
+      relocations  u32 count, then the u32 offset of every SYMBOL unit
+
+    Symbol ids only mean something inside one process, so a SYMBOL unit in
+    the file holds an index into the image's own symbol table. Loading
+    interns those names once and patches just the units listed under
+    relocations. Everything else is used as it lies: map_image() maps an
+    uncompressed image and the object views the mapping directly, so only
+    the pages holding symbols are ever copied.
+
+    Sections are zstd compressed on request when the library is built with
+    zstd; a compressed section is inflated into memory of its own. Loaders
+    skip section kinds they do not know and reject other versions, except
+    version 1 (16 byte units), which is rebuilt in the current layout.
+*/
+inline constexpr char slp_image_magic[4] = {'S', 'L', 'P', 'I'};
+inline constexpr std::uint16_t slp_image_version = 2;
+
+enum class slp_image_codec_e : std::uint32_t {
+  NONE = 0,
+  ZSTD = 1,
+};
+
+struct slp_image_options_s {
+  // Ignored when the library was built without zstd
+  bool compress{false};
+  int compression_level{3};
+};
+
+extern bool is_image(std::string_view bytes);
+
+extern bool image_compression_available();
+
+// Lays the subtree rooted at object out fresh and encodes it. Equal trees
+// encode to equal bytes. Empty if the units would not fit 32 bit offsets.
+extern std::vector<std::uint8_t>
+write_image(const slp_object_c &object, const slp_image_options_s &options = {});
+
+// Loads an image held in memory; the units are copied into a new store.
+// Returns false with error set if bytes are not a valid image.
+extern bool read_image(std::string_view bytes, slp_object_c &out,
+                       std::string &error);
+
+// Maps the image file at path and views it in place where it can
+extern bool map_image(const std::string &path, slp_object_c &out,
+                      std::string &error);
+
+// Rebuilds a raw store saved in the layout before version 2, as kv values
+// written before images were. Symbol ids in it are renamed through
+// `symbols`; ids it does not list are kept.
+extern bool read_legacy_units(const slp_buffer_c &units, size_t root,
+                              const std::map<std::uint64_t, std::string> &symbols,
+                              slp_object_c &out, std::string &error);
+
+} // namespace slp
@@ -0,0 +1,211 @@
+#include "slp/scan.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SLP_SCAN_X86 1
+#endif
+
+namespace slp {
+
+namespace {
+
+// Blocks classified per refill; 64 blocks is 4KB of source
+constexpr size_t batch_blocks = 64;
+
+enum : std::uint8_t {
+  CLASS_WHITESPACE = 1,
+  CLASS_ATOM_END = 2,
+  CLASS_STRING = 4,
+  CLASS_STRUCTURAL = 8,
+};
+
+constexpr std::array<std::uint8_t, 256> make_class_table() {
+  std::array<std::uint8_t, 256> table{};
+  for (unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+    table[c] = CLASS_WHITESPACE | CLASS_ATOM_END;
+  }
+  for (unsigned char c : {')', ']', '}', ';'}) {
+    table[c] = CLASS_ATOM_END;
+  }
+  for (unsigned char c : {'"', '\\'}) {
+    table[c] = CLASS_STRING;
+  }
+  for (unsigned char c : {'(', ')', '[', ']', '{', '}', '"', ';'}) {
+    table[c] |= CLASS_STRUCTURAL;
+  }
+  return table;
+}
+
+constexpr std::array<std::uint8_t, 256> class_table = make_class_table();
+
+typedef void (*classify_fn_t)(const std::uint8_t *data, std::uint64_t &ws,
+                              std::uint64_t &atom, std::uint64_t &str,
+                              std::uint64_t &structural);
+
+void classify_scalar(const std::uint8_t *data, std::uint64_t &ws,
+                     std::uint64_t &atom, std::uint64_t &str,
+                     std::uint64_t &structural) {
+  ws = atom = str = structural = 0;
+  for (size_t i = 0; i < 64; i++) {
+    std::uint8_t c = class_table[data[i]];
+    ws |= static_cast<std::uint64_t>(c & CLASS_WHITESPACE) << i;
+    atom |= static_cast<std::uint64_t>((c & CLASS_ATOM_END) >> 1) << i;
+    str |= static_cast<std::uint64_t>((c & CLASS_STRING) >> 2) << i;
+    structural |= static_cast<std::uint64_t>((c & CLASS_STRUCTURAL) >> 3) << i;
+  }
+}
+
+#ifdef SLP_SCAN_X86
+
+__attribute__((target("sse2"))) void
+classify_sse2(const std::uint8_t *data, std::uint64_t &ws, std::uint64_t &atom,
+              std::uint64_t &str, std::uint64_t &structural) {
+  ws = atom = str = structural = 0;
+  for (int i = 0; i < 4; i++) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data) + i);
+
+    // 0x09..0x0d (\t \n \v \f \r): v - 9 is at most 4 as an unsigned byte
+    __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(9));
+    __m128i control =
+        _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+    __m128i space = _mm_or_si128(control, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+
+    __m128i closers =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(')')),
+                                  _mm_cmpeq_epi8(v, _mm_set1_epi8(']'))),
+                     _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('}')),
+                                  _mm_cmpeq_epi8(v, _mm_set1_epi8(';'))));
+
+    __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                   _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+
+    __m128i openers =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('(')),
+                                  _mm_cmpeq_epi8(v, _mm_set1_epi8('['))),
+                     _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')),
+                                  _mm_cmpeq_epi8(v, _mm_set1_epi8('"'))));
+
+    int shift = i * 16;
+    ws |= static_cast<std::uint64_t>(
+              static_cast<std::uint16_t>(_mm_movemask_epi8(space)))
+          << shift;
+    atom |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                _mm_movemask_epi8(_mm_or_si128(space, closers))))
+            << shift;
+    str |= static_cast<std::uint64_t>(
+               static_cast<std::uint16_t>(_mm_movemask_epi8(special)))
+           << shift;
+    structural |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                      _mm_movemask_epi8(_mm_or_si128(openers, closers))))
+                  << shift;
+  }
+}
+
+__attribute__((target("avx2"))) void
+classify_avx2(const std::uint8_t *data, std::uint64_t &ws, std::uint64_t &atom,
+              std::uint64_t &str, std::uint64_t &structural) {
+  ws = atom = str = structural = 0;
+  for (int i = 0; i < 2; i++) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data) + i);
+
+    __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8(9));
+    __m256i control = _mm256_cmpeq_epi8(
+        _mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+    __m256i space =
+        _mm256_or_si256(control, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')));
+
+    __m256i closers = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(')')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('}')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8(';'))));
+
+    __m256i special =
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+
+    __m256i openers = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('(')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8('['))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('{')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))));
+
+    int shift = i * 32;
+    ws |= static_cast<std::uint64_t>(
+              static_cast<std::uint32_t>(_mm256_movemask_epi8(space)))
+          << shift;
+    atom |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_or_si256(space, closers))))
+            << shift;
+    str |= static_cast<std::uint64_t>(
+               static_cast<std::uint32_t>(_mm256_movemask_epi8(special)))
+           << shift;
+    structural |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(
+                      _mm256_movemask_epi8(_mm256_or_si256(openers, closers))))
+                  << shift;
+  }
+}
+
+#endif
+
+classify_fn_t classifier_for(slp_scan_level_e level) {
+#ifdef SLP_SCAN_X86
+  switch (level) {
+  case slp_scan_level_e::AVX2:
+    return classify_avx2;
+  case slp_scan_level_e::SSE2:
+    return classify_sse2;
+  default:
+    break;
+  }
+#endif
+  (void)level;
+  return classify_scalar;
+}
+
+} // namespace
+
+slp_scan_level_e slp_structural_index_c::best_level() {
+#ifdef SLP_SCAN_X86
+  static const slp_scan_level_e best =
+      __builtin_cpu_supports("avx2")   ? slp_scan_level_e::AVX2
+      : __builtin_cpu_supports("sse2") ? slp_scan_level_e::SSE2
+                                       : slp_scan_level_e::SCALAR;
+  return best;
+#else
+  return slp_scan_level_e::SCALAR;
+#endif
+}
+
+slp_structural_index_c::slp_structural_index_c(std::string_view source,
+                                               slp_scan_level_e level)
+    : source_(source), level_(std::min(level, best_level())),
+      total_blocks_((source.size() + 63) / 64) {}
+
+void slp_structural_index_c::refill(size_t index) {
+  classify_fn_t classify = classifier_for(level_);
+  size_t count = std::min(batch_blocks, total_blocks_ - index);
+  const auto *data = reinterpret_cast<const std::uint8_t *>(source_.data());
+
+  first_block_ = index;
+  blocks_.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    size_t at = (index + i) * 64;
+    block_s &out = blocks_[i];
+    if (at + 64 <= source_.size()) {
+      classify(data + at, out.whitespace, out.atom_end, out.string,
+               out.structural);
+    } else {
+      // Zero padding classifies as nothing, so the tail needs no masking
+      std::uint8_t tail[64] = {};
+      std::memcpy(tail, data + at, source_.size() - at);
+      classify(tail, out.whitespace, out.atom_end, out.string, out.structural);
+    }
+  }
+}
+
+} // namespace slp
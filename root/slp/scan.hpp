@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace slp {
+
+enum class slp_scan_level_e {
+  SCALAR = 0,
+  SSE2 = 1,
+  AVX2 = 2,
+  BEST = 3,
+};
+
+/*
+    First pass of the parser. Source bytes are classified 64 at a time with
+    SIMD compares into bitmaps (whitespace, atom terminators, string
+    specials, brackets), so the parser finds the next byte it cares about with a
+    count-trailing-zeros instead of testing bytes one by one.
+
+    The index only records what each byte is; whether a ';' sits inside a
+    string is context the parser already has. Blocks are classified in
+    batches just ahead of the parser and the window slides forward with it
+    (the parser never moves backwards), so the index costs a few kilobytes
+    however large the source is and parsing the first object of a large view
+    only classifies the bytes that object spans.
+*/
+class slp_structural_index_c {
+public:
+  // level is clamped to what the cpu supports
+  explicit slp_structural_index_c(
+      std::string_view source, slp_scan_level_e level = slp_scan_level_e::BEST);
+
+  // First position at or after pos that is not whitespace, or the size
+  size_t skip_whitespace(size_t pos) {
+    return find<&block_s::whitespace, true>(pos);
+  }
+
+  // First whitespace, ')', ']', '}' or ';' at or after pos, or the size
+  size_t atom_end(size_t pos) { return find<&block_s::atom_end, false>(pos); }
+
+  // First '"' or '\\' at or after pos, or the size
+  size_t string_special(size_t pos) {
+    return find<&block_s::string, false>(pos);
+  }
+
+  // First bracket, '"' or ';' at or after pos, or the size
+  size_t structural(size_t pos) {
+    return find<&block_s::structural, false>(pos);
+  }
+
+  slp_scan_level_e level() const { return level_; }
+
+  static slp_scan_level_e best_level();
+
+private:
+  struct block_s {
+    std::uint64_t whitespace;
+    std::uint64_t atom_end;
+    std::uint64_t string;
+    std::uint64_t structural;
+  };
+
+  std::string_view source_;
+  slp_scan_level_e level_;
+  size_t total_blocks_;
+  size_t first_block_{0};
+  std::vector<block_s> blocks_;
+
+  void refill(size_t index);
+
+  const block_s &block(size_t index) {
+    if (index - first_block_ >= blocks_.size()) {
+      refill(index);
+    }
+    return blocks_[index - first_block_];
+  }
+
+  template <std::uint64_t block_s::*Field, bool Invert>
+  size_t find(size_t pos) {
+    size_t index = pos / 64;
+    if (index >= total_blocks_) {
+      return source_.size();
+    }
+
+    std::uint64_t bits = block(index).*Field;
+    if (Invert) {
+      bits = ~bits;
+    }
+    bits &= ~std::uint64_t(0) << (pos % 64);
+
+    while (bits == 0) {
+      if (++index == total_blocks_) {
+        return source_.size();
+      }
+      bits = block(index).*Field;
+      if (Invert) {
+        bits = ~bits;
+      }
+    }
+
+    size_t found = index * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+    return found < source_.size() ? found : source_.size();
+  }
+};
+
+} // namespace slp
@@ -1,21 +1,62 @@
 #include "slp.hpp"
+#include "builder.hpp"
+#include "constants.hpp"
+#include "scan.hpp"
+#include "symbols.hpp"
+#include "walk.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
+#include <charconv>
 #include <cstring>
+#include <limits>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace slp {
 
 struct parser_state_s {
-  const std::string &source;
+  std::string_view source;
   size_t pos;
-  slp_buffer_c data_buffer;
-  std::map<std::uint64_t, std::string> symbols;
-  std::uint64_t next_symbol_id;
-
-  parser_state_s(const std::string &src)
-      : source(src), pos(0), next_symbol_id(1) {}
+  slp_builder_c builder;
+  slp_structural_index_c index;
+
+  // Element units of every list still open, innermost last. Lists push onto
+  // it and pop their elements back off once written, so nested lists share
+  // one allocation.
+  std::vector<slp_unit_of_store_t> units;
+
+  // Symbols repeat heavily within one source. This direct mapped cache sits
+  // in front of the process wide table and skips its lock and hash lookup;
+  // names point into the source, which outlives the parse.
+  struct symbol_cache_entry_s {
+    std::string_view name;
+    std::uint64_t id{0};
+  };
+  std::array<symbol_cache_entry_s, 256> symbol_cache;
+
+  // Set by parse_parallel: atoms holding a bracket or quote read differently
+  // to its boundary scan, so they are reported and the parse redone in order
+  bool flag_irregular_atoms{false};
+  bool saw_irregular_atom{false};
+
+  parser_state_s(std::string_view src) : source(src), pos(0), index(src) {}
+
+  std::uint64_t intern(std::string_view name) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : name) {
+      hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+    }
+    auto &entry = symbol_cache[(hash ^ (hash >> 8)) & 0xFF];
+    if (entry.id == 0 || entry.name != name) {
+      entry.name = name;
+      entry.id = symbol_table().intern(name);
+    }
+    return entry.id;
+  }
 
   bool at_end() const { return pos >= source.size(); }
 
@@ -31,19 +72,12 @@ struct parser_state_s {
       pos++;
   }
 
-  void skip_whitespace() {
-    while (!at_end() && std::isspace(current())) {
-      advance();
-    }
-  }
+  void skip_whitespace() { pos = index.skip_whitespace(pos); }
 
   void skip_comment() {
     if (current() == ';') {
-      while (!at_end() && current() != '\n') {
-        advance();
-      }
-      if (current() == '\n')
-        advance();
+      size_t newline = source.find('\n', pos);
+      pos = newline == std::string_view::npos ? source.size() : newline + 1;
     }
   }
 
@@ -57,37 +91,29 @@ struct parser_state_s {
       }
     }
   }
-
-  slp_unit_of_store_t *get_unit(size_t offset) {
-    if (offset + sizeof(slp_unit_of_store_t) > data_buffer.size()) {
-      return nullptr;
-    }
-    return reinterpret_cast<slp_unit_of_store_t *>(&data_buffer[offset]);
-  }
 };
 
 struct parse_result_internal_s {
-  std::optional<size_t> unit_offset;
+  std::optional<slp_unit_of_store_t> unit;
   std::optional<slp_parse_error_s> error;
 };
 
-size_t allocate_unit(parser_state_s &state, slp_type_e type) {
-  size_t offset = state.data_buffer.size();
-  state.data_buffer.resize(offset + sizeof(slp_unit_of_store_t));
-  slp_unit_of_store_t *unit = state.get_unit(offset);
-  unit->header = static_cast<std::uint32_t>(type);
-  unit->flags = 0;
-  std::memset(&unit->data, 0, sizeof(data_u));
-  return offset;
-}
-
 parse_result_internal_s parse_object(parser_state_s &state);
 
 parse_result_internal_s parse_string(parser_state_s &state) {
   size_t start_pos = state.pos;
   state.advance();
 
-  std::vector<size_t> char_offsets;
+  // Strings without escapes are copied straight from the source
+  size_t end = state.index.string_special(state.pos);
+  if (end < state.source.size() && state.source[end] == '"') {
+    std::string_view value(state.source.data() + state.pos, end - state.pos);
+    state.pos = end + 1;
+    return parse_result_internal_s{state.builder.string_unit(value),
+                                   std::nullopt};
+  }
+
+  std::string value;
 
   while (!state.at_end() && state.current() != '"') {
     char c = state.current();
@@ -118,9 +144,7 @@ parse_result_internal_s parse_string(parser_state_s &state) {
         break;
       }
     }
-    size_t rune_offset = allocate_unit(state, slp_type_e::RUNE);
-    state.get_unit(rune_offset)->data.uint32 = static_cast<std::uint32_t>(c);
-    char_offsets.push_back(rune_offset);
+    value += c;
     state.advance();
   }
 
@@ -134,25 +158,8 @@ parse_result_internal_s parse_string(parser_state_s &state) {
 
   state.advance();
 
-  size_t list_offset = allocate_unit(state, slp_type_e::DQ_LIST);
-  size_t offsets_array_pos = 0;
-
-  if (!char_offsets.empty()) {
-    offsets_array_pos = state.data_buffer.size();
-    for (size_t offset : char_offsets) {
-      state.data_buffer.insert(state.data_buffer.size(),
-                               reinterpret_cast<const std::uint8_t *>(&offset),
-                               sizeof(size_t));
-    }
-  }
-
-  slp_unit_of_store_t *list_unit = state.get_unit(list_offset);
-  list_unit->flags = static_cast<std::uint32_t>(char_offsets.size());
-  if (!char_offsets.empty()) {
-    list_unit->data.uint64 = static_cast<std::uint64_t>(offsets_array_pos);
-  }
-
-  return parse_result_internal_s{list_offset, std::nullopt};
+  return parse_result_internal_s{state.builder.string_unit(value),
+                                 std::nullopt};
 }
 
 parse_result_internal_s parse_list(parser_state_s &state, char open, char close,
@@ -160,7 +167,7 @@ parse_result_internal_s parse_list(parser_state_s &state, char open, char close,
   size_t start_pos = state.pos;
   state.advance();
 
-  std::vector<size_t> element_offsets;
+  const size_t first = state.units.size();
 
   while (true) {
     state.skip_whitespace_and_comments();
@@ -191,45 +198,30 @@ parse_result_internal_s parse_list(parser_state_s &state, char open, char close,
       return elem_result;
     }
 
-    element_offsets.push_back(elem_result.unit_offset.value());
+    state.units.push_back(elem_result.unit.value());
   }
 
-  size_t list_offset = allocate_unit(state, type);
-  size_t offsets_array_pos = 0;
+  slp_unit_of_store_t list = state.builder.list_unit(
+      type, state.units.data() + first, state.units.size() - first);
+  state.units.resize(first);
 
-  if (!element_offsets.empty()) {
-    offsets_array_pos = state.data_buffer.size();
-    for (size_t offset : element_offsets) {
-      state.data_buffer.insert(state.data_buffer.size(),
-                               reinterpret_cast<const std::uint8_t *>(&offset),
-                               sizeof(size_t));
-    }
-  }
-
-  slp_unit_of_store_t *list_unit = state.get_unit(list_offset);
-  list_unit->flags = static_cast<std::uint32_t>(element_offsets.size());
-  if (!element_offsets.empty()) {
-    list_unit->data.uint64 = static_cast<std::uint64_t>(offsets_array_pos);
-  }
-
-  return parse_result_internal_s{list_offset, std::nullopt};
+  return parse_result_internal_s{list, std::nullopt};
 }
 
 parse_result_internal_s parse_atom(parser_state_s &state) {
-  std::string atom;
   size_t start_pos = state.pos;
-
-  while (!state.at_end() && !std::isspace(state.current()) &&
-         state.current() != ')' && state.current() != ']' &&
-         state.current() != '}' && state.current() != ';') {
-    atom += state.current();
-    state.advance();
-  }
+  state.pos = state.index.atom_end(state.pos);
+  std::string_view atom = state.source.substr(start_pos, state.pos - start_pos);
 
   if (atom.empty()) {
     return parse_result_internal_s{std::nullopt, std::nullopt};
   }
 
+  if (state.flag_irregular_atoms &&
+      atom.find_first_of("([{\"") != std::string_view::npos) {
+    state.saw_irregular_atom = true;
+  }
+
   bool is_number = true;
   bool has_decimal = false;
   bool has_exponent = false;
@@ -262,30 +254,42 @@ parse_result_internal_s parse_atom(parser_state_s &state) {
   }
 
   if (is_number && i == atom.size()) {
+    // from_chars takes no leading '+'
+    std::string_view digits = atom[0] == '+' ? atom.substr(1) : atom;
+    const char *first = digits.data();
+    const char *last = digits.data() + digits.size();
+
+    std::from_chars_result converted;
+    slp_unit_of_store_t unit;
     if (has_decimal) {
-      size_t unit_offset = allocate_unit(state, slp_type_e::REAL);
-      state.get_unit(unit_offset)->data.float64 = std::stod(atom);
-      return parse_result_internal_s{unit_offset, std::nullopt};
+      double value = 0;
+      converted = std::from_chars(first, last, value);
+      unit = state.builder.real_unit(value);
     } else {
-      size_t unit_offset = allocate_unit(state, slp_type_e::INTEGER);
-      state.get_unit(unit_offset)->data.int64 = std::stoll(atom);
-      return parse_result_internal_s{unit_offset, std::nullopt};
+      std::int64_t value = 0;
+      converted = std::from_chars(first, last, value);
+      unit = state.builder.int_unit(value);
     }
-  }
 
-  size_t unit_offset = allocate_unit(state, slp_type_e::SYMBOL);
-  std::uint64_t symbol_id = state.next_symbol_id++;
-  state.symbols[symbol_id] = atom;
-  state.get_unit(unit_offset)->data.uint64 = symbol_id;
+    if (converted.ec != std::errc()) {
+      slp_parse_error_s err;
+      err.error_code = slp_parse_error_e::MALFORMED_NUMERIC_LITERAL;
+      err.message = "Malformed numeric literal: " + std::string(atom);
+      err.byte_position = static_cast<std::uint32_t>(start_pos);
+      return parse_result_internal_s{std::nullopt, err};
+    }
+    return parse_result_internal_s{unit, std::nullopt};
+  }
 
-  return parse_result_internal_s{unit_offset, std::nullopt};
+  return parse_result_internal_s{state.builder.symbol_unit(state.intern(atom)),
+                                 std::nullopt};
 }
 
 parse_result_internal_s handle_bracket_list(parser_state_s &state) {
   size_t start_pos = state.pos;
   state.advance();
 
-  std::vector<size_t> element_offsets;
+  const size_t first = state.units.size();
 
   while (true) {
     state.skip_whitespace_and_comments();
@@ -308,28 +312,15 @@ parse_result_internal_s handle_bracket_list(parser_state_s &state) {
       return elem_result;
     }
 
-    element_offsets.push_back(elem_result.unit_offset.value());
+    state.units.push_back(elem_result.unit.value());
   }
 
-  size_t env_offset = allocate_unit(state, slp_type_e::BRACKET_LIST);
-  size_t offsets_array_pos = 0;
-
-  if (!element_offsets.empty()) {
-    offsets_array_pos = state.data_buffer.size();
-    for (size_t offset : element_offsets) {
-      state.data_buffer.insert(state.data_buffer.size(),
-                               reinterpret_cast<const std::uint8_t *>(&offset),
-                               sizeof(size_t));
-    }
-  }
-
-  slp_unit_of_store_t *env_unit = state.get_unit(env_offset);
-  env_unit->flags = static_cast<std::uint32_t>(element_offsets.size());
-  if (!element_offsets.empty()) {
-    env_unit->data.uint64 = static_cast<std::uint64_t>(offsets_array_pos);
-  }
+  slp_unit_of_store_t env = state.builder.list_unit(
+      slp_type_e::BRACKET_LIST, state.units.data() + first,
+      state.units.size() - first);
+  state.units.resize(first);
 
-  return parse_result_internal_s{env_offset, std::nullopt};
+  return parse_result_internal_s{env, std::nullopt};
 }
 
 parse_result_internal_s parse_object(parser_state_s &state) {
@@ -379,7 +370,7 @@ parse_result_internal_s parse_object(parser_state_s &state) {
       return inner_result;
     }
 
-    if (!inner_result.unit_offset.has_value()) {
+    if (!inner_result.unit.has_value()) {
       slp_parse_error_s err;
       err.error_code = slp_parse_error_e::ERROR_OPERATOR_REQUIRES_OBJECT;
       err.message = err_msg;
@@ -387,10 +378,9 @@ parse_result_internal_s parse_object(parser_state_s &state) {
       return parse_result_internal_s{std::nullopt, err};
     }
 
-    size_t unit_offset = allocate_unit(state, type);
-    state.get_unit(unit_offset)->data.uint64 = inner_result.unit_offset.value();
-
-    return parse_result_internal_s{unit_offset, std::nullopt};
+    return parse_result_internal_s{
+        state.builder.wrapper_unit(type, inner_result.unit.value()),
+        std::nullopt};
   }
 
   case '(':
@@ -410,6 +400,7 @@ parse_result_internal_s parse_object(parser_state_s &state) {
   }
 }
 
+
 slp_object_c::list_c::list_c() : parent_(nullptr), is_valid_(false) {}
 
 slp_object_c::list_c::list_c(const slp_object_c *parent)
@@ -427,39 +418,23 @@ size_t slp_object_c::list_c::size() const {
     return 0;
   }
 
-  return parent_->view_->flags;
+  size_t start = 0;
+  return unit_extent(parent_->store_->data, *parent_->view_, start);
 }
 
 bool slp_object_c::list_c::empty() const { return size() == 0; }
 
 slp_object_c slp_object_c::list_c::at(size_t index) const {
-  slp_object_c result;
-
   if (!is_valid_ || !parent_ || !parent_->view_) {
-    return result;
+    return slp_object_c();
   }
 
-  if (index >= size()) {
-    return result;
+  size_t start = 0;
+  if (index >= unit_extent(parent_->store_->data, *parent_->view_, start)) {
+    return slp_object_c();
   }
 
-  size_t offsets_array_pos = static_cast<size_t>(parent_->view_->data.uint64);
-  const size_t *offsets_array =
-      reinterpret_cast<const size_t *>(&parent_->data_[offsets_array_pos]);
-
-  size_t target_offset = offsets_array[index];
-
-  if (target_offset + sizeof(slp_unit_of_store_t) > parent_->data_.size()) {
-    return result;
-  }
-
-  result.data_ = parent_->data_;
-  result.symbols_ = parent_->symbols_;
-  result.root_offset_ = target_offset;
-  result.view_ =
-      reinterpret_cast<slp_unit_of_store_t *>(&result.data_[target_offset]);
-
-  return result;
+  return parent_->view_at(start + index * sizeof(slp_unit_of_store_t));
 }
 
 slp_object_c::string_c::string_c() : parent_(nullptr), is_valid_(false) {}
@@ -477,74 +452,68 @@ size_t slp_object_c::string_c::size() const {
     return 0;
   }
 
-  return parent_->view_->flags;
+  size_t start = 0;
+  return unit_extent(parent_->store_->data, *parent_->view_, start);
 }
 
 bool slp_object_c::string_c::empty() const { return size() == 0; }
 
 char slp_object_c::string_c::at(size_t index) const {
-  if (!is_valid_ || !parent_ || !parent_->view_) {
-    return '\0';
-  }
-
   if (index >= size()) {
     return '\0';
   }
+  return view()[index];
+}
 
-  size_t offsets_array_pos = static_cast<size_t>(parent_->view_->data.uint64);
-  const size_t *offsets_array =
-      reinterpret_cast<const size_t *>(&parent_->data_[offsets_array_pos]);
-
-  size_t target_offset = offsets_array[index];
+std::string slp_object_c::string_c::to_string() const {
+  return std::string(view());
+}
 
-  if (target_offset + sizeof(slp_unit_of_store_t) > parent_->data_.size()) {
-    return '\0';
+std::string_view slp_object_c::string_c::view() const {
+  if (!is_valid_ || !parent_ || !parent_->view_ ||
+      unit_field(*parent_->view_) == 0) {
+    return std::string_view();
   }
 
-  slp_unit_of_store_t *rune_unit = reinterpret_cast<slp_unit_of_store_t *>(
-      const_cast<std::uint8_t *>(&parent_->data_[target_offset]));
-
-  return static_cast<char>(rune_unit->data.uint32);
+  const slp_buffer_c &data = parent_->store_->data;
+  size_t start = 0;
+  size_t length = unit_extent(data, *parent_->view_, start);
+  return std::string_view(reinterpret_cast<const char *>(&data[start]),
+                          length);
 }
 
-std::string slp_object_c::string_c::to_string() const {
-  std::string result;
-  size_t len = size();
-  result.reserve(len);
+slp_object_c::slp_object_c() : view_(nullptr), root_offset_(0), hash_(0) {}
 
-  for (size_t i = 0; i < len; ++i) {
-    result += at(i);
+slp_object_c::slp_object_c(std::shared_ptr<const slp_store_s> store,
+                           size_t root_offset)
+    : store_(std::move(store)), view_(nullptr), root_offset_(root_offset),
+      hash_(0) {
+  if (store_ &&
+      root_offset_ + sizeof(slp_unit_of_store_t) <= store_->data.size()) {
+    view_ = reinterpret_cast<const slp_unit_of_store_t *>(
+        &store_->data[root_offset_]);
   }
-
-  return result;
 }
 
-slp_object_c::slp_object_c() : view_(nullptr), root_offset_(0) {}
-
 slp_object_c::~slp_object_c() { view_ = nullptr; }
 
 slp_object_c::slp_object_c(slp_object_c &&other) noexcept
-    : view_(nullptr), data_(std::move(other.data_)),
-      root_offset_(other.root_offset_), symbols_(std::move(other.symbols_)) {
-  if (root_offset_ < data_.size()) {
-    view_ = reinterpret_cast<slp_unit_of_store_t *>(&data_[root_offset_]);
-  }
+    : store_(std::move(other.store_)), view_(other.view_),
+      root_offset_(other.root_offset_), hash_(other.hash_) {
   other.view_ = nullptr;
   other.root_offset_ = 0;
+  other.hash_ = 0;
 }
 
 slp_object_c &slp_object_c::operator=(slp_object_c &&other) noexcept {
   if (this != &other) {
-    data_ = std::move(other.data_);
+    store_ = std::move(other.store_);
+    view_ = other.view_;
     root_offset_ = other.root_offset_;
-    symbols_ = std::move(other.symbols_);
-    if (root_offset_ < data_.size()) {
-      view_ = reinterpret_cast<slp_unit_of_store_t *>(&data_[root_offset_]);
-    } else {
-      view_ = nullptr;
-    }
+    hash_ = other.hash_;
     other.view_ = nullptr;
     other.root_offset_ = 0;
+    other.hash_ = 0;
   }
   return *this;
 }
@@ -553,33 +522,45 @@ slp_type_e slp_object_c::type() const {
   if (!view_) {
     return slp_type_e::NONE;
   }
-  return static_cast<slp_type_e>(view_->header & 0xFF);
+  return unit_type(*view_);
 }
 
 std::int64_t slp_object_c::as_int() const {
   if (!view_ || type() != slp_type_e::INTEGER) {
     return 0;
   }
-  return view_->data.int64;
+  if (!(unit_field(*view_) & SLP_UNIT_FLAG_WIDE)) {
+    return static_cast<std::int32_t>(view_->data);
+  }
+  return static_cast<std::int64_t>(unit_bits(store_->data, *view_));
 }
 
 double slp_object_c::as_real() const {
   if (!view_ || type() != slp_type_e::REAL) {
     return 0.0;
   }
-  return view_->data.float64;
+  std::uint64_t bits = unit_bits(store_->data, *view_);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
 }
 
 const char *slp_object_c::as_symbol() const {
   if (!view_ || type() != slp_type_e::SYMBOL) {
     return "";
   }
-  std::uint64_t symbol_id = view_->data.uint64;
-  auto it = symbols_.find(symbol_id);
-  if (it == symbols_.end()) {
+  const std::string *name = symbol_table().name(view_->data);
+  if (!name) {
     return "";
   }
-  return it->second.c_str();
+  return name->c_str();
+}
+
+std::uint64_t slp_object_c::as_symbol_id() const {
+  if (!view_ || type() != slp_type_e::SYMBOL) {
+    return 0;
+  }
+  return view_->data;
 }
 
 slp_object_c::list_c slp_object_c::as_list() const { return list_c(this); }
@@ -588,33 +569,491 @@ slp_object_c::string_c slp_object_c::as_string() const {
   return string_c(this);
 }
 
+slp_object_c slp_object_c::inner() const {
+  switch (type()) {
+  case slp_type_e::ABERRANT:
+    if (unit_field(*view_) & SLP_UNIT_FLAG_HANDLE) {
+      return slp_object_c();
+    }
+    [[fallthrough]];
+  case slp_type_e::SOME:
+  case slp_type_e::ERROR:
+  case slp_type_e::DATUM:
+    return view_at(unit_target(*view_));
+  default:
+    return slp_object_c();
+  }
+}
+
+std::uint64_t slp_object_c::as_handle() const {
+  if (type() != slp_type_e::ABERRANT ||
+      !(unit_field(*view_) & SLP_UNIT_FLAG_HANDLE)) {
+    return 0;
+  }
+  return unit_bits(store_->data, *view_);
+}
+
 bool slp_object_c::has_data() const {
-  return view_ != nullptr && !data_.empty();
+  return view_ != nullptr && !store_->data.empty();
 }
 
-const slp_buffer_c &slp_object_c::get_data() const { return data_; }
+const slp_buffer_c &slp_object_c::get_data() const {
+  static const slp_buffer_c empty_data;
+  return store_ ? store_->data : empty_data;
+}
 
-const std::map<std::uint64_t, std::string> &slp_object_c::get_symbols() const {
-  return symbols_;
+std::map<std::uint64_t, std::string> slp_object_c::get_symbols() const {
+  std::map<std::uint64_t, std::string> symbols;
+  if (!view_) {
+    return symbols;
+  }
+  for_each_unit(store_->data, root_offset_,
+                [&](const slp_unit_of_store_t &unit) {
+                  if (unit_type(unit) != slp_type_e::SYMBOL) {
+                    return;
+                  }
+                  const std::string *name = symbol_table().name(unit.data);
+                  symbols[unit.data] = name ? *name : "";
+                });
+  return symbols;
 }
 
 size_t slp_object_c::get_root_offset() const { return root_offset_; }
 
+namespace {
+
+// A number or handle by value, with -0.0 folded into 0.0 so reals that
+// compare equal hash equal
+std::uint64_t value_bits(const slp_buffer_c &data,
+                         const slp_unit_of_store_t &unit) {
+  std::uint64_t bits = unit_bits(data, unit);
+  if (unit_type(unit) == slp_type_e::REAL && bits == (1ull << 63)) {
+    return 0;
+  }
+  return bits;
+}
+
+/*
+    What a unit contributes to its tree's hash, without what it points at.
+    The walk is parents first and every list says how many elements follow,
+    so the sequence of contributions spells the tree out unambiguously.
+*/
+std::uint64_t mix_unit(std::uint64_t state, const slp_buffer_c &data,
+                       const slp_unit_of_store_t &unit) {
+  slp_type_e type = unit_type(unit);
+  state = mix_hash(state, static_cast<std::uint64_t>(type));
+  switch (type) {
+  case slp_type_e::PAREN_LIST:
+  case slp_type_e::BRACKET_LIST:
+  case slp_type_e::BRACE_LIST: {
+    size_t start = 0;
+    return mix_hash(state, unit_extent(data, unit, start));
+  }
+  case slp_type_e::DQ_LIST: {
+    size_t start = 0;
+    size_t length = unit_extent(data, unit, start);
+    return hash_bytes(state, length ? &data[start] : nullptr, length);
+  }
+  case slp_type_e::INTEGER:
+  case slp_type_e::REAL:
+    return mix_hash(state, value_bits(data, unit));
+  case slp_type_e::SYMBOL:
+    return mix_hash(state, unit.data);
+  case slp_type_e::ABERRANT:
+    if (unit_field(unit) & SLP_UNIT_FLAG_HANDLE) {
+      return mix_hash(mix_hash(state, SLP_UNIT_FLAG_HANDLE),
+                      value_bits(data, unit));
+    }
+    return state;
+  default:
+    return state;
+  }
+}
+
+bool units_equal(const slp_buffer_c &lhs_data, const slp_unit_of_store_t &lhs,
+                 const slp_buffer_c &rhs_data,
+                 const slp_unit_of_store_t &rhs) {
+  constexpr size_t unit_size = sizeof(slp_unit_of_store_t);
+  const bool same_store = &lhs_data == &rhs_data;
+
+  // Most comparisons are short and stop early; the pending pairs live on
+  // the stack until a tree is wide enough to need more
+  using pair_t =
+      std::pair<const slp_unit_of_store_t *, const slp_unit_of_store_t *>;
+  std::array<pair_t, 32> inline_pending;
+  std::vector<pair_t> spilled;
+  size_t depth = 0;
+  auto push = [&](const std::uint8_t *a, const std::uint8_t *b) {
+    pair_t pair{reinterpret_cast<const slp_unit_of_store_t *>(a),
+                reinterpret_cast<const slp_unit_of_store_t *>(b)};
+    if (depth < inline_pending.size()) {
+      inline_pending[depth] = pair;
+    } else {
+      spilled.push_back(pair);
+    }
+    depth++;
+  };
+
+  inline_pending[depth++] = {&lhs, &rhs};
+  while (depth > 0) {
+    depth--;
+    pair_t pair;
+    if (depth < inline_pending.size()) {
+      pair = inline_pending[depth];
+    } else {
+      pair = spilled.back();
+      spilled.pop_back();
+    }
+    auto [a, b] = pair;
+
+    // Equal units in one store point at the same things
+    if (same_store && a->header == b->header && a->data == b->data) {
+      continue;
+    }
+    slp_type_e type = unit_type(*a);
+    if (type != unit_type(*b)) {
+      return false;
+    }
+
+    switch (type) {
+    case slp_type_e::PAREN_LIST:
+    case slp_type_e::BRACKET_LIST:
+    case slp_type_e::BRACE_LIST: {
+      size_t a_start = 0;
+      size_t b_start = 0;
+      size_t count = unit_extent(lhs_data, *a, a_start);
+      if (count != unit_extent(rhs_data, *b, b_start)) {
+        return false;
+      }
+      for (size_t i = count; i > 0; i--) {
+        push(&lhs_data[a_start + (i - 1) * unit_size],
+             &rhs_data[b_start + (i - 1) * unit_size]);
+      }
+      break;
+    }
+    case slp_type_e::DQ_LIST: {
+      size_t a_start = 0;
+      size_t b_start = 0;
+      size_t length = unit_extent(lhs_data, *a, a_start);
+      if (length != unit_extent(rhs_data, *b, b_start)) {
+        return false;
+      }
+      if (length &&
+          std::memcmp(&lhs_data[a_start], &rhs_data[b_start], length) != 0) {
+        return false;
+      }
+      break;
+    }
+    case slp_type_e::INTEGER:
+    case slp_type_e::REAL:
+      if (value_bits(lhs_data, *a) != value_bits(rhs_data, *b)) {
+        return false;
+      }
+      break;
+    case slp_type_e::SYMBOL:
+      if (a->data != b->data) {
+        return false;
+      }
+      break;
+    case slp_type_e::ABERRANT: {
+      bool handle = unit_field(*a) & SLP_UNIT_FLAG_HANDLE;
+      if (handle != static_cast<bool>(unit_field(*b) & SLP_UNIT_FLAG_HANDLE)) {
+        return false;
+      }
+      if (handle) {
+        if (value_bits(lhs_data, *a) != value_bits(rhs_data, *b)) {
+          return false;
+        }
+        break;
+      }
+      [[fallthrough]];
+    }
+    case slp_type_e::SOME:
+    case slp_type_e::ERROR:
+    case slp_type_e::DATUM:
+      push(&lhs_data[unit_target(*a)], &rhs_data[unit_target(*b)]);
+      break;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+// What the subtree rooted at offset takes laid out fresh
+size_t subtree_bytes(const slp_buffer_c &data, size_t offset) {
+  size_t bytes = 0;
+  for_each_unit(data, offset, [&](const slp_unit_of_store_t &unit) {
+    // Elements are counted as units of their own
+    bytes += sizeof(slp_unit_of_store_t);
+    if (unit_is_wide(unit) || unit_is_long(unit)) {
+      bytes += sizeof(std::uint64_t);
+    }
+    if (unit_type(unit) == slp_type_e::DQ_LIST) {
+      size_t start = 0;
+      size_t length = unit_extent(data, unit, start);
+      bytes += (length + 7) & ~static_cast<size_t>(7);
+    }
+  });
+  return bytes;
+}
+
+// Room for count elements, 8 bytes in front of them for the count of a long
+// list and at least as many spare slots again when the list is growing
+size_t list_run(slp_builder_c &builder, size_t count, size_t previous,
+                size_t &capacity) {
+  capacity = count > previous ? std::max<size_t>(count * 2, 4) : count;
+  return builder.extend((capacity + 1) * sizeof(slp_unit_of_store_t)) +
+         sizeof(slp_unit_of_store_t);
+}
+
+// Points a list unit at count elements starting at start
+void point_list(slp_buffer_c &data, slp_unit_of_store_t &unit, size_t start,
+                size_t count) {
+  constexpr size_t unit_size = sizeof(slp_unit_of_store_t);
+  if (count == 0) {
+    unit = make_unit(unit_type(unit), 0, 0);
+    return;
+  }
+  if (count < SLP_UNIT_FIELD_LONG) {
+    unit = make_unit(unit_type(unit), static_cast<std::uint32_t>(count),
+                     static_cast<std::uint32_t>(start / unit_size));
+    return;
+  }
+  std::uint64_t long_count = count;
+  std::memcpy(&data[start - unit_size], &long_count, sizeof(long_count));
+  unit = make_unit(unit_type(unit), SLP_UNIT_FIELD_LONG,
+                   static_cast<std::uint32_t>(start / unit_size - 1));
+}
+
+} // namespace
+
+std::uint64_t slp_object_c::hash() const {
+  if (hash_) {
+    return hash_;
+  }
+  std::uint64_t state = 0;
+  if (view_) {
+    for_each_unit(store_->data, root_offset_,
+                  [&](const slp_unit_of_store_t &unit) {
+                    state = mix_unit(state, store_->data, unit);
+                  });
+  } else {
+    state = mix_hash(state, static_cast<std::uint64_t>(slp_type_e::NONE));
+  }
+  // 0 marks a hash not yet computed
+  hash_ = state ? state : 1;
+  return hash_;
+}
+
+bool slp_object_c::equals(const slp_object_c &other) const {
+  if (!view_ || !other.view_) {
+    return type() == other.type();
+  }
+  if (store_ == other.store_ && view_->header == other.view_->header &&
+      view_->data == other.view_->data) {
+    return true;
+  }
+  if (hash_ && other.hash_ && hash_ != other.hash_) {
+    return false;
+  }
+  return units_equal(store_->data, *view_, other.store_->data, *other.view_);
+}
+
+size_t slp_object_c::footprint() const {
+  if (!view_) {
+    return 0;
+  }
+  return subtree_bytes(store_->data, root_offset_);
+}
+
+slp_object_c slp_object_c::compact() const {
+  if (!view_) {
+    return share();
+  }
+  size_t bytes = footprint();
+  if (bytes == store_->data.size()) {
+    return share();
+  }
+
+  slp_builder_c builder;
+  builder.reserve(bytes);
+  return builder.take(builder.add_object(*this));
+}
+
+bool slp_object_c::set(size_t index, const slp_object_c &value) {
+  return index < as_list().size() && splice(index, 1, &value, 1);
+}
+
+bool slp_object_c::append(const slp_object_c &value) {
+  return splice(as_list().size(), 0, &value, 1);
+}
+
+bool slp_object_c::remove(size_t index) {
+  return index < as_list().size() && splice(index, 1, nullptr, 0);
+}
+
+bool slp_object_c::splice(size_t index, size_t remove_count,
+                          const slp_object_c *values, size_t count) {
+  constexpr size_t unit_size = sizeof(slp_unit_of_store_t);
+  if (!view_ || !is_list_type(unit_type(*view_))) {
+    return false;
+  }
+  size_t start = 0;
+  size_t size = unit_extent(store_->data, *view_, start);
+  if (index > size) {
+    return false;
+  }
+  remove_count = std::min(remove_count, size - index);
+  if (remove_count == 0 && count == 0) {
+    return true;
+  }
+  size_t new_size = size - remove_count + count;
+  size_t tail = size - index - remove_count;
+
+  bool owned = store_.use_count() == 1 && !store_->data.borrowed();
+  for (size_t i = 0; owned && i < count; i++) {
+    owned = values[i].store_ != store_;
+  }
+
+  if (!owned) {
+    slp_builder_c builder;
+    builder.reserve(footprint() + (new_size + 1) * unit_size);
+    slp_unit_of_store_t unit = *view_;
+    size_t capacity = 0;
+    size_t target = 0;
+    if (new_size) {
+      target = list_run(builder, new_size, size, capacity);
+      auto fill = [&](size_t slot, const slp_object_c &object) {
+        auto copied = builder.object_unit(object);
+        std::memcpy(builder.bytes(target + slot * unit_size), &copied,
+                    unit_size);
+      };
+      for (size_t i = 0; i < index; i++) {
+        fill(i, view_at(start + i * unit_size));
+      }
+      for (size_t i = 0; i < count; i++) {
+        fill(index + i, values[i]);
+      }
+      for (size_t i = 0; i < tail; i++) {
+        fill(index + count + i,
+             view_at(start + (index + remove_count + i) * unit_size));
+      }
+    }
+    size_t root = builder.place(unit);
+    auto copy = builder.take(root);
+    auto *store = const_cast<slp_store_s *>(copy.store_.get());
+    point_list(store->data,
+               *reinterpret_cast<slp_unit_of_store_t *>(&store->data[root]),
+               target, new_size);
+    store->spare_offset = target + new_size * unit_size;
+    store->spare_slots = capacity - new_size;
+    *this = std::move(copy);
+    return true;
+  }
+
+  auto *store = const_cast<slp_store_s *>(store_.get());
+  size_t capacity = size;
+  if (size && store->spare_offset == start + size * unit_size) {
+    capacity += store->spare_slots;
+  }
+  for (size_t i = index; i < index + remove_count; i++) {
+    store->unused += subtree_bytes(store->data, start + i * unit_size);
+  }
+
+  slp_builder_c builder(std::move(store->data));
+  size_t target = start;
+  if (new_size > capacity ||
+      (new_size >= SLP_UNIT_FIELD_LONG && !unit_is_long(*view_))) {
+    target = list_run(builder, new_size, size, capacity);
+    std::memcpy(builder.bytes(target), builder.bytes(start),
+                index * unit_size);
+    std::memcpy(builder.bytes(target + (index + count) * unit_size),
+                builder.bytes(start + (index + remove_count) * unit_size),
+                tail * unit_size);
+    store->unused += size * unit_size;
+  } else {
+    std::memmove(builder.bytes(start + (index + count) * unit_size),
+                 builder.bytes(start + (index + remove_count) * unit_size),
+                 tail * unit_size);
+    if (new_size < size) {
+      std::memset(builder.bytes(start + new_size * unit_size), 0,
+                  (size - new_size) * unit_size);
+    }
+  }
+  for (size_t i = 0; i < count; i++) {
+    auto copied = builder.object_unit(values[i]);
+    std::memcpy(builder.bytes(target + (index + i) * unit_size), &copied,
+                unit_size);
+  }
+  store->data = builder.release();
+
+  auto &unit =
+      *reinterpret_cast<slp_unit_of_store_t *>(&store->data[root_offset_]);
+  point_list(store->data, unit, target, new_size);
+  view_ = &unit;
+  hash_ = 0;
+  store->spare_offset = target + new_size * unit_size;
+  store->spare_slots = capacity - new_size;
+
+  if (store->unused * 2 > store->data.size()) {
+    *this = compact();
+  }
+  return true;
+}
+
+bool slp_object_c::set_int(std::int64_t value) {
+  if (!view_ || unit_type(*view_) != slp_type_e::INTEGER ||
+      store_.use_count() != 1 || store_->data.borrowed()) {
+    return false;
+  }
+  auto *store = const_cast<slp_store_s *>(store_.get());
+  auto &unit =
+      *reinterpret_cast<slp_unit_of_store_t *>(&store->data[root_offset_]);
+  if (unit_is_wide(unit)) {
+    std::memcpy(&store->data[unit_target(unit)], &value, sizeof(value));
+  } else if (value >= std::numeric_limits<std::int32_t>::min() &&
+             value <= std::numeric_limits<std::int32_t>::max()) {
+    unit.data = static_cast<std::uint32_t>(static_cast<std::int32_t>(value));
+  } else {
+    return false;
+  }
+  hash_ = 0;
+  return true;
+}
+
+slp_object_c slp_object_c::share() const {
+  slp_object_c shared(store_, root_offset_);
+  shared.hash_ = hash_;
+  return shared;
+}
+
+slp_object_c slp_object_c::view_at(size_t offset) const {
+  return slp_object_c(store_, offset);
+}
+
 slp_object_c
 slp_object_c::from_data(const slp_buffer_c &data,
                         const std::map<std::uint64_t, std::string> &symbols,
                         size_t root_offset) {
-  slp_object_c obj;
-  obj.data_ = data;
-  obj.symbols_ = symbols;
-  obj.root_offset_ = root_offset;
-
-  if (obj.root_offset_ < obj.data_.size()) {
-    obj.view_ = reinterpret_cast<slp_unit_of_store_t *>(
-        const_cast<std::uint8_t *>(&obj.data_[obj.root_offset_]));
+  auto store = std::make_shared<slp_store_s>();
+  store->data = data;
+
+  if (!symbols.empty() &&
+      root_offset + sizeof(slp_unit_of_store_t) <= store->data.size()) {
+    for_each_unit(store->data, root_offset, [&](slp_unit_of_store_t &unit) {
+      if (unit_type(unit) != slp_type_e::SYMBOL) {
+        return;
+      }
+      auto it = symbols.find(unit.data);
+      if (it != symbols.end()) {
+        unit.data =
+            static_cast<std::uint32_t>(symbol_table().intern(it->second));
+      }
+    });
   }
 
-  return obj;
+  return slp_object_c(std::move(store), root_offset);
 }
 
 slp_parse_result_c::slp_parse_result_c()
@@ -622,10 +1061,16 @@ slp_parse_result_c::slp_parse_result_c()
 
 slp_parse_result_c::~slp_parse_result_c() {}
 
-slp_parse_result_c parse(const std::string &source) {
+slp_parse_result_c parse(std::string_view source) {
+  size_t end = 0;
+  return parse_prefix(source, end);
+}
+
+slp_parse_result_c parse_prefix(std::string_view source, size_t &end) {
   parser_state_s state(source);
 
   auto result = parse_object(state);
+  end = state.pos;
 
   slp_parse_result_c parse_result;
 
@@ -634,7 +1079,7 @@ slp_parse_result_c parse(const std::string &source) {
     return parse_result;
   }
 
-  if (!result.unit_offset.has_value()) {
+  if (!result.unit.has_value()) {
     slp_parse_error_s err;
     err.error_code = slp_parse_error_e::MALFORMED_NUMERIC_LITERAL;
     err.message = "No object found in source";
@@ -643,71 +1088,387 @@ slp_parse_result_c parse(const std::string &source) {
     return parse_result;
   }
 
-  slp_object_c obj;
-  obj.data_ = std::move(state.data_buffer);
-  obj.root_offset_ = result.unit_offset.value();
-  obj.symbols_ = std::move(state.symbols);
+  parse_result.object_ =
+      state.builder.take(state.builder.place(result.unit.value()));
+
+  return parse_result;
+}
+
+namespace {
+
+// Segments smaller than this are not worth handing to a thread
+constexpr size_t parallel_segment_bytes = 64 * 1024;
+
+struct parse_segment_s {
+  slp_builder_c builder;
+  std::vector<slp_unit_of_store_t> roots;
+  size_t base{0};
+  bool failed{false};
+};
+
+// Calls fn(0) .. fn(count - 1) from up to `threads` threads, the caller's
+// included
+template <typename Fn> void run_parallel(size_t count, size_t threads, Fn &&fn) {
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next++; i < count; i = next++) {
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t i = 1; i < std::min(threads, count); i++) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : pool) {
+    thread.join();
+  }
+}
+
+/*
+    Follows the list opened at `open` through the structural index and
+    returns the position of its closing bracket, or npos if it never closes.
+    Along the way the position of a whitespace byte between two elements is
+    appended to `splits` about every `spacing` bytes. Only brackets, strings
+    and comments are tracked, so this runs far ahead of a real parse.
+
+    With `top_level` set the scan starts outside any list at `open` and
+    splits between top level forms instead. It then runs to the end of the
+    source and returns its size, or npos if a bracket is left unbalanced.
+*/
+size_t find_split_points(std::string_view source, size_t open, size_t spacing,
+                         std::vector<size_t> &splits, bool top_level = false) {
+  slp_structural_index_c index(source);
+  const size_t split_depth = top_level ? 0 : 1;
+  size_t depth = 0;
+  size_t pos = open;
+  size_t next_split = open + spacing;
+
+  while (true) {
+    if (depth == split_depth && pos >= next_split) {
+      // Whitespace before the next bracket lies between two elements unless
+      // it follows a prefix operator waiting for its object
+      size_t space = index.atom_end(pos);
+      if (space < index.structural(pos) &&
+          std::strchr("'@#?", source[space - 1]) == nullptr) {
+        splits.push_back(space);
+        next_split = space + spacing;
+      }
+    }
+
+    pos = index.structural(pos);
+    if (pos == source.size()) {
+      return top_level && depth == 0 ? pos : std::string_view::npos;
+    }
 
-  if (obj.root_offset_ < obj.data_.size()) {
-    obj.view_ =
-        reinterpret_cast<slp_unit_of_store_t *>(&obj.data_[obj.root_offset_]);
+    switch (source[pos]) {
+    case '(':
+    case '[':
+    case '{':
+      depth++;
+      pos++;
+      break;
+    case ')':
+    case ']':
+    case '}':
+      if (depth == 0) {
+        return std::string_view::npos;
+      }
+      if (--depth == 0 && !top_level) {
+        return pos;
+      }
+      pos++;
+      break;
+    case '"':
+      pos = index.string_special(pos + 1);
+      while (pos < source.size() && source[pos] == '\\') {
+        pos = index.string_special(pos + 2);
+      }
+      if (pos >= source.size()) {
+        return std::string_view::npos;
+      }
+      pos++;
+      break;
+    default: {
+      size_t newline = source.find('\n', pos);
+      if (newline == std::string_view::npos) {
+        return top_level && depth == 0 ? source.size()
+                                       : std::string_view::npos;
+      }
+      pos = newline + 1;
+      break;
+    }
+    }
   }
+}
 
-  parse_result.object_ = std::move(obj);
+// Parses every object in `source` into the segment's own builder
+void parse_segment(std::string_view source, parse_segment_s &segment) {
+  parser_state_s state(source);
+  state.flag_irregular_atoms = true;
 
-  return parse_result;
+  // Input the sequential parser rejects by throwing must not escape a worker
+  // thread; the caller re-parses in order and the exception surfaces there
+  try {
+    while (true) {
+      state.skip_whitespace_and_comments();
+      if (state.at_end()) {
+        break;
+      }
+      auto result = parse_object(state);
+      if (result.error.has_value() || !result.unit.has_value()) {
+        segment.failed = true;
+        return;
+      }
+      segment.roots.push_back(result.unit.value());
+    }
+  } catch (...) {
+    segment.failed = true;
+    return;
+  }
+
+  segment.failed = state.saw_irregular_atom;
+  segment.builder = std::move(state.builder);
 }
 
-slp_object_c create_string_direct(const std::string &str) {
-  parser_state_s state("");
+// Copies the segment to its base in `target` and rebases every offset in it
+void relocate_segment(parse_segment_s &segment, slp_builder_c &target) {
+  size_t size = segment.builder.size();
+  if (size == 0) {
+    return;
+  }
+  std::memcpy(target.bytes(segment.base), segment.builder.bytes(0), size);
+
+  struct view_s {
+    std::uint8_t *data;
+    size_t length;
+    size_t size() const { return length; }
+    std::uint8_t &operator[](size_t index) { return data[index]; }
+  } view{target.bytes(0), target.size()};
+
+  // Builders only ever write whole words, so every base is one
+  const auto base =
+      static_cast<std::uint32_t>(segment.base / sizeof(slp_unit_of_store_t));
+  for (auto &root : segment.roots) {
+    // Units are rebased before the walk follows them, so it always reads
+    // offsets that are already absolute
+    for_each_unit(view, root, [&](slp_unit_of_store_t &unit) {
+      if (unit_has_target(unit)) {
+        unit.data += base;
+      }
+    });
+  }
+}
 
-  std::vector<size_t> char_offsets;
+/*
+    Parses every top level form of `source` in order into `out` as one
+    bracket list, the unsplit path of parse_parallel_forms. Errors carry
+    their position in the whole source.
+*/
+std::optional<slp_parse_error_s> parse_forms(std::string_view source,
+                                             std::optional<slp_object_c> &out) {
+  parser_state_s state(source);
+  std::vector<slp_unit_of_store_t> roots;
 
-  for (unsigned char c : str) {
-    size_t rune_offset = allocate_unit(state, slp_type_e::RUNE);
-    state.get_unit(rune_offset)->data.uint32 = static_cast<std::uint32_t>(c);
-    char_offsets.push_back(rune_offset);
+  while (true) {
+    state.skip_whitespace_and_comments();
+    if (state.at_end()) {
+      break;
+    }
+    auto result = parse_object(state);
+    if (result.error.has_value()) {
+      return result.error;
+    }
+    if (!result.unit.has_value()) {
+      slp_parse_error_s err;
+      err.error_code = slp_parse_error_e::MALFORMED_NUMERIC_LITERAL;
+      err.message = "No object found in source";
+      err.byte_position = state.pos;
+      return err;
+    }
+    roots.push_back(result.unit.value());
   }
 
-  size_t list_offset = allocate_unit(state, slp_type_e::DQ_LIST);
-  size_t offsets_array_pos = 0;
+  out = state.builder.take(state.builder.place(state.builder.list_unit(
+      slp_type_e::BRACKET_LIST, roots.data(), roots.size())));
+  return std::nullopt;
+}
 
-  if (!char_offsets.empty()) {
-    offsets_array_pos = state.data_buffer.size();
-    for (size_t offset : char_offsets) {
-      state.data_buffer.insert(state.data_buffer.size(),
-                               reinterpret_cast<const std::uint8_t *>(&offset),
-                               sizeof(size_t));
+/*
+    Parses source[bounds[i], bounds[i + 1]) for every i on up to `threads`
+    threads and copies the pieces into `builder` one after another, leaving
+    the objects they held in `roots`. Returns false if any piece fails.
+*/
+bool parse_segments(std::string_view source, const std::vector<size_t> &bounds,
+                    size_t threads, slp_builder_c &builder,
+                    std::vector<slp_unit_of_store_t> &roots) {
+  std::vector<parse_segment_s> segments(bounds.size() - 1);
+  run_parallel(segments.size(), threads, [&](size_t i) {
+    parse_segment(source.substr(bounds[i], bounds[i + 1] - bounds[i]),
+                  segments[i]);
+  });
+
+  size_t total = 0;
+  size_t count = 0;
+  for (auto &segment : segments) {
+    if (segment.failed) {
+      return false;
     }
+    segment.base = total;
+    total += segment.builder.size();
+    count += segment.roots.size();
   }
 
-  slp_unit_of_store_t *list_unit = state.get_unit(list_offset);
-  list_unit->flags = static_cast<std::uint32_t>(char_offsets.size());
-  if (!char_offsets.empty()) {
-    list_unit->data.uint64 = static_cast<std::uint64_t>(offsets_array_pos);
+  builder.reserve(total + (count + 2) * sizeof(slp_unit_of_store_t));
+  builder.extend(total);
+  run_parallel(segments.size(), threads,
+               [&](size_t i) { relocate_segment(segments[i], builder); });
+
+  roots.reserve(count);
+  for (const auto &segment : segments) {
+    roots.insert(roots.end(), segment.roots.begin(), segment.roots.end());
+  }
+  return true;
+}
+
+} // namespace
+
+slp_parse_result_c parse_parallel(std::string_view source, size_t threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (threads < 2 || source.size() < 2 * parallel_segment_bytes) {
+    return parse(source);
   }
 
-  slp_object_c obj;
-  obj.data_ = std::move(state.data_buffer);
-  obj.root_offset_ = list_offset;
-  obj.symbols_ = std::move(state.symbols);
+  size_t open = 0;
+  {
+    parser_state_s probe(source);
+    probe.skip_whitespace_and_comments();
+    open = probe.pos;
+  }
+
+  slp_type_e type;
+  switch (open < source.size() ? source[open] : '\0') {
+  case '(':
+    type = slp_type_e::PAREN_LIST;
+    break;
+  case '[':
+    type = slp_type_e::BRACKET_LIST;
+    break;
+  case '{':
+    type = slp_type_e::BRACE_LIST;
+    break;
+  default:
+    return parse(source);
+  }
+
+  // A few segments per thread keeps threads busy when segments differ in cost
+  size_t spacing =
+      std::max(parallel_segment_bytes, source.size() / (threads * 4));
+  std::vector<size_t> bounds{open + 1};
+  size_t close = find_split_points(source, open, spacing, bounds);
+  if (close == std::string_view::npos) {
+    return parse(source);
+  }
+  bounds.push_back(close);
+
+  // Errors are reported with the positions and messages parse() gives them
+  slp_builder_c builder;
+  std::vector<slp_unit_of_store_t> roots;
+  if (!parse_segments(source, bounds, threads, builder, roots)) {
+    return parse(source);
+  }
+
+  slp_parse_result_c result;
+  result.object_ = builder.take(
+      builder.place(builder.list_unit(type, roots.data(), roots.size())));
+  return result;
+}
+
+slp_forms_result_c parse_parallel_forms(std::string_view source,
+                                        size_t threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  slp_forms_result_c result;
+  auto sequential = [&]() {
+    if (auto error = parse_forms(source, result.forms_)) {
+      result.error_ = error.value();
+    }
+    return std::move(result);
+  };
+
+  if (threads < 2 || source.size() < 2 * parallel_segment_bytes) {
+    return sequential();
+  }
+
+  size_t spacing =
+      std::max(parallel_segment_bytes, source.size() / (threads * 4));
+  std::vector<size_t> bounds{0};
+  if (find_split_points(source, 0, spacing, bounds, true) ==
+      std::string_view::npos) {
+    return sequential();
+  }
+  bounds.push_back(source.size());
+
+  slp_builder_c builder;
+  std::vector<slp_unit_of_store_t> roots;
+  if (!parse_segments(source, bounds, threads, builder, roots)) {
+    return sequential();
+  }
+
+  result.forms_ = builder.take(builder.place(builder.list_unit(
+      slp_type_e::BRACKET_LIST, roots.data(), roots.size())));
+  return result;
+}
+
+size_t slp_forms_result_c::size() const {
+  return forms_.has_value() ? forms_->as_list().size() : 0;
+}
+
+slp_object_c slp_forms_result_c::at(size_t index) const {
+  return forms_.value().as_list().at(index);
+}
+
+slp_object_c create_string_direct(const std::string &str) {
+  slp_builder_c builder;
+  return builder.take(builder.add_string(str));
+}
+
+namespace {
+
+slp_object_c create_list(slp_type_e type, const slp_object_c *objects,
+                         size_t count) {
+  slp_builder_c builder;
+  std::vector<size_t> element_offsets;
 
-  if (obj.root_offset_ < obj.data_.size()) {
-    obj.view_ =
-        reinterpret_cast<slp_unit_of_store_t *>(&obj.data_[obj.root_offset_]);
+  if (objects) {
+    element_offsets.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      element_offsets.push_back(builder.add_object(objects[i]));
+    }
   }
 
-  return obj;
+  return builder.take(builder.add_list(type, element_offsets.data(),
+                                       element_offsets.size()));
 }
 
+} // namespace
+
 slp_object_c slp_object_c::create_int(long long value) {
-  auto parse_result = parse(std::to_string(value));
-  return parse_result.take();
+  if (value >= constant_int_min && value <= constant_int_max) {
+    return constant_int(value);
+  }
+  slp_builder_c builder;
+  return builder.take(builder.add_int(value));
 }
 
 slp_object_c slp_object_c::create_real(double value) {
-  auto parse_result = parse(std::to_string(value));
-  return parse_result.take();
+  slp_builder_c builder;
+  return builder.take(builder.add_real(value));
 }
 
 slp_object_c slp_object_c::create_string(const std::string &value) {
@@ -715,106 +1476,43 @@ slp_object_c slp_object_c::create_string(const std::string &value) {
 }
 
 slp_object_c slp_object_c::create_symbol(const std::string &name) {
-  auto parse_result = parse(name);
-  return parse_result.take();
+  slp_builder_c builder;
+  return builder.take(builder.add_symbol(name));
 }
 
-slp_object_c slp_object_c::create_none() {
-  auto parse_result = parse("()");
-  return parse_result.take();
+slp_object_c slp_object_c::create_none() { return constant_none(); }
+
+slp_object_c slp_object_c::create_aberrant(std::uint64_t handle) {
+  slp_builder_c builder;
+  return builder.take(builder.add_handle(handle));
 }
 
-slp_object_c slp_object_c::create_paren_list(const slp_object_c *objects,
-                                             size_t count) {
-  if (!objects || count == 0) {
-    auto parse_result = parse("()");
-    return parse_result.take();
-  }
+slp_object_c slp_object_c::create_error(std::string_view message) {
+  slp_builder_c builder;
+  return builder.take(
+      builder.place(builder.wrapper_unit(slp_type_e::ERROR,
+                                         builder.string_unit(message))));
+}
 
-  std::string list_str = "(";
-  for (size_t i = 0; i < count; i++) {
-    const auto &elem = objects[i];
-    if (elem.type() == slp_type_e::INTEGER) {
-      list_str += std::to_string(elem.as_int());
-    } else if (elem.type() == slp_type_e::REAL) {
-      list_str += std::to_string(elem.as_real());
-    } else if (elem.type() == slp_type_e::DQ_LIST) {
-      list_str += "\"" + elem.as_string().to_string() + "\"";
-    } else if (elem.type() == slp_type_e::SYMBOL) {
-      list_str += elem.as_symbol();
-    } else {
-      list_str += "()";
-    }
-    if (i < count - 1) {
-      list_str += " ";
-    }
-  }
-  list_str += ")";
+slp_object_c slp_object_c::create_error(const slp_object_c &inner) {
+  slp_builder_c builder;
+  return builder.take(builder.place(
+      builder.wrapper_unit(slp_type_e::ERROR, builder.object_unit(inner))));
+}
 
-  auto parse_result = parse(list_str);
-  return parse_result.take();
+slp_object_c slp_object_c::create_paren_list(const slp_object_c *objects,
+                                             size_t count) {
+  return create_list(slp_type_e::PAREN_LIST, objects, count);
 }
 
 slp_object_c slp_object_c::create_bracket_list(const slp_object_c *objects,
                                                size_t count) {
-  if (!objects || count == 0) {
-    auto parse_result = parse("[]");
-    return parse_result.take();
-  }
-
-  std::string list_str = "[";
-  for (size_t i = 0; i < count; i++) {
-    const auto &elem = objects[i];
-    if (elem.type() == slp_type_e::INTEGER) {
-      list_str += std::to_string(elem.as_int());
-    } else if (elem.type() == slp_type_e::REAL) {
-      list_str += std::to_string(elem.as_real());
-    } else if (elem.type() == slp_type_e::DQ_LIST) {
-      list_str += "\"" + elem.as_string().to_string() + "\"";
-    } else if (elem.type() == slp_type_e::SYMBOL) {
-      list_str += elem.as_symbol();
-    } else {
-      list_str += "()";
-    }
-    if (i < count - 1) {
-      list_str += " ";
-    }
-  }
-  list_str += "]";
-
-  auto parse_result = parse(list_str);
-  return parse_result.take();
+  return create_list(slp_type_e::BRACKET_LIST, objects, count);
 }
 
 slp_object_c slp_object_c::create_brace_list(const slp_object_c *objects,
                                              size_t count) {
-  if (!objects || count == 0) {
-    auto parse_result = parse("{}");
-    return parse_result.take();
-  }
-
-  std::string list_str = "{";
-  for (size_t i = 0; i < count; i++) {
-    const auto &elem = objects[i];
-    if (elem.type() == slp_type_e::INTEGER) {
-      list_str += std::to_string(elem.as_int());
-    } else if (elem.type() == slp_type_e::REAL) {
-      list_str += std::to_string(elem.as_real());
-    } else if (elem.type() == slp_type_e::DQ_LIST) {
-      list_str += "\"" + elem.as_string().to_string() + "\"";
-    } else if (elem.type() == slp_type_e::SYMBOL) {
-      list_str += elem.as_symbol();
-    } else {
-      list_str += "()";
-    }
-    if (i < count - 1) {
-      list_str += " ";
-    }
-  }
-  list_str += "}";
-
-  auto parse_result = parse(list_str);
-  return parse_result.take();
+  return create_list(slp_type_e::BRACE_LIST, objects, count);
 }
 
-} // namespace slp
\ No newline at end of file
+} // namespace slp
@@ -2,8 +2,10 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "buffer.hpp"
 
@@ -14,33 +16,44 @@ namespace slp {
 typedef struct slp_unit_of_store_s slp_unit_of_store_t;
 
 class slp_parse_result_c;
+class slp_forms_result_c;
 class slp_object_c;
+class slp_builder_c;
+class slp_stream_parser_c;
+struct slp_image_loader_s;
 
-union data_u {
-  std::int8_t int8;
-  std::int16_t int16;
-  std::int32_t int32;
-  std::int64_t int64;
-  std::uint8_t uint8;
-  std::uint16_t uint16;
-  std::uint32_t uint32;
-  std::uint64_t uint64;
-  float float32;
-  double float64;
-  bool boolean;
-
-  slp_unit_of_store_t *typed_range; // Meaning that the data will consist of all
-                                    // unit of stores, sequentially
-
-  data_u *data_ptr; // SOME data. Think something similar to '()
-};
-
+/*
+    One node of a tree, 8 bytes. The low 8 bits of header are the type and
+    the 24 bits above them a field whose meaning depends on it; data is
+    either a value held inline or the offset of something else in the same
+    store, counted in 8 byte words (a store addresses 32GB).
+
+      lists      field: element count; data: offset of the elements, which
+                 are the units themselves laid out one after another
+      strings    field: byte length; data: offset of the bytes
+      INTEGER    data: the value, when it fits 32 bits
+      REAL       data: the value as a float, when that is exact
+      SYMBOL     data: the symbol id
+      wrappers   data: offset of the wrapped unit (SOME, ERROR, DATUM and
+                 an ABERRANT without SLP_UNIT_FLAG_HANDLE)
+
+    A number (or handle) that does not fit inline sets SLP_UNIT_FLAG_WIDE
+    and data holds the offset of an 8 byte slot with it. A list or string
+    too long for the field has SLP_UNIT_FIELD_LONG there and data points at
+    a 64 bit count, with the elements or bytes right after it. Empty lists
+    and strings point nowhere.
+*/
 struct slp_unit_of_store_s {
   std::uint32_t header;
-  std::uint32_t flags;
-  data_u data;
+  std::uint32_t data;
 };
 
+// Set on an ABERRANT unit whose data is an opaque runtime handle (a lambda id)
+// rather than the offset of a wrapped object
+inline constexpr std::uint32_t SLP_UNIT_FLAG_HANDLE = 1;
+inline constexpr std::uint32_t SLP_UNIT_FLAG_WIDE = 2;
+inline constexpr std::uint32_t SLP_UNIT_FIELD_LONG = 0xFFFFFF;
+
 enum class slp_type_e {
   NONE = 0,
   SOME = 1,
@@ -57,9 +70,31 @@ enum class slp_type_e {
   ABERRANT = 14,
 };
 
+/*
+    Immutable backing store for a parsed (or constructed) tree. Symbol units
+    hold ids from the process wide symbol table (symbols.hpp), so the store
+    is nothing but the buffer. Once an object
+    has been produced the store is never written again while more than one
+    object views it (list edits, below, write only a store they hold alone),
+    so any number of objects may view into it at once. Ownership is shared
+    and the store is released when the last object referencing it goes away.
+*/
+struct slp_store_s {
+  slp_buffer_c data;
+
+  // Keeps the memory a borrowed buffer views (a mapped image) alive
+  std::shared_ptr<const void> backing;
+
+  // Left by list edits: unused element slots right after the elements of
+  // the list edited last, and the bytes edits have left unreachable
+  size_t spare_offset{0};
+  size_t spare_slots{0};
+  size_t unused{0};
+};
+
 /*
     We dont actually copy the data into a new object, we just point at
-    the raw data, and then infer based on the "meta" how to read the data_u
+    the raw data, and then infer based on the "meta" how to read the unit
 
     The slp_object_c is a "functional" wrapper around this unit of data, meaning
     that it adds means to interact with/ understand the raw data
@@ -90,6 +125,9 @@ public:
     char at(size_t index) const;
     std::string to_string() const;
 
+    // Points into the backing store; valid while any object sharing it lives
+    std::string_view view() const;
+
   private:
     const slp_object_c *parent_;
     bool is_valid_;
@@ -106,14 +144,88 @@ public:
   std::int64_t as_int() const;
   double as_real() const;
   const char *as_symbol() const;
+  std::uint64_t as_symbol_id() const;
   list_c as_list() const;
   string_c as_string() const;
   bool has_data() const;
 
+  // The object a SOME, ERROR, DATUM or (non handle) ABERRANT wraps, viewed
+  // in the same store; an empty object for anything else
+  slp_object_c inner() const;
+
+  // The handle of an ABERRANT made by create_aberrant(), 0 for anything else
+  std::uint64_t as_handle() const;
+
+  /*
+      Structural identity. hash() covers the type and contents of the whole
+      tree (numbers by value, symbols by id, strings by bytes) so, like
+      symbol ids, it only means something within this process; it is
+      computed once per object and kept. equals() holds for trees of the
+      same shape and values whatever store or layout they sit in. Two views
+      of one unit, or identical units in one store (which a hash consing
+      builder makes of repeated subtrees), compare without a walk, and
+      objects whose hashes are already known and differ compare unequal
+      straight away.
+  */
+  std::uint64_t hash() const;
+  bool equals(const slp_object_c &other) const;
+
   const slp_buffer_c &get_data() const;
-  const std::map<std::uint64_t, std::string> &get_symbols() const;
   size_t get_root_offset() const;
 
+  // The id -> name pairs of every symbol reachable from this object. Ids are
+  // only meaningful within this process; pair with from_data() to move
+  // objects across processes.
+  std::map<std::uint64_t, std::string> get_symbols() const;
+
+  /*
+      O(1) views into the same backing store. share() views the same root,
+      view_at() views any other unit in the store (list elements, the inner
+      object of a SOME/ERROR/DATUM wrapper, etc). Nothing is copied.
+  */
+  slp_object_c share() const;
+  slp_object_c view_at(size_t offset) const;
+
+  /*
+      A view keeps its whole store alive, so one integer taken out of a large
+      parsed program pins every byte of it. compact() copies just the subtree
+      rooted here into a freshly laid out store of its own; when the store
+      already holds nothing else it is a share(). footprint() is the size
+      that store would have.
+  */
+  slp_object_c compact() const;
+  size_t footprint() const;
+
+  /*
+      Copy on write list edits. When this object is the only one viewing
+      its store the list is edited where it lies: elements shift within
+      their run, whatever a new element points at is appended to the store,
+      and a run that outgrows its slots moves to the end of the store with
+      as many again spare, so appending one at a time costs O(1) amortized.
+      Otherwise the list is first copied, edit applied, into a store of its
+      own (as compact() would) that later edits reuse; other views never see
+      a change. Either way string views and get_data() references taken from
+      this object before the edit are stale after it. Bytes left unreachable
+      by edits are reclaimed once they make up most of the store.
+
+      All return false and change nothing when this is not a list or index
+      is past the end (set and remove need an existing element); splice
+      clips remove_count to the elements there are.
+  */
+  bool set(size_t index, const slp_object_c &value);
+  bool append(const slp_object_c &value);
+  bool remove(size_t index);
+  bool splice(size_t index, size_t remove_count, const slp_object_c *values,
+              size_t count);
+
+  // Rewrites an INTEGER where it lies when this object is the only view of
+  // its store and the value is held the way the old one was (inline or
+  // wide). Returns false, changing nothing, otherwise; create_int() then.
+  bool set_int(std::int64_t value);
+
+  // Deep copies the given buffer into a fresh store. Prefer share()/view_at()
+  // when the buffer already belongs to an object. When `symbols` is non-empty
+  // the symbol ids in the copy are remapped by name to this process's ids.
   static slp_object_c
   from_data(const slp_buffer_c &data,
             const std::map<std::uint64_t, std::string> &symbols,
@@ -124,6 +236,13 @@ public:
   static slp_object_c create_string(const std::string &value);
   static slp_object_c create_symbol(const std::string &name);
   static slp_object_c create_none();
+  static slp_object_c create_aberrant(std::uint64_t handle);
+
+  // An ERROR wrapping the string `message`, or a copy of `inner`, built
+  // without going through text. Fixed runtime errors want constant_error
+  // (constants.hpp) instead.
+  static slp_object_c create_error(std::string_view message);
+  static slp_object_c create_error(const slp_object_c &inner);
   static slp_object_c create_paren_list(const slp_object_c *objects,
                                         size_t count);
   static slp_object_c create_bracket_list(const slp_object_c *objects,
@@ -132,13 +251,15 @@ public:
                                         size_t count);
 
 private:
-  slp_unit_of_store_t *view_;
-  slp_buffer_c data_;
+  std::shared_ptr<const slp_store_s> store_;
+  const slp_unit_of_store_t *view_;
   size_t root_offset_;
-  std::map<std::uint64_t, std::string> symbols_;
+  mutable std::uint64_t hash_;
 
-  friend slp_parse_result_c parse(const std::string &source);
-  friend slp_object_c create_string_direct(const std::string &str);
+  slp_object_c(std::shared_ptr<const slp_store_s> store, size_t root_offset);
+
+  friend class slp_builder_c;
+  friend struct slp_image_loader_s;
   friend class ::slp_test_accessor;
 };
 
@@ -176,10 +297,70 @@ private:
   std::optional<slp_parse_error_s> error_;
   std::optional<slp_object_c> object_;
 
-  friend slp_parse_result_c parse(const std::string &source);
+  friend slp_parse_result_c parse_prefix(std::string_view source,
+                                         size_t &end);
+  friend slp_parse_result_c parse_parallel(std::string_view source,
+                                           size_t threads);
+  friend class slp_stream_parser_c;
 };
 
-extern slp_parse_result_c parse(const std::string &source);
+extern slp_parse_result_c parse(std::string_view source);
+
+// Parses the first object in source and sets end to the byte just past the
+// text consumed. Anything after it is left alone, which is what lets
+// slp_stream_parser_c (stream.hpp) walk a source one object at a time.
+extern slp_parse_result_c parse_prefix(std::string_view source, size_t &end);
+
+/*
+    Same result as parse() for a source whose first object is a list, built
+    with the list's elements parsed on `threads` threads (0 for one per
+    core). A bracket and quote aware scan cuts the list between elements,
+    each piece is parsed into a buffer of its own, and the pieces are copied
+    into one store with their offsets rebased. Small sources, sources that
+    are not a list, and anything the pieces fail on are parsed by parse()
+    so errors read the same. Like parse(), anything after the first object
+    is ignored; see parse_parallel_forms() for sources of many forms.
+*/
+extern slp_parse_result_c parse_parallel(std::string_view source,
+                                         size_t threads = 0);
+
+/*
+    Every top level object of a source, in order. The forms are views into
+    one store; at() is O(1) and copies nothing.
+*/
+class slp_forms_result_c {
+public:
+  slp_forms_result_c() = default;
+  slp_forms_result_c(const slp_forms_result_c &) = delete;
+  slp_forms_result_c &operator=(const slp_forms_result_c &) = delete;
+  slp_forms_result_c(slp_forms_result_c &&) noexcept = default;
+  slp_forms_result_c &operator=(slp_forms_result_c &&) noexcept = default;
+
+  bool is_error() const { return error_.has_value(); }
+  bool is_success() const { return !error_.has_value(); }
+  const slp_parse_error_s &error() const { return error_.value(); }
+  size_t size() const;
+  slp_object_c at(size_t index) const;
+
+private:
+  std::optional<slp_parse_error_s> error_;
+  std::optional<slp_object_c> forms_;
+
+  friend slp_forms_result_c parse_parallel_forms(std::string_view source,
+                                                 size_t threads);
+};
+
+/*
+    Parses a source written as a sequence of top level forms (a data file
+    with one form per record, say), every form in one result. The same scan
+    parse_parallel() uses cuts the source between forms instead of between
+    list elements, and the pieces are parsed on `threads` threads and
+    stitched the same way. Small sources and anything the pieces fail on are
+    parsed in order, so an error carries its position in the whole source
+    as slp_stream_parser_c would report it. An empty source has no forms.
+*/
+extern slp_forms_result_c parse_parallel_forms(std::string_view source,
+                                               size_t threads = 0);
 
 extern slp_object_c create_string_direct(const std::string &str);
 
@@ -0,0 +1,186 @@
+#include "slp/stream.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace slp {
+
+namespace {
+
+// Mapped pages behind the parser are released in steps of at least this much
+constexpr size_t release_threshold = 1024 * 1024;
+
+// Advances pos past whitespace and comments. in_comment is left set when the
+// text ends inside a comment.
+void skip_blank(std::string_view text, size_t &pos, bool &in_comment) {
+  in_comment = false;
+  while (pos < text.size()) {
+    char c = text[pos];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      pos++;
+    } else if (c == ';') {
+      size_t newline = text.find('\n', pos);
+      if (newline == std::string_view::npos) {
+        pos = text.size();
+        in_comment = true;
+      } else {
+        pos = newline + 1;
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+} // namespace
+
+slp_stream_parser_c::slp_stream_parser_c(read_fn_t read_fn, size_t chunk_size)
+    : read_fn_(std::move(read_fn)),
+      chunk_size_(std::max<size_t>(1, chunk_size)) {}
+
+slp_stream_parser_c::slp_stream_parser_c(std::string_view source)
+    : source_(source), eof_(true) {}
+
+slp_stream_parser_c::~slp_stream_parser_c() {
+  if (mapped_) {
+    munmap(mapped_, source_.size());
+  }
+}
+
+std::unique_ptr<slp_stream_parser_c>
+slp_stream_parser_c::open_file(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    ::close(fd);
+    return nullptr;
+  }
+
+  size_t size = static_cast<size_t>(info.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return std::make_unique<slp_stream_parser_c>(std::string_view());
+  }
+
+  void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    return nullptr;
+  }
+  madvise(mapped, size, MADV_SEQUENTIAL);
+
+  auto parser = std::make_unique<slp_stream_parser_c>(
+      std::string_view(static_cast<const char *>(mapped), size));
+  parser->mapped_ = mapped;
+  return parser;
+}
+
+std::optional<slp_stream_form_s> slp_stream_parser_c::next() {
+  while (!done_) {
+    auto text = pending();
+
+    size_t start = 0;
+    bool in_comment = false;
+    skip_blank(text, start, in_comment);
+
+    if (start == text.size()) {
+      if (eof_) {
+        done_ = true;
+        break;
+      }
+      // A comment running off the end of the window is kept so its tail is
+      // not read as code once more input arrives
+      if (!in_comment) {
+        consume(start);
+      }
+      fill();
+      continue;
+    }
+
+    size_t end = 0;
+    auto result = parse_prefix(text.substr(start), end);
+    end += start;
+
+    // Anything that reached the end of the window (an atom, an unclosed list)
+    // may carry on in input not read yet
+    if (end == text.size() && !eof_) {
+      fill();
+      continue;
+    }
+
+    std::uint64_t position = pending_position() + start;
+    if (result.is_error()) {
+      result.error_->byte_position += static_cast<std::uint32_t>(position);
+      done_ = true;
+    }
+
+    consume(end);
+    return slp_stream_form_s{position, std::move(result)};
+  }
+
+  return std::nullopt;
+}
+
+std::string_view slp_stream_parser_c::pending() const {
+  if (chunked()) {
+    return std::string_view(window_).substr(window_consumed_);
+  }
+  return source_.substr(source_consumed_);
+}
+
+std::uint64_t slp_stream_parser_c::pending_position() const {
+  if (chunked()) {
+    return window_position_ + window_consumed_;
+  }
+  return source_consumed_;
+}
+
+void slp_stream_parser_c::consume(size_t count) {
+  if (chunked()) {
+    window_consumed_ += count;
+    return;
+  }
+
+  source_consumed_ += count;
+  if (mapped_) {
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t behind = source_consumed_ / page * page;
+    if (behind - released_ >= release_threshold) {
+      madvise(static_cast<char *>(mapped_) + released_, behind - released_,
+              MADV_DONTNEED);
+      released_ = behind;
+    }
+  }
+}
+
+void slp_stream_parser_c::fill() {
+  window_.erase(0, window_consumed_);
+  window_position_ += window_consumed_;
+  window_consumed_ = 0;
+
+  // Reading at least as much again as is already held keeps re-parsing an
+  // object that spans many chunks linear overall
+  size_t held = window_.size();
+  size_t want = std::max(chunk_size_, held);
+  window_.resize(held + want);
+
+  size_t got = 0;
+  while (got < want) {
+    size_t count = read_fn_(window_.data() + held + got, want - got);
+    if (count == 0) {
+      eof_ = true;
+      break;
+    }
+    got += count;
+  }
+  window_.resize(held + got);
+}
+
+} // namespace slp
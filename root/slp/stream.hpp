@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "slp.hpp"
+
+namespace slp {
+
+struct slp_stream_form_s {
+  std::uint64_t byte_position;
+  slp_parse_result_c result;
+};
+
+/*
+    Parses a source holding any number of top level objects, one object per
+    call to next(). Each object gets a store of its own and only the text of
+    the object being parsed has to be held at once: a chunked reader's window
+    is trimmed to the unparsed tail after every object, and pages of a mapped
+    file are handed back to the kernel once the parser is past them. Peak
+    memory follows the largest single object, not the size of the source.
+
+    Parse errors end the stream; their byte_position is relative to the start
+    of the source like the position of every form.
+*/
+class slp_stream_parser_c {
+public:
+  // Fills buffer with at most capacity bytes, returning 0 at end of input
+  typedef std::function<size_t(char *buffer, size_t capacity)> read_fn_t;
+
+  static constexpr size_t default_chunk_size = 64 * 1024;
+
+  explicit slp_stream_parser_c(read_fn_t read_fn,
+                               size_t chunk_size = default_chunk_size);
+
+  // Parses memory the caller keeps alive for the lifetime of the parser
+  explicit slp_stream_parser_c(std::string_view source);
+
+  ~slp_stream_parser_c();
+
+  slp_stream_parser_c(const slp_stream_parser_c &) = delete;
+  slp_stream_parser_c &operator=(const slp_stream_parser_c &) = delete;
+
+  // Maps the file read only; returns nullptr if it can not be opened or mapped
+  static std::unique_ptr<slp_stream_parser_c>
+  open_file(const std::string &path);
+
+  // The next top level object, or nullopt once the input is exhausted or an
+  // error has been returned
+  std::optional<slp_stream_form_s> next();
+
+private:
+  read_fn_t read_fn_;
+  size_t chunk_size_{default_chunk_size};
+
+  // Chunked input: window_[window_consumed_..] is the unparsed text and
+  // window_position_ is the source position of window_[0]
+  std::string window_;
+  size_t window_consumed_{0};
+  std::uint64_t window_position_{0};
+
+  // Memory input, mapped_ is set when the parser owns a mapping of it
+  std::string_view source_;
+  size_t source_consumed_{0};
+  void *mapped_{nullptr};
+  size_t released_{0};
+
+  bool eof_{false};
+  bool done_{false};
+
+  bool chunked() const { return static_cast<bool>(read_fn_); }
+  std::string_view pending() const;
+  std::uint64_t pending_position() const;
+  void consume(size_t count);
+  void fill();
+};
+
+} // namespace slp
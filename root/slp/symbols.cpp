@@ -0,0 +1,72 @@
+#include "slp/symbols.hpp"
+#include <stdexcept>
+
+namespace slp {
+
+slp_symbol_table_c::slp_symbol_table_c() : count_(0) {}
+
+slp_symbol_table_c::~slp_symbol_table_c() = default;
+
+std::uint64_t slp_symbol_table_c::intern(std::string_view name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = ids_.find(name);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+
+  std::uint64_t index = count_.load(std::memory_order_relaxed);
+  std::size_t chunk = static_cast<std::size_t>(index >> CHUNK_BITS);
+  if (chunk >= MAX_CHUNKS) {
+    throw std::runtime_error("slp symbol table is full");
+  }
+  if (!chunks_[chunk]) {
+    chunks_[chunk] = std::make_unique<std::string[]>(CHUNK_SIZE);
+  }
+
+  std::string &slot = chunks_[chunk][index & (CHUNK_SIZE - 1)];
+  slot.assign(name.data(), name.size());
+
+  std::uint64_t id = index + 1;
+  ids_.emplace(std::string_view(slot), id);
+  count_.store(index + 1, std::memory_order_release);
+  return id;
+}
+
+std::uint64_t slp_symbol_table_c::find(std::string_view name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = ids_.find(name);
+  return it == ids_.end() ? 0 : it->second;
+}
+
+const std::string *slp_symbol_table_c::name(std::uint64_t id) const {
+  if (id == 0 || id > count_.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  std::uint64_t index = id - 1;
+  return &chunks_[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+}
+
+std::uint64_t slp_symbol_table_c::size() const {
+  return count_.load(std::memory_order_acquire);
+}
+
+namespace {
+slp_symbol_table_c *g_bound_table = nullptr;
+}
+
+slp_symbol_table_c &symbol_table() {
+  if (g_bound_table) {
+    return *g_bound_table;
+  }
+  static slp_symbol_table_c table;
+  return table;
+}
+
+void bind_symbol_table(slp_symbol_table_c *table) { g_bound_table = table; }
+
+} // namespace slp
+
+extern "C" void slp_bind_symbol_table(void *table) {
+  slp::bind_symbol_table(static_cast<slp::slp_symbol_table_c *>(table));
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace slp {
+
+/*
+    Process wide intern table for symbol names. Every SYMBOL unit stores the
+    id handed out here, so identical names share one id across every parse
+    and every object, and consumers can compare and key on the integer.
+
+    Ids start at 1 and are never reused; 0 is never a valid symbol. Interning
+    takes a lock, looking a name up by id does not.
+*/
+class slp_symbol_table_c {
+public:
+  slp_symbol_table_c();
+  ~slp_symbol_table_c();
+
+  slp_symbol_table_c(const slp_symbol_table_c &) = delete;
+  slp_symbol_table_c &operator=(const slp_symbol_table_c &) = delete;
+
+  std::uint64_t intern(std::string_view name);
+
+  // 0 if the name has never been interned
+  std::uint64_t find(std::string_view name) const;
+
+  // nullptr for unknown ids
+  const std::string *name(std::uint64_t id) const;
+
+  std::uint64_t size() const;
+
+private:
+  static constexpr std::size_t CHUNK_BITS = 12;
+  static constexpr std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_BITS;
+  static constexpr std::size_t MAX_CHUNKS = 4096;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string_view, std::uint64_t> ids_;
+  std::unique_ptr<std::string[]> chunks_[MAX_CHUNKS];
+  std::atomic<std::uint64_t> count_;
+};
+
+// The table used by the parser, builders and objects in this image
+extern slp_symbol_table_c &symbol_table();
+
+/*
+    Points this image at another table. Kernels link their own copy of slp,
+    so the runtime binds every loaded kernel to its table (through the
+    exported slp_bind_symbol_table) to keep ids consistent across the
+    boundary. Must happen before the image interns anything.
+*/
+extern void bind_symbol_table(slp_symbol_table_c *table);
+
+} // namespace slp
+
+extern "C" void slp_bind_symbol_table(void *table);
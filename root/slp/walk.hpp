@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "slp.hpp"
+
+namespace slp {
+
+/*
+    Reading units as slp.hpp lays them out. Offsets are bytes here; the
+    conversion to and from the words a unit stores happens only in these
+    helpers.
+*/
+inline slp_type_e unit_type(const slp_unit_of_store_t &unit) {
+  return static_cast<slp_type_e>(unit.header & 0xFF);
+}
+
+inline std::uint32_t unit_field(const slp_unit_of_store_t &unit) {
+  return unit.header >> 8;
+}
+
+inline size_t unit_target(const slp_unit_of_store_t &unit) {
+  return static_cast<size_t>(unit.data) * sizeof(slp_unit_of_store_t);
+}
+
+inline slp_unit_of_store_t make_unit(slp_type_e type, std::uint32_t field,
+                                     std::uint32_t data) {
+  return slp_unit_of_store_t{static_cast<std::uint32_t>(type) | (field << 8),
+                             data};
+}
+
+inline bool is_list_type(slp_type_e type) {
+  return type == slp_type_e::PAREN_LIST || type == slp_type_e::BRACKET_LIST ||
+         type == slp_type_e::BRACE_LIST;
+}
+
+// A number or handle held in an 8 byte slot of its own
+inline bool unit_is_wide(const slp_unit_of_store_t &unit) {
+  switch (unit_type(unit)) {
+  case slp_type_e::INTEGER:
+  case slp_type_e::REAL:
+    return (unit_field(unit) & SLP_UNIT_FLAG_WIDE) != 0;
+  case slp_type_e::ABERRANT:
+    return (unit_field(unit) & SLP_UNIT_FLAG_HANDLE) &&
+           (unit_field(unit) & SLP_UNIT_FLAG_WIDE);
+  default:
+    return false;
+  }
+}
+
+// A list or string whose count sits in front of its contents
+inline bool unit_is_long(const slp_unit_of_store_t &unit) {
+  return (is_list_type(unit_type(unit)) ||
+          unit_type(unit) == slp_type_e::DQ_LIST) &&
+         unit_field(unit) == SLP_UNIT_FIELD_LONG;
+}
+
+// Whether data is an offset into the store rather than a value
+inline bool unit_has_target(const slp_unit_of_store_t &unit) {
+  switch (unit_type(unit)) {
+  case slp_type_e::PAREN_LIST:
+  case slp_type_e::BRACKET_LIST:
+  case slp_type_e::BRACE_LIST:
+  case slp_type_e::DQ_LIST:
+    return unit_field(unit) != 0;
+  case slp_type_e::INTEGER:
+  case slp_type_e::REAL:
+    return unit_is_wide(unit);
+  case slp_type_e::ABERRANT:
+    return !(unit_field(unit) & SLP_UNIT_FLAG_HANDLE) || unit_is_wide(unit);
+  case slp_type_e::SOME:
+  case slp_type_e::ERROR:
+  case slp_type_e::DATUM:
+    return true;
+  default:
+    return false;
+  }
+}
+
+inline std::uint64_t read_word(const std::uint8_t *at) {
+  std::uint64_t value;
+  std::memcpy(&value, at, sizeof(value));
+  return value;
+}
+
+// Folds value into a running structural hash
+inline std::uint64_t mix_hash(std::uint64_t state, std::uint64_t value) {
+  state ^= value + 0x9e3779b97f4a7c15ull + (state << 6) + (state >> 2);
+  state ^= state >> 31;
+  return state * 0xbf58476d1ce4e5b9ull;
+}
+
+inline std::uint64_t hash_bytes(std::uint64_t state, const std::uint8_t *at,
+                                size_t size) {
+  state = mix_hash(state, size);
+  size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    state = mix_hash(state, read_word(at + i));
+  }
+  if (i < size) {
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, at + i, size - i);
+    state = mix_hash(state, tail);
+  }
+  return state;
+}
+
+/*
+    Element count of a list or byte length of a string, with start set to
+    the offset of the first element or byte. data must hold everything the
+    unit points at.
+*/
+template <typename Buffer>
+size_t unit_extent(Buffer &data, const slp_unit_of_store_t &unit,
+                   size_t &start) {
+  std::uint32_t field = unit_field(unit);
+  start = unit_target(unit);
+  if (field != SLP_UNIT_FIELD_LONG) {
+    return field;
+  }
+  size_t count = static_cast<size_t>(read_word(&data[start]));
+  start += sizeof(std::uint64_t);
+  return count;
+}
+
+// The 64 bits of an INTEGER, REAL or handle, wherever they are held
+template <typename Buffer>
+std::uint64_t unit_bits(Buffer &data, const slp_unit_of_store_t &unit) {
+  if (unit_field(unit) & SLP_UNIT_FLAG_WIDE) {
+    return read_word(&data[unit_target(unit)]);
+  }
+  switch (unit_type(unit)) {
+  case slp_type_e::INTEGER:
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(
+        static_cast<std::int32_t>(unit.data)));
+  case slp_type_e::REAL: {
+    float narrow;
+    std::memcpy(&narrow, &unit.data, sizeof(narrow));
+    double value = narrow;
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+  default:
+    return unit.data;
+  }
+}
+
+/*
+    Visits every unit reachable from `root`, parents before children. Lists
+    (and wrapped objects) are followed through their offsets; strings and
+    lambda handles have nothing below them. fn sees a unit before its
+    children are looked up, so it may rewrite the offsets being followed.
+    root itself need not live in data.
+*/
+template <typename Buffer, typename Unit, typename Fn>
+void for_each_unit(Buffer &data, Unit &root, Fn &&fn)
+  requires std::is_same_v<std::remove_const_t<Unit>, slp_unit_of_store_t>
+{
+  using unit_t = std::conditional_t<std::is_const_v<Buffer>,
+                                    const slp_unit_of_store_t,
+                                    slp_unit_of_store_t>;
+  constexpr size_t unit_size = sizeof(slp_unit_of_store_t);
+  const size_t size = data.size();
+
+  std::vector<unit_t *> pending{&root};
+  while (!pending.empty()) {
+    unit_t &unit = *pending.back();
+    pending.pop_back();
+    fn(unit);
+
+    if (!unit_has_target(unit)) {
+      continue;
+    }
+    size_t target = unit_target(unit);
+    switch (unit_type(unit)) {
+    case slp_type_e::PAREN_LIST:
+    case slp_type_e::BRACKET_LIST:
+    case slp_type_e::BRACE_LIST: {
+      if (target + sizeof(std::uint64_t) > size) {
+        break;
+      }
+      size_t start = 0;
+      size_t count = unit_extent(data, unit, start);
+      if (start > size || (size - start) / unit_size < count) {
+        break;
+      }
+      for (size_t i = count; i > 0; i--) {
+        pending.push_back(
+            reinterpret_cast<unit_t *>(&data[start + (i - 1) * unit_size]));
+      }
+      break;
+    }
+    case slp_type_e::ABERRANT:
+      if (unit_field(unit) & SLP_UNIT_FLAG_HANDLE) {
+        break;
+      }
+      [[fallthrough]];
+    case slp_type_e::SOME:
+    case slp_type_e::ERROR:
+    case slp_type_e::DATUM:
+      if (target + unit_size <= size) {
+        pending.push_back(reinterpret_cast<unit_t *>(&data[target]));
+      }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+template <typename Buffer, typename Fn>
+void for_each_unit(Buffer &data, size_t offset, Fn &&fn) {
+  using unit_t = std::conditional_t<std::is_const_v<Buffer>,
+                                    const slp_unit_of_store_t,
+                                    slp_unit_of_store_t>;
+  if (offset + sizeof(slp_unit_of_store_t) > data.size()) {
+    return;
+  }
+  for_each_unit(data, *reinterpret_cast<unit_t *>(&data[offset]),
+                std::forward<Fn>(fn));
+}
+
+} // namespace slp
@@ -13,6 +13,7 @@ void usage() {
   fmt::print("SXS - SXS Language Runtime and Meta-Compiler\n\n");
   fmt::print("Usage:\n");
   fmt::print("  sxs [options] <file.sxs>              Run a script\n");
+  fmt::print("  sxs [options] <image>                 Run a compiled image\n");
   fmt::print("  sxs <command> [options] [args]        Run a command\n\n");
   fmt::print("Script Options:\n");
   fmt::print("  -w, --working-dir <path>   Set working directory\n");
@@ -30,7 +31,7 @@ void usage() {
   fmt::print("  deps [dir]                 Show project dependencies\n");
   fmt::print("  check <file|dir>           Type check code (stub)\n");
   fmt::print("  test [dir]                 Run tests (stub)\n");
-  fmt::print("  compile <file> -o <out>    Compile program (stub)\n");
+  fmt::print("  compile <file> -o <out>    Compile program to an image\n");
   fmt::print("  kernel list [dir]          List kernels (stub)\n");
   fmt::print("  kernel info <name>         Show kernel info (stub)\n");
   fmt::print("  kernel build <name>        Build kernel (stub)\n");
@@ -53,52 +54,63 @@ void version() {
   );
 }
 
-int run_script(int argc, char **argv, int start_idx) {
+struct script_args_s {
+  std::string file_path;
+  std::string output_path;
+  std::string working_directory;
+  std::vector<std::string> include_paths;
+  spdlog::level::level_enum log_level = spdlog::level::info;
+};
+
+bool parse_script_args(int argc, char **argv, int start_idx,
+                       script_args_s &out) {
   if (start_idx >= argc) {
     fmt::print("Error: No script file specified\n");
-    return 2;
+    return false;
   }
 
-  std::string file_path = argv[start_idx];
-  std::string working_directory = fs::current_path().string();
-  std::vector<std::string> include_paths;
-  spdlog::level::level_enum log_level = spdlog::level::info;
+  out.file_path = argv[start_idx];
+  out.working_directory = fs::current_path().string();
 
   for (int i = start_idx + 1; i < argc; i++) {
     std::string arg = argv[i];
     if (arg == "-w" || arg == "--working-dir") {
       if (i + 1 < argc) {
-        working_directory = argv[++i];
+        out.working_directory = argv[++i];
       }
     } else if (arg == "-i" || arg == "--include") {
       if (i + 1 < argc) {
-        include_paths.push_back(argv[++i]);
+        out.include_paths.push_back(argv[++i]);
+      }
+    } else if (arg == "-o" || arg == "--output") {
+      if (i + 1 < argc) {
+        out.output_path = argv[++i];
       }
     } else if (arg == "-v" || arg == "--verbose") {
-      log_level = spdlog::level::debug;
+      out.log_level = spdlog::level::debug;
     } else if (arg == "-q" || arg == "--quiet") {
-      log_level = spdlog::level::err;
+      out.log_level = spdlog::level::err;
     } else if (arg == "-l" || arg == "--log-level") {
       if (i + 1 < argc) {
         std::string level_str = argv[++i];
         if (level_str == "trace")
-          log_level = spdlog::level::trace;
+          out.log_level = spdlog::level::trace;
         else if (level_str == "debug")
-          log_level = spdlog::level::debug;
+          out.log_level = spdlog::level::debug;
         else if (level_str == "info")
-          log_level = spdlog::level::info;
+          out.log_level = spdlog::level::info;
         else if (level_str == "warn")
-          log_level = spdlog::level::warn;
+          out.log_level = spdlog::level::warn;
         else if (level_str == "error")
-          log_level = spdlog::level::err;
+          out.log_level = spdlog::level::err;
         else if (level_str == "critical")
-          log_level = spdlog::level::critical;
+          out.log_level = spdlog::level::critical;
       }
     }
   }
 
-  if (!fs::path(file_path).is_absolute()) {
-    file_path = fs::absolute(file_path).string();
+  if (!fs::path(out.file_path).is_absolute()) {
+    out.file_path = fs::absolute(out.file_path).string();
   }
 
   const char *sxs_home = std::getenv("SXS_HOME");
@@ -107,24 +119,33 @@ int run_script(int argc, char **argv, int start_idx) {
     if (fs::exists(kernel_path)) {
       std::string kernel_path_str = kernel_path.string();
       bool already_added = false;
-      for (const auto &path : include_paths) {
+      for (const auto &path : out.include_paths) {
         if (fs::equivalent(path, kernel_path_str)) {
           already_added = true;
           break;
         }
       }
       if (!already_added) {
-        include_paths.push_back(kernel_path_str);
+        out.include_paths.push_back(kernel_path_str);
       }
     }
   }
 
+  return true;
+}
+
+int run_script(int argc, char **argv, int start_idx) {
+  script_args_s args;
+  if (!parse_script_args(argc, argv, start_idx, args)) {
+    return 2;
+  }
+
   auto logger = spdlog::stdout_color_mt("sxs");
-  logger->set_level(log_level);
+  logger->set_level(args.log_level);
 
-  pkg::core::option_s options{.file_path = file_path,
-                              .include_paths = include_paths,
-                              .working_directory = working_directory,
+  pkg::core::option_s options{.file_path = args.file_path,
+                              .include_paths = args.include_paths,
+                              .working_directory = args.working_directory,
                               .logger = logger};
 
   try {
@@ -136,6 +157,33 @@ int run_script(int argc, char **argv, int start_idx) {
   }
 }
 
+int compile_program(int argc, char **argv, int start_idx) {
+  script_args_s args;
+  if (!parse_script_args(argc, argv, start_idx, args)) {
+    return 2;
+  }
+  if (args.output_path.empty()) {
+    fmt::print("Error: 'compile' requires an output file (-o <out>)\n");
+    return 2;
+  }
+
+  auto logger = spdlog::stdout_color_mt("sxs");
+  logger->set_level(args.log_level);
+
+  pkg::core::option_s options{.file_path = args.file_path,
+                              .include_paths = args.include_paths,
+                              .working_directory = args.working_directory,
+                              .logger = logger};
+
+  try {
+    pkg::core::core_c core(options);
+    return core.compile(args.output_path);
+  } catch (const std::exception &e) {
+    logger->error("Fatal error: {}", e.what());
+    return 1;
+  }
+}
+
 void stub_command(const std::string &command) {
   fmt::print("TODO: Command '{}' not yet implemented\n", command);
   fmt::print("This is a stub. Full implementation coming soon.\n");
@@ -246,8 +294,7 @@ int main(int argc, char **argv) {
   }
 
   if (first_arg == "compile") {
-    stub_command("compile");
-    return 0;
+    return compile_program(argc, argv, 2);
   }
 
   if (first_arg == "kernel") {
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/core.h>
+#include <string>
+
+/*
+    Minimal timing helpers shared by the benchmark executables. Benchmarks are
+    plain programs that print a table; they are built with the tests but are
+    not registered with ctest.
+*/
+namespace bench {
+
+template <typename T> inline void keep(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/*
+    Runs `fn` `rounds` times and returns the best wall time in nanoseconds.
+    Best-of is used rather than the mean so that a noisy neighbour does not
+    skew the scaling numbers.
+*/
+template <typename Fn> inline double best_ns(std::size_t rounds, Fn &&fn) {
+  double best = 0;
+  for (std::size_t i = 0; i < rounds; i++) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+    if (i == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+inline void header(const std::string &title) {
+  fmt::print("\n== {} ==\n", title);
+}
+
+} // namespace bench
@@ -0,0 +1,140 @@
+#include <bench.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <core/kernels/kernels.hpp>
+#include <slp/slp.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+std::size_t heap_allocations = 0;
+} // namespace
+
+// Counts every heap allocation the program makes, so the loops below can
+// report how many each call costs
+void *operator new(std::size_t size) {
+  heap_allocations++;
+  if (void *block = std::malloc(size ? size : 1)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept { std::free(block); }
+
+void operator delete(void *block, std::size_t) noexcept { std::free(block); }
+
+namespace {
+
+template <typename Fn> double allocations_per(std::size_t count, Fn &&fn) {
+  std::size_t before = heap_allocations;
+  for (std::size_t i = 0; i < count; i++) {
+    fn(i);
+  }
+  return static_cast<double>(heap_allocations - before) /
+         static_cast<double>(count);
+}
+
+/*
+    Stand-in for the alu kernel so the benchmark does not need a built and
+    installed dylib. The body mirrors alu_add in kernels/alu/alu.cpp.
+*/
+class alu_kernel_context_c : public pkg::core::kernels::kernel_context_if {
+public:
+  alu_kernel_context_c() {
+    add_.return_type = slp::slp_type_e::INTEGER;
+    add_.variadic = false;
+    add_.function = [](pkg::core::callable_context_if &context,
+                       slp::slp_object_c &args) -> slp::slp_object_c {
+      auto list = args.as_list();
+      if (list.size() < 3) {
+        return slp::slp_object_c::create_int(0);
+      }
+      auto lhs = list.at(1);
+      auto rhs = list.at(2);
+      auto a = context.eval(lhs).as_int();
+      auto b = context.eval(rhs).as_int();
+      return slp::slp_object_c::create_int(a + b);
+    };
+  }
+
+  bool is_load_allowed() override { return false; }
+  bool attempt_load(const std::string &) override { return false; }
+  void lock() override {}
+  bool has_function(const std::string &name) const override {
+    return name == "alu/add";
+  }
+  pkg::core::callable_symbol_s *get_function(const std::string &name) override {
+    return name == "alu/add" ? &add_ : nullptr;
+  }
+
+private:
+  pkg::core::callable_symbol_s add_;
+};
+
+} // namespace
+
+int main() {
+  constexpr std::size_t calls = 200000;
+
+  bench::header("scalar result construction (per object)");
+
+  double direct_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < calls; i++) {
+      auto obj = slp::slp_object_c::create_int(static_cast<long long>(i));
+      bench::keep(obj);
+    }
+  });
+  double reparse_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < calls; i++) {
+      auto obj = slp::parse(std::to_string(i)).take();
+      bench::keep(obj);
+    }
+  });
+  double real_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < calls; i++) {
+      auto obj = slp::slp_object_c::create_real(static_cast<double>(i) / 3.0);
+      bench::keep(obj);
+    }
+  });
+
+  fmt::print("{:<32} {:>10.1f} ns\n", "create_int (builder)",
+             direct_ns / calls);
+  fmt::print("{:<32} {:>10.1f} ns\n", "parse(to_string(v)) reference",
+             reparse_ns / calls);
+  fmt::print("{:<32} {:>10.1f} ns\n", "create_real (builder)",
+             real_ns / calls);
+  fmt::print("{:<32} {:>10.2f}\n", "create_int heap allocations",
+             allocations_per(calls, [](std::size_t i) {
+               auto obj =
+                   slp::slp_object_c::create_int(static_cast<long long>(i));
+               bench::keep(obj);
+             }));
+
+  bench::header("(alu/add a b) through the interpreter (per call)");
+
+  alu_kernel_context_c kernel_context;
+  auto interpreter = pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols(),
+      &kernel_context);
+
+  auto call = slp::parse("(alu/add 40 2)").take();
+  double call_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < calls; i++) {
+      auto site = call.share();
+      auto result = interpreter->eval(site);
+      bench::keep(result);
+    }
+  });
+  fmt::print("{:<32} {:>10.1f} ns\n", "alu/add literal args", call_ns / calls);
+  fmt::print("{:<32} {:>10.2f}\n", "alu/add heap allocations",
+             allocations_per(calls, [&](std::size_t) {
+               auto site = call.share();
+               auto result = interpreter->eval(site);
+               bench::keep(result);
+             }));
+
+  return 0;
+}
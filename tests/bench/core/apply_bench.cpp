@@ -0,0 +1,50 @@
+#include <bench.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <slp/slp.hpp>
+
+#include <string>
+
+namespace {
+
+constexpr std::size_t evals = 20000;
+
+// A lambda taking `arity` ints, and an apply of it to a brace list of them
+void run(pkg::core::callable_context_if &interpreter, std::size_t arity) {
+  std::string name = "take-" + std::to_string(arity);
+  std::string params;
+  std::string args;
+  for (std::size_t i = 0; i < arity; i++) {
+    params += " a" + std::to_string(i) + " :int";
+    args += " " + std::to_string(i);
+  }
+  auto define = slp::parse("(def " + name + " (fn (" + params + ") :int [a0]))")
+                    .take();
+  interpreter.eval(define);
+
+  auto form = slp::parse("(apply " + name + " {" + args + "})").take();
+  double ns = bench::best_ns(5, [&]() {
+                for (std::size_t i = 0; i < evals; i++) {
+                  auto site = form.share();
+                  auto result = interpreter.eval(site);
+                  bench::keep(result);
+                }
+              }) /
+              evals;
+  fmt::print("{:<10} {:>12.1f} {:>12.1f}\n", arity, ns,
+             ns / static_cast<double>(arity));
+}
+
+} // namespace
+
+int main() {
+  auto interpreter = pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols());
+
+  bench::header("apply (ns per call)");
+  fmt::print("{:<10} {:>12} {:>12}\n", "arguments", "ns", "ns/argument");
+  for (std::size_t arity : {1, 4, 16, 64}) {
+    run(*interpreter, arity);
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <bench.hpp>
+#include <core/instructions/datum.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <core/kernels/kernels.hpp>
+#include <slp/slp.hpp>
+#include <slp/symbols.hpp>
+
+namespace {
+
+/*
+    Accepts every load without touching the filesystem so the benchmark
+    measures datum dispatch rather than dlopen.
+*/
+class accepting_kernel_context_c : public pkg::core::kernels::kernel_context_if {
+public:
+  bool is_load_allowed() override { return true; }
+  bool attempt_load(const std::string &) override { return true; }
+  void lock() override {}
+  bool has_function(const std::string &) const override { return false; }
+  pkg::core::callable_symbol_s *get_function(const std::string &) override {
+    return nullptr;
+  }
+};
+
+} // namespace
+
+int main() {
+  constexpr std::size_t evals = 200000;
+
+  accepting_kernel_context_c kernel_context;
+  auto interpreter = pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols(),
+      &kernel_context);
+
+  bench::header("datum evaluation (per eval)");
+
+  auto define_form = slp::parse("#(define-form point {:int :int})").take();
+  double define_form_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < evals; i++) {
+      auto site = define_form.share();
+      auto result = interpreter->eval(site);
+      bench::keep(result);
+    }
+  });
+
+  auto load = slp::parse("#(load \"alu\" \"io\")").take();
+  double load_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < evals; i++) {
+      auto site = load.share();
+      auto result = interpreter->eval(site);
+      bench::keep(result);
+    }
+  });
+
+  fmt::print("{:<32} {:>10.1f} ns\n", "#(define-form ...)",
+             define_form_ns / evals);
+  fmt::print("{:<32} {:>10.1f} ns\n", "#(load ...) two kernels",
+             load_ns / evals);
+
+  bench::header("datum lookup (per lookup)");
+
+  auto symbol = slp::symbol_table().intern("define-form");
+  double table_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < evals; i++) {
+      auto callable = pkg::core::datum::find_datum_callable(symbol);
+      bench::keep(callable);
+    }
+  });
+  double rebuilt_ns = bench::best_ns(5, [&]() {
+    for (std::size_t i = 0; i < evals; i++) {
+      auto symbols = pkg::core::datum::get_standard_callable_symbols();
+      auto it = symbols.find("define-form");
+      bench::keep(it->second.return_type);
+    }
+  });
+
+  fmt::print("{:<32} {:>10.1f} ns\n", "static id table", table_ns / evals);
+  fmt::print("{:<32} {:>10.1f} ns\n", "rebuilt string map (old)",
+             rebuilt_ns / evals);
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include <bench.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <slp/slp.hpp>
+
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t evals = 200000;
+
+double per_eval(pkg::core::callable_context_if &interpreter,
+                const char *source) {
+  auto form = slp::parse(source).take();
+  return bench::best_ns(5, [&]() {
+           for (std::size_t i = 0; i < evals; i++) {
+             auto site = form.share();
+             auto result = interpreter.eval(site);
+             bench::keep(result);
+           }
+         }) /
+         evals;
+}
+
+void pair(pkg::core::callable_context_if &interpreter, const char *label,
+          const char *success, const char *failure) {
+  double ok = per_eval(interpreter, success);
+  double error = per_eval(interpreter, failure);
+  fmt::print("{:<20} {:>12.1f} {:>12.1f} {:>8.2f}x\n", label, ok, error,
+             error / ok);
+}
+
+// The same failing form caught by the script's recover, where it unwinds
+// through the pending error, and by the host, where it is thrown
+void raised(pkg::core::callable_context_if &interpreter, const char *label,
+            const char *failure) {
+  auto recovered_source =
+      std::string("(recover [") + failure + "] [$exception])";
+  double recovered = per_eval(interpreter, recovered_source.c_str());
+
+  auto form = slp::parse(failure).take();
+  double thrown = bench::best_ns(5, [&]() {
+                    for (std::size_t i = 0; i < evals; i++) {
+                      auto site = form.share();
+                      try {
+                        interpreter.eval(site);
+                      } catch (const std::runtime_error &error) {
+                        bench::keep(error);
+                      }
+                    }
+                  }) /
+                  evals;
+  fmt::print("{:<20} {:>12.1f} {:>12.1f} {:>8.2f}x\n", label, recovered,
+             thrown, thrown / recovered);
+}
+
+} // namespace
+
+int main() {
+  auto interpreter = pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols());
+
+  auto setup = slp::parse(R"([
+    (def items '(1 2 3 4))
+    (def typed (fn (x :int) :int [x]))
+    (def mistyped (fn (x :int) :int ["text"]))
+    (def fail-0 (fn () :int [(assert 0 "failed") 0]))
+    (def fail-1 (fn () :int [(def r (fail-0)) r]))
+    (def fail-2 (fn () :int [(def r (fail-1)) r]))
+    (def fail-3 (fn () :int [(def r (fail-2)) r]))
+  ])")
+                   .take();
+  interpreter->eval(setup);
+
+  bench::header("success vs error result (ns per eval)");
+  fmt::print("{:<20} {:>12} {:>12} {:>9}\n", "form", "success", "error",
+             "ratio");
+
+  pair(*interpreter, "at", "(at 2 items)", "(at 9 items)");
+  pair(*interpreter, "match", "(match 2 (1 10) (2 20))",
+       "(match 3 (1 10) (2 20))");
+  pair(*interpreter, "lambda return", "(typed 1)", "(mistyped 1)");
+
+  bench::header("recovered vs thrown error (ns per eval)");
+  fmt::print("{:<20} {:>12} {:>12} {:>9}\n", "form", "recovered", "thrown",
+             "ratio");
+
+  raised(*interpreter, "assert", "(assert 0 \"failed\")");
+  raised(*interpreter, "arity", "(typed 1 2)");
+  raised(*interpreter, "lambda depth 1", "(fail-0)");
+  raised(*interpreter, "lambda depth 4", "(fail-3)");
+
+  return 0;
+}
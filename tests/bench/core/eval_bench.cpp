@@ -0,0 +1,56 @@
+#include <bench.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <slp/slp.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t evals = 20000;
+
+// Evaluates `(eval rule-N)` round robin over `working_set` distinct rules
+void run(pkg::core::callable_context_if &interpreter, const char *label,
+         std::size_t working_set) {
+  std::vector<slp::slp_object_c> calls;
+  for (std::size_t i = 0; i < working_set; i++) {
+    auto name = fmt::format("rule-{}-{}", working_set, i);
+    auto define =
+        slp::parse("(def " + name + " \"[(def limit " + std::to_string(i) +
+                   ") (match limit (0 \\\"zero\\\") (limit (eq limit " +
+                   std::to_string(i) + ")))]\")")
+            .take();
+    interpreter.eval(define);
+    calls.push_back(slp::parse("(eval " + name + ")").take());
+  }
+
+  auto before = interpreter.get_eval_cache_stats();
+  double ns = bench::best_ns(5, [&]() {
+                for (std::size_t i = 0; i < evals; i++) {
+                  auto site = calls[i % working_set].share();
+                  auto result = interpreter.eval(site);
+                  bench::keep(result);
+                }
+              }) /
+              evals;
+  auto after = interpreter.get_eval_cache_stats();
+  fmt::print("{:<20} {:>10.1f} {:>10} {:>10}\n", label, ns,
+             after.hits - before.hits, after.misses - before.misses);
+}
+
+} // namespace
+
+int main() {
+  auto interpreter = pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols());
+
+  bench::header("eval of stored code strings (ns per eval)");
+  fmt::print("{:<20} {:>10} {:>10} {:>10}\n", "working set", "ns", "hits",
+             "misses");
+  run(*interpreter, "1 string", 1);
+  run(*interpreter, "8 strings", 8);
+  // Larger than the cache, so every eval parses
+  run(*interpreter, "256 strings", 256);
+  return 0;
+}
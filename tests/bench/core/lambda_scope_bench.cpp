@@ -0,0 +1,55 @@
+#include <bench.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <slp/slp.hpp>
+
+namespace {
+
+constexpr std::size_t iterations = 10000;
+
+/*
+    Every do iteration and every lambda call pushes and pops a scope. The
+    cost per iteration should not depend on how many unrelated lambdas are
+    alive in outer scopes.
+*/
+double loop_ns(std::size_t alive_lambdas) {
+  auto interpreter = pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols());
+
+  auto lambda = slp::parse("(fn (x :int) :int [x])").take();
+  for (std::size_t i = 0; i < alive_lambdas; i++) {
+    auto site = lambda.share();
+    auto handle = interpreter->eval(site);
+    bench::keep(handle);
+  }
+
+  auto setup = slp::parse("(def step (fn (x :int) :int [x]))").take();
+  interpreter->eval(setup);
+
+  auto loop = slp::parse(fmt::format(
+                             "(do [(step $iterations) (if (eq $iterations {}) "
+                             "(done 0) 0)])",
+                             iterations))
+                  .take();
+
+  return bench::best_ns(3, [&]() {
+    auto site = loop.share();
+    auto result = interpreter->eval(site);
+    bench::keep(result);
+  });
+}
+
+} // namespace
+
+int main() {
+  bench::header("do loop calling a lambda (ns/iteration should stay flat)");
+  fmt::print("{:<14} {:>14} {:>14}\n", "alive lambdas", "total ns",
+             "ns/iteration");
+
+  for (std::size_t alive : {0, 1000, 10000, 100000}) {
+    double ns = loop_ns(alive);
+    fmt::print("{:<14} {:>14.0f} {:>14.1f}\n", alive, ns, ns / iterations);
+  }
+
+  return 0;
+}
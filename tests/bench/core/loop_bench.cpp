@@ -0,0 +1,127 @@
+#include <bench.hpp>
+#include <core/instructions/generation/generation.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <core/kernels/kernels.hpp>
+#include <core/vm/vm.hpp>
+#include <slp/slp.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+std::size_t heap_allocations = 0;
+} // namespace
+
+// Counts every heap allocation the program makes, so each loop can report
+// how many an iteration costs
+void *operator new(std::size_t size) {
+  heap_allocations++;
+  if (void *block = std::malloc(size ? size : 1)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept { std::free(block); }
+
+void operator delete(void *block, std::size_t) noexcept { std::free(block); }
+
+namespace {
+
+/*
+    Stand-in for the alu kernel so the benchmark does not need a built and
+    installed dylib. The body mirrors alu_add in kernels/alu/alu.cpp.
+*/
+class alu_kernel_context_c : public pkg::core::kernels::kernel_context_if {
+public:
+  alu_kernel_context_c() {
+    add_.return_type = slp::slp_type_e::INTEGER;
+    add_.variadic = false;
+    add_.function = [](pkg::core::callable_context_if &context,
+                       slp::slp_object_c &args) -> slp::slp_object_c {
+      auto list = args.as_list();
+      if (list.size() < 3) {
+        return slp::slp_object_c::create_int(0);
+      }
+      auto lhs = list.at(1);
+      auto rhs = list.at(2);
+      auto a = context.eval(lhs).as_int();
+      auto b = context.eval(rhs).as_int();
+      return slp::slp_object_c::create_int(a + b);
+    };
+  }
+
+  bool is_load_allowed() override { return false; }
+  bool attempt_load(const std::string &) override { return false; }
+  void lock() override {}
+  bool has_function(const std::string &name) const override {
+    return name == "alu/add";
+  }
+  pkg::core::callable_symbol_s *get_function(const std::string &name) override {
+    return name == "alu/add" ? &add_ : nullptr;
+  }
+
+private:
+  pkg::core::callable_symbol_s add_;
+};
+
+} // namespace
+
+int main() {
+  constexpr std::size_t iterations = 1000000;
+
+  alu_kernel_context_c kernel_context;
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols, &kernel_context);
+
+  auto run = [&](const char *label, const std::string &source) {
+    auto loop = slp::parse(source).take();
+    std::int64_t last = 0;
+    std::size_t before = heap_allocations;
+    double ns = bench::best_ns(3, [&]() {
+      auto site = loop.share();
+      last = interpreter->eval(site).as_int();
+    });
+    // best_ns ran the loop three times
+    double allocations = static_cast<double>(heap_allocations - before) /
+                         static_cast<double>(3 * iterations);
+    fmt::print("{:<28} {:>10.1f} {:>12.2f} {:>10}\n", label,
+               ns / iterations, allocations, last);
+  };
+
+  // The same loop compiled to bytecode and run on the vm
+  auto run_vm = [&](const char *label, const std::string &source) {
+    auto loop = slp::parse(source).take();
+    pkg::core::instructions::generation::generator_c generator(symbols);
+    auto image = pkg::core::vm::load_image(
+        pkg::core::vm::serialize_image(generator.generate(loop)));
+    auto context = pkg::core::create_interpreter(symbols, &kernel_context);
+    pkg::core::vm::vm_c machine(*context, std::move(image), symbols);
+    std::int64_t last = 0;
+    std::size_t before = heap_allocations;
+    double ns = bench::best_ns(3, [&]() { last = machine.run().as_int(); });
+    double allocations = static_cast<double>(heap_allocations - before) /
+                         static_cast<double>(3 * iterations);
+    fmt::print("{:<28} {:>10.1f} {:>12.2f} {:>10}\n", label,
+               ns / iterations, allocations, last);
+  };
+
+  auto n = std::to_string(iterations);
+  bench::header("do loop, 1M iterations (per iteration)");
+  fmt::print("{:<28} {:>10} {:>12} {:>10}\n", "body", "ns", "allocations",
+             "result");
+  run("exit test only",
+      "(do [(if (eq $iterations " + n + ") (done $iterations) 0)])");
+  run("alu/add and exit test", "(do [(alu/add $iterations 1) (if (eq "
+                               "$iterations " +
+                                   n + ") (done $iterations) 0)])");
+  run_vm("vm: exit test only",
+         "(do [(if (eq $iterations " + n + ") (done $iterations) 0)])");
+  run_vm("vm: alu/add and exit test", "(do [(alu/add $iterations 1) (if (eq "
+                                      "$iterations " +
+                                          n + ") (done $iterations) 0)])");
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include <bench.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <slp/slp.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+std::size_t heap_allocations = 0;
+} // namespace
+
+// Counts every heap allocation the program makes, so each run can report
+// how many a call costs
+void *operator new(std::size_t size) {
+  heap_allocations++;
+  if (void *block = std::malloc(size ? size : 1)) {
+    return block;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept { std::free(block); }
+
+void operator delete(void *block, std::size_t) noexcept { std::free(block); }
+
+int main() {
+  constexpr std::int64_t calls = 100000;
+
+  // Stand-in for alu/sub so the benchmark needs no installed kernel
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  pkg::core::callable_symbol_s dec;
+  dec.return_type = slp::slp_type_e::INTEGER;
+  dec.function = [](pkg::core::callable_context_if &context,
+                    slp::slp_object_c &args_list) -> slp::slp_object_c {
+    auto list = args_list.as_list();
+    auto arg = list.at(1);
+    return slp::slp_object_c::create_int(context.eval(arg).as_int() - 1);
+  };
+  symbols["dec"] = dec;
+
+  auto interpreter = pkg::core::create_interpreter(symbols);
+  auto setup = slp::parse(R"([
+    (def count-down (fn (n :int) :int [
+      (if (eq n 0) 0 (count-down (dec n)))
+    ]))
+    (def is-even (fn (n :int) :int [
+      (if (eq n 0) 1 [ (is-odd (dec n)) ])
+    ]))
+    (def is-odd (fn (n :int) :int [
+      (if (eq n 0) 0 [ (is-even (dec n)) ])
+    ]))
+    (def nested (fn (n :int) :int [
+      (if (eq n 0) 0 [ (def r (nested (dec n))) r ])
+    ]))
+  ])")
+                   .take();
+  interpreter->eval(setup);
+
+  auto run = [&](const char *label, const std::string &source,
+                 std::int64_t per_run) {
+    auto call = slp::parse(source).take();
+    std::int64_t last = 0;
+    std::size_t before = heap_allocations;
+    double ns = bench::best_ns(3, [&]() {
+      auto site = call.share();
+      last = interpreter->eval(site).as_int();
+    });
+    // best_ns ran the call three times
+    double allocations = static_cast<double>(heap_allocations - before) /
+                         static_cast<double>(3 * per_run);
+    fmt::print("{:<26} {:>10.1f} {:>12.2f} {:>8}\n", label, ns / per_run,
+               allocations, last);
+  };
+
+  auto n = std::to_string(calls);
+  bench::header("lambda recursion (per call)");
+  fmt::print("{:<26} {:>10} {:>12} {:>8}\n", "shape", "ns", "allocations",
+             "result");
+  run("self tail call", "(count-down " + n + ")", calls);
+  run("mutual tail call", "(is-even " + n + ")", calls);
+  // Not a tail call, so it still nests; kept shallow
+  run("non-tail, depth 1000", "(nested 1000)", 1000);
+  return 0;
+}
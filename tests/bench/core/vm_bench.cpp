@@ -0,0 +1,59 @@
+#include <bench.hpp>
+#include <core/instructions/generation/generation.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <core/vm/vm.hpp>
+#include <slp/slp.hpp>
+
+int main() {
+  constexpr std::size_t iterations = 20000;
+  constexpr std::size_t calls_per_iteration = 8;
+
+  // The outer do gives every run a fresh scope for `step`. eq is costly on
+  // its own, so each iteration makes several calls to keep it from
+  // dominating.
+  std::string calls;
+  for (std::size_t i = 0; i < calls_per_iteration; i++) {
+    calls += "(step $iterations (pick 1 \"a\" \"b\")) ";
+  }
+  auto source = fmt::format(R"([
+    (do [
+      (def pick (fn (flag :int a :str b :str) :str [(if flag a b)]))
+      (def step (fn (x :int s :str) :int [x]))
+      (do [
+        {}
+        (if (eq $iterations {}) (done 0) 0)
+      ])
+      (done 0)
+    ])
+  ])",
+                            calls, iterations);
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto program = slp::parse(source).take();
+
+  bench::header("do loop making 16 lambda calls (per iteration)");
+
+  auto walker = pkg::core::create_interpreter(symbols);
+  double walk_ns = bench::best_ns(3, [&]() {
+    auto site = program.share();
+    auto result = walker->eval(site);
+    bench::keep(result);
+  });
+
+  pkg::core::instructions::generation::generator_c generator(symbols);
+  auto image = pkg::core::vm::load_image(
+      pkg::core::vm::serialize_image(generator.generate(program)));
+  auto context = pkg::core::create_interpreter(symbols);
+  pkg::core::vm::vm_c machine(*context, std::move(image), symbols);
+  double vm_ns = bench::best_ns(3, [&]() {
+    auto result = machine.run();
+    bench::keep(result);
+  });
+
+  fmt::print("{:<32} {:>10.1f} ns\n", "tree walking interpreter",
+             walk_ns / iterations);
+  fmt::print("{:<32} {:>10.1f} ns\n", "bytecode vm", vm_ns / iterations);
+
+  return 0;
+}
@@ -0,0 +1,160 @@
+#include <bench.hpp>
+#include <slp/builder.hpp>
+#include <slp/slp.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t rule_count = 4096;
+
+std::string make_rule(std::size_t i) {
+  auto n = std::to_string(i);
+  return "(rule-" + std::to_string(i % 16) + " \"when " + n +
+         " is seen\" [" + n + " 2.5 key] {on " + n + "})";
+}
+
+/*
+    Equality the way it was written before slp_object_c had it: through the
+    accessors, materializing strings and symbol names.
+*/
+bool accessor_equal(const slp::slp_object_c &a, const slp::slp_object_c &b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  switch (a.type()) {
+  case slp::slp_type_e::INTEGER:
+    return a.as_int() == b.as_int();
+  case slp::slp_type_e::REAL:
+    return a.as_real() == b.as_real();
+  case slp::slp_type_e::SYMBOL:
+    return std::strcmp(a.as_symbol(), b.as_symbol()) == 0;
+  case slp::slp_type_e::DQ_LIST:
+    return a.as_string().to_string() == b.as_string().to_string();
+  case slp::slp_type_e::PAREN_LIST:
+  case slp::slp_type_e::BRACKET_LIST:
+  case slp::slp_type_e::BRACE_LIST: {
+    auto lhs = a.as_list();
+    auto rhs = b.as_list();
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); i++) {
+      if (!accessor_equal(lhs.at(i), rhs.at(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default:
+    return true;
+  }
+}
+
+void row(const char *label, double ns, std::size_t per) {
+  fmt::print("{:<28} {:>14.0f} {:>12.1f}\n", label, ns,
+             ns / static_cast<double>(per));
+}
+
+} // namespace
+
+int main() {
+  std::string table_source = "[";
+  for (std::size_t i = 0; i < rule_count; i++) {
+    table_source += make_rule(i) + " ";
+  }
+  table_source += "]";
+  auto table = slp::parse(table_source).take();
+  auto rules = table.as_list();
+
+  // The value a match is dispatched on comes from a store of its own
+  auto value = slp::parse(make_rule(rule_count - 1)).take();
+
+  bench::header("match dispatch over a rule table (value is the last rule)");
+  fmt::print("{:<28} {:>14} {:>12}\n", "method", "best ns", "ns/rule");
+
+  std::vector<slp::slp_object_c> patterns;
+  for (std::size_t i = 0; i < rules.size(); i++) {
+    patterns.push_back(rules.at(i));
+  }
+
+  row("accessors", bench::best_ns(5, [&]() {
+        std::size_t hit = 0;
+        for (std::size_t i = 0; i < patterns.size(); i++) {
+          hit = accessor_equal(value, patterns[i]) ? i : hit;
+        }
+        bench::keep(hit);
+      }),
+      rule_count);
+
+  row("equals", bench::best_ns(5, [&]() {
+        std::size_t hit = 0;
+        for (std::size_t i = 0; i < patterns.size(); i++) {
+          hit = value.equals(patterns[i]) ? i : hit;
+        }
+        bench::keep(hit);
+      }),
+      rule_count);
+
+  for (const auto &pattern : patterns) {
+    bench::keep(pattern.hash());
+  }
+  row("hash then equals (cached)", bench::best_ns(5, [&]() {
+        std::size_t hit = 0;
+        auto hash = value.hash();
+        for (std::size_t i = 0; i < patterns.size(); i++) {
+          hit = (patterns[i].hash() == hash && value.equals(patterns[i]))
+                    ? i
+                    : hit;
+        }
+        bench::keep(hit);
+      }),
+      rule_count);
+
+  bench::header("whole table compared with an equal copy");
+  fmt::print("{:<28} {:>14} {:>12}\n", "method", "best ns", "ns/rule");
+
+  auto copy = slp::parse(table_source).take();
+  row("accessors", bench::best_ns(5, [&]() {
+        bench::keep(accessor_equal(table, copy));
+      }),
+      rule_count);
+  row("equals", bench::best_ns(5, [&]() { bench::keep(table.equals(copy)); }),
+      rule_count);
+
+  // Every rule twice over in one hash consed store: each pair is a single
+  // unit compare
+  std::string doubled = "[";
+  for (std::size_t i = 0; i < rule_count; i++) {
+    doubled += "[" + make_rule(i) + " " + make_rule(i) + "] ";
+  }
+  doubled += "]";
+  auto pairs_parsed = slp::parse(doubled).take();
+  slp::slp_builder_c builder;
+  builder.set_hash_consing(true);
+  auto pairs = builder.take(builder.add_object(pairs_parsed));
+
+  auto compare_pairs = [](const slp::slp_object_c &tree) {
+    auto list = tree.as_list();
+    std::size_t equal = 0;
+    for (std::size_t i = 0; i < list.size(); i++) {
+      auto pair = list.at(i).as_list();
+      equal += pair.at(0).equals(pair.at(1)) ? 1 : 0;
+    }
+    return equal;
+  };
+  row("equals, twin subtrees", bench::best_ns(5, [&]() {
+        bench::keep(compare_pairs(pairs_parsed));
+      }),
+      rule_count);
+  row("equals, hash consed twins", bench::best_ns(5, [&]() {
+        bench::keep(compare_pairs(pairs));
+      }),
+      rule_count);
+
+  fmt::print("\nstore bytes: parsed {} hash consed {}\n",
+             pairs_parsed.get_data().size(), pairs.get_data().size());
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include <bench.hpp>
+#include <slp/slp.hpp>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr std::size_t target_bytes = 4 * 1024 * 1024;
+
+std::string make_program() {
+  std::string source = "[\n";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    auto n = std::to_string(i);
+    source += "  (def helper-" + n + " (fn (a :int b :str) :str [\n";
+    source += "    (if (eq a " + n + ") \"matched\" b)\n";
+    source += "    #(debug \"called helper\" a)\n";
+    source += "  ]))\n";
+    source += "  (def value-" + n + " (helper-" + n + " " + n + " \"x\"))\n";
+  }
+  source += "]\n";
+  return source;
+}
+
+std::string make_numbers() {
+  std::string source = "(";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    source += std::to_string(i * 7919) + " " + std::to_string(i) + ".25 ";
+  }
+  source += ")";
+  return source;
+}
+
+std::string make_symbols() {
+  std::string source = "[";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    source += "(kv/set-" + std::to_string(i % 64) + " alpha beta gamma) ";
+  }
+  source += "]";
+  return source;
+}
+
+std::string make_strings() {
+  std::string source = "{";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    source += "\"record " + std::to_string(i) + "\" ";
+  }
+  source += "}";
+  return source;
+}
+
+struct walk_s {
+  std::size_t nodes{0};
+  std::size_t legacy_bytes{0};
+  std::int64_t checksum{0};
+};
+
+/*
+    Touches every node the way an evaluator does, through the public
+    accessors. legacy_bytes is what the tree took with 16 byte units and a
+    side array of 8 byte offsets per list, the layout before version 2.
+*/
+void walk(const slp::slp_object_c &object, walk_s &out) {
+  out.nodes++;
+  out.legacy_bytes += 16;
+  switch (object.type()) {
+  case slp::slp_type_e::PAREN_LIST:
+  case slp::slp_type_e::BRACKET_LIST:
+  case slp::slp_type_e::BRACE_LIST: {
+    auto list = object.as_list();
+    out.legacy_bytes += list.size() * 8;
+    for (std::size_t i = 0; i < list.size(); i++) {
+      walk(list.at(i), out);
+    }
+    break;
+  }
+  case slp::slp_type_e::DQ_LIST: {
+    auto text = object.as_string().view();
+    out.legacy_bytes += (text.size() + 7) & ~std::size_t(7);
+    out.checksum += static_cast<std::int64_t>(text.size());
+    break;
+  }
+  case slp::slp_type_e::INTEGER:
+    out.checksum += object.as_int();
+    break;
+  case slp::slp_type_e::REAL:
+    out.checksum += static_cast<std::int64_t>(object.as_real());
+    break;
+  case slp::slp_type_e::SYMBOL:
+    out.checksum += static_cast<std::int64_t>(object.as_symbol_id());
+    break;
+  case slp::slp_type_e::SOME:
+  case slp::slp_type_e::ERROR:
+  case slp::slp_type_e::DATUM:
+    walk(object.inner(), out);
+    break;
+  default:
+    break;
+  }
+}
+
+void measure(const char *label, const std::string &source) {
+  auto parsed = slp::parse(source);
+  if (parsed.is_error()) {
+    std::fprintf(stderr, "parse failed: %s\n", parsed.error().message.c_str());
+    return;
+  }
+  const auto &object = parsed.object();
+
+  walk_s shape;
+  walk(object, shape);
+
+  double ns = bench::best_ns(5, [&]() {
+    walk_s pass;
+    walk(object, pass);
+    bench::keep(pass.checksum);
+  });
+
+  double store = static_cast<double>(object.get_data().size());
+  fmt::print("{:<10} {:>10} {:>12.2f} {:>12.2f} {:>8.2f} {:>10.2f}\n", label,
+             shape.nodes, static_cast<double>(shape.legacy_bytes) / 1048576.0,
+             store / 1048576.0,
+             store / static_cast<double>(shape.nodes),
+             ns / static_cast<double>(shape.nodes));
+}
+
+} // namespace
+
+int main() {
+  bench::header("slp tree layout: store size and full traversal");
+  fmt::print("{:<10} {:>10} {:>12} {:>12} {:>8} {:>10}\n", "input", "nodes",
+             "16B MB", "store MB", "B/node", "ns/node");
+
+  measure("program", make_program());
+  measure("numbers", make_numbers());
+  measure("symbols", make_symbols());
+  measure("strings", make_strings());
+
+  return 0;
+}
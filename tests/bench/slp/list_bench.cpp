@@ -0,0 +1,65 @@
+#include <bench.hpp>
+#include <slp/slp.hpp>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+std::string make_int_list(std::size_t count) {
+  std::string source = "(";
+  for (std::size_t i = 0; i < count; i++) {
+    source += std::to_string(i);
+    source += ' ';
+  }
+  source += ")";
+  return source;
+}
+
+std::string make_nested_list(std::size_t count) {
+  std::string source = "[";
+  for (std::size_t i = 0; i < count; i++) {
+    source += "(def x" + std::to_string(i) + " \"value\")";
+  }
+  source += "]";
+  return source;
+}
+
+void iterate(const char *label, const std::string &source) {
+  auto parsed = slp::parse(source);
+  if (parsed.is_error()) {
+    std::fprintf(stderr, "parse failed: %s\n", parsed.error().message.c_str());
+    return;
+  }
+  const auto &object = parsed.object();
+  auto list = object.as_list();
+
+  double ns = bench::best_ns(5, [&]() {
+    std::int64_t acc = 0;
+    for (std::size_t i = 0; i < list.size(); i++) {
+      auto elem = list.at(i);
+      acc += static_cast<std::int64_t>(elem.type());
+      bench::keep(elem);
+    }
+    bench::keep(acc);
+  });
+
+  fmt::print("{:<8} {:>10} {:>14.0f} {:>12.2f}\n", label, list.size(), ns,
+             ns / static_cast<double>(list.size()));
+}
+
+} // namespace
+
+int main() {
+  bench::header("list_c::at iteration (ns/element should stay flat)");
+  fmt::print("{:<8} {:>10} {:>14} {:>12}\n", "shape", "elements", "total ns",
+             "ns/element");
+
+  for (std::size_t count = 1000; count <= 64000; count *= 2) {
+    iterate("ints", make_int_list(count));
+  }
+  for (std::size_t count = 1000; count <= 64000; count *= 2) {
+    iterate("forms", make_nested_list(count));
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include <bench.hpp>
+#include <slp/slp.hpp>
+
+#include <vector>
+
+namespace {
+
+// Appending the way forge/pb did before lists could be edited: every
+// element viewed and the whole list laid out again
+slp::slp_object_c rebuild_append(const slp::slp_object_c &list,
+                                 slp::slp_object_c value) {
+  auto elements = list.as_list();
+  std::vector<slp::slp_object_c> items;
+  for (std::size_t i = 0; i < elements.size(); i++) {
+    items.push_back(elements.at(i));
+  }
+  items.push_back(std::move(value));
+  return slp::slp_object_c::create_paren_list(items.data(), items.size());
+}
+
+void row(const char *label, std::size_t count, double ns) {
+  fmt::print("{:<22} {:>10} {:>14.0f} {:>12.1f}\n", label, count, ns,
+             ns / static_cast<double>(count));
+}
+
+} // namespace
+
+int main() {
+  bench::header("appending n elements one at a time (ns/append)");
+  fmt::print("{:<22} {:>10} {:>14} {:>12}\n", "method", "elements",
+             "total ns", "ns/append");
+
+  for (std::size_t count = 1000; count <= 8000; count *= 2) {
+    row("rebuild", count, bench::best_ns(3, [&]() {
+          auto list = slp::slp_object_c::create_none();
+          for (std::size_t i = 0; i < count; i++) {
+            list = rebuild_append(
+                list, slp::slp_object_c::create_int(static_cast<long long>(i)));
+          }
+          bench::keep(list.as_list().size());
+        }));
+
+    // Another view holds every version, so each append copies
+    row("append, shared", count, bench::best_ns(3, [&]() {
+          auto list = slp::slp_object_c::create_none();
+          for (std::size_t i = 0; i < count; i++) {
+            auto next = list.share();
+            next.append(
+                slp::slp_object_c::create_int(static_cast<long long>(i)));
+            list = std::move(next);
+          }
+          bench::keep(list.as_list().size());
+        }));
+
+    row("append, owned", count, bench::best_ns(3, [&]() {
+          auto list = slp::slp_object_c::create_none();
+          for (std::size_t i = 0; i < count; i++) {
+            list.append(
+                slp::slp_object_c::create_int(static_cast<long long>(i)));
+          }
+          bench::keep(list.as_list().size());
+        }));
+  }
+
+  bench::header("set on an owned list of 16000 strings (ns/set)");
+  auto list = slp::slp_object_c::create_none();
+  for (std::size_t i = 0; i < 16000; i++) {
+    list.append(slp::slp_object_c::create_string("element"));
+  }
+  auto value = slp::slp_object_c::create_string("replacement text");
+  row("set", 16000, bench::best_ns(3, [&]() {
+        for (std::size_t i = 0; i < 16000; i++) {
+          list.set(i, value);
+        }
+        bench::keep(list.get_data().size());
+      }));
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <bench.hpp>
+#include <slp/slp.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace {
+
+constexpr std::size_t target_bytes = 4 * 1024 * 1024;
+
+std::string make_program() {
+  std::string source = "[\n";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    auto n = std::to_string(i);
+    source += "  ; helper number " + n + "\n";
+    source += "  (def helper-" + n + " (fn (a :int b :str) :str [\n";
+    source += "    (if (eq a " + n + ") \"matched\" b)\n";
+    source += "    #(debug \"called helper\" a)\n";
+    source += "  ]))\n";
+    source += "  (def value-" + n + " (helper-" + n + " " + n + " \"x\"))\n";
+  }
+  source += "]\n";
+  return source;
+}
+
+std::string make_numbers() {
+  std::string source = "(";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    source += std::to_string(i * 7919) + " " + std::to_string(i) + ".25 -" +
+              std::to_string(i) + "e-3 ";
+  }
+  source += ")";
+  return source;
+}
+
+std::string make_strings() {
+  std::string source = "{";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    source += "\"record " + std::to_string(i) +
+              " with a moderately long payload of text\" ";
+    if (i % 16 == 0) {
+      source += "\"escaped \\\"quote\\\" and \\n newline\" ";
+    }
+  }
+  source += "}";
+  return source;
+}
+
+std::string make_symbols() {
+  std::string source = "[";
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    source += "(kv/set-" + std::to_string(i % 64) + " alpha beta gamma) ";
+  }
+  source += "]";
+  return source;
+}
+
+// The same kind of program written as top level forms, no outer list
+std::string make_forms() {
+  std::string source;
+  for (std::size_t i = 0; source.size() < target_bytes; i++) {
+    auto n = std::to_string(i);
+    source += "; record " + n + "\n";
+    source += "(item " + n + " \"value " + n + "\" {" + n + " 2.5})\n";
+  }
+  return source;
+}
+
+void measure(const char *label, const std::string &source) {
+  auto check = slp::parse(source);
+  if (check.is_error()) {
+    std::fprintf(stderr, "parse failed: %s\n", check.error().message.c_str());
+    return;
+  }
+
+  double ns = bench::best_ns(5, [&]() {
+    auto result = slp::parse(source);
+    bench::keep(result);
+  });
+
+  double mb = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+  fmt::print("{:<10} {:>10.2f} {:>14.0f} {:>10.1f}\n", label, mb, ns,
+             mb / (ns / 1e9));
+}
+
+void measure_parallel(const std::string &source, std::size_t threads) {
+  double ns = bench::best_ns(5, [&]() {
+    auto result = slp::parse_parallel(source, threads);
+    bench::keep(result);
+  });
+
+  double mb = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+  fmt::print("{:<10} {:>10.2f} {:>14.0f} {:>10.1f}\n", threads, mb, ns,
+             mb / (ns / 1e9));
+}
+
+void measure_parallel_forms(const std::string &source, std::size_t threads) {
+  double ns = bench::best_ns(5, [&]() {
+    auto result = slp::parse_parallel_forms(source, threads);
+    bench::keep(result);
+  });
+
+  double mb = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+  fmt::print("{:<10} {:>10.2f} {:>14.0f} {:>10.1f}\n", threads, mb, ns,
+             mb / (ns / 1e9));
+}
+
+} // namespace
+
+int main() {
+  bench::header("slp::parse throughput");
+  fmt::print("{:<10} {:>10} {:>14} {:>10}\n", "input", "MB", "best ns",
+             "MB/s");
+
+  measure("program", make_program());
+  measure("numbers", make_numbers());
+  measure("strings", make_strings());
+  measure("symbols", make_symbols());
+
+  bench::header("slp::parse_parallel throughput (program)");
+  fmt::print("{:<10} {:>10} {:>14} {:>10}\n", "threads", "MB", "best ns",
+             "MB/s");
+
+  auto program = make_program();
+  std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  for (std::size_t threads = 1; threads < cores; threads *= 2) {
+    measure_parallel(program, threads);
+  }
+  measure_parallel(program, cores);
+
+  bench::header("slp::parse_parallel_forms throughput");
+  fmt::print("{:<10} {:>10} {:>14} {:>10}\n", "threads", "MB", "best ns",
+             "MB/s");
+
+  auto forms = make_forms();
+  for (std::size_t threads = 1; threads < cores; threads *= 2) {
+    measure_parallel_forms(forms, threads);
+  }
+  measure_parallel_forms(forms, cores);
+
+  return 0;
+}
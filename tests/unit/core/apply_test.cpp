@@ -206,3 +206,71 @@ TEST_CASE("apply - type checking enforced", "[unit][core][apply]") {
   auto obj = parse_result.take();
   CHECK_THROWS_AS(interpreter->eval(obj), std::runtime_error);
 }
+
+TEST_CASE("apply - arguments are passed as values", "[unit][core][apply]") {
+  std::string source = R"([
+    (def pick (fn (s :str l :list-c) :str [s]))
+    (def result (apply pick {"has \"quotes\" (and parens) too" {1 2}}))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto obj = parse_result.take();
+  interpreter->eval(obj);
+
+  auto result_obj = slp::parse("result").take();
+  auto result_val = interpreter->eval(result_obj);
+  REQUIRE(result_val.type() == slp::slp_type_e::DQ_LIST);
+  CHECK(result_val.as_string().to_string() ==
+        std::string("has \"quotes\" (and parens) too"));
+}
+
+TEST_CASE("apply - call_lambda from a host builtin", "[unit][core][apply]") {
+  // A higher-order builtin: calls its lambda once per element and sums
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  pkg::core::callable_symbol_s sum_each;
+  sum_each.return_type = slp::slp_type_e::INTEGER;
+  sum_each.function = [](pkg::core::callable_context_if &context,
+                         slp::slp_object_c &args_list) -> slp::slp_object_c {
+    auto list = args_list.as_list();
+    auto fn_obj = list.at(1);
+    auto items_obj = list.at(2);
+    auto fn = context.eval(fn_obj);
+    auto items_val = context.eval(items_obj);
+    auto items = items_val.as_list();
+    std::int64_t sum = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+      slp::slp_object_c arg = items.at(i);
+      auto value = context.call_lambda(fn.as_handle(), {&arg, 1});
+      sum += value.as_int();
+    }
+    return slp::slp_object_c::create_int(sum);
+  };
+  symbols["sum-each"] = sum_each;
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto setup = slp::parse(R"([
+    (def ten (fn (x :int) :int [10]))
+    (def want-str (fn (s :str) :int [1]))
+  ])")
+                   .take();
+  interpreter->eval(setup);
+
+  auto call = slp::parse("(sum-each ten {1 2 3})").take();
+  auto result = interpreter->eval(call);
+  REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+  CHECK(result.as_int() == 30);
+
+  auto mismatch = slp::parse("(sum-each want-str {1})").take();
+  CHECK_THROWS_AS(interpreter->eval(mismatch), std::runtime_error);
+
+  auto recovered =
+      slp::parse("(recover [ (sum-each want-str {1}) ] [ 5 ])").take();
+  auto recovered_val = interpreter->eval(recovered);
+  REQUIRE(recovered_val.type() == slp::slp_type_e::INTEGER);
+  CHECK(recovered_val.as_int() == 5);
+}
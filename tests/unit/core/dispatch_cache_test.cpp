@@ -0,0 +1,111 @@
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <slp/slp.hpp>
+#include <snitch/snitch.hpp>
+
+namespace {
+
+std::int64_t eval_int(pkg::core::callable_context_if &interpreter,
+                      const std::string &source) {
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+  auto obj = parse_result.take();
+  auto result = interpreter.eval(obj);
+  REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+  return result.as_int();
+}
+
+} // namespace
+
+TEST_CASE("dispatch cache - same call site sees parameter rebinding",
+          "[unit][core][dispatch]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  std::string source = R"([
+    (def one (fn () :int [ 1 ]))
+    (def two (fn () :int [ 2 ]))
+    (def call-it (fn (f :aberrant) :int [ (f) ]))
+    (def a (call-it one))
+    (def b (call-it two))
+    (def c (call-it one))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+  auto obj = parse_result.take();
+  CHECK_NOTHROW(interpreter->eval(obj));
+
+  CHECK(eval_int(*interpreter, "a") == 1);
+  CHECK(eval_int(*interpreter, "b") == 2);
+  CHECK(eval_int(*interpreter, "c") == 1);
+}
+
+TEST_CASE("dispatch cache - shadowing in a nested scope and unshadowing",
+          "[unit][core][dispatch]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  std::string source = R"([
+    (def value (fn () :int [ 10 ]))
+    (def probe (fn () :int [ (value) ]))
+    (def before (probe))
+    (def shadowed (fn () :int [
+      (def value (fn () :int [ 20 ]))
+      (probe)
+    ]))
+    (def during (shadowed))
+    (def after (probe))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+  auto obj = parse_result.take();
+  CHECK_NOTHROW(interpreter->eval(obj));
+
+  CHECK(eval_int(*interpreter, "before") == 10);
+  CHECK(eval_int(*interpreter, "during") == 20);
+  CHECK(eval_int(*interpreter, "after") == 10);
+}
+
+TEST_CASE("dispatch cache - builtins are not shadowed by definitions",
+          "[unit][core][dispatch]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  std::string source = R"([
+    (def pick (fn (x :int) :int [ (if x 1 2) ]))
+    (def first-pick (pick 1))
+    (def if 5)
+    (def second-pick (pick 0))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+  auto obj = parse_result.take();
+  CHECK_NOTHROW(interpreter->eval(obj));
+
+  CHECK(eval_int(*interpreter, "first-pick") == 1);
+  CHECK(eval_int(*interpreter, "second-pick") == 2);
+}
+
+TEST_CASE("dispatch cache - repeated calls in a loop",
+          "[unit][core][dispatch]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  std::string source = R"([
+    (def id (fn (x :int) :int [ x ]))
+    (def last (do [
+      (def seen (id $iterations))
+      (if (eq seen 50) (done seen) 0)
+    ]))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+  auto obj = parse_result.take();
+  CHECK_NOTHROW(interpreter->eval(obj));
+
+  CHECK(eval_int(*interpreter, "last") == 50);
+}
@@ -350,3 +350,37 @@ TEST_CASE("do-done - returns symbol", "[unit][core][do][symbol]") {
   std::string sym = result_val.as_symbol();
   CHECK(sym == std::string("test-symbol"));
 }
+
+TEST_CASE("do-done - each iteration starts with a clean scope",
+          "[unit][core][do][scope]") {
+  // Iterations run past the shared small integer constants, and each one
+  // defines the same name again, which only works if the last one's
+  // bindings are gone
+  std::string source = R"([
+    (def result (do [
+      (def seen $iterations)
+      (if (eq seen 300) (done seen) 0)
+    ]))
+    (def outer (do [
+      (def inner (do [(done $iterations)]))
+      (if (eq $iterations 3) (done inner) 0)
+    ]))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto obj = parse_result.take();
+  interpreter->eval(obj);
+
+  CHECK_FALSE(interpreter->has_symbol("seen"));
+  CHECK_FALSE(interpreter->has_symbol("$iterations"));
+
+  auto result_obj = slp::parse("result").take();
+  CHECK(interpreter->eval(result_obj).as_int() == 300);
+  auto outer_obj = slp::parse("outer").take();
+  CHECK(interpreter->eval(outer_obj).as_int() == 1);
+}
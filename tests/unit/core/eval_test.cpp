@@ -194,3 +194,76 @@ TEST_CASE("eval - evaluates bracket list with multiple statements",
   CHECK_FALSE(interpreter->has_symbol("a"));
   CHECK_FALSE(interpreter->has_symbol("b"));
 }
+
+TEST_CASE("eval - repeated code strings are parsed once",
+          "[unit][core][eval]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto setup = slp::parse(R"([
+    (def code "[(def local 7) local]")
+    (def other "[(def local 8) local]")
+  ])")
+                   .take();
+  interpreter->eval(setup);
+
+  for (int i = 0; i < 3; i++) {
+    auto call = slp::parse("(eval code)").take();
+    auto result = interpreter->eval(call);
+    REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+    CHECK(result.as_int() == 7);
+  }
+  auto other_call = slp::parse("(eval other)").take();
+  auto other_result = interpreter->eval(other_call);
+  REQUIRE(other_result.type() == slp::slp_type_e::INTEGER);
+  CHECK(other_result.as_int() == 8);
+
+  auto stats = interpreter->get_eval_cache_stats();
+  CHECK(stats.hits == 2);
+  CHECK(stats.misses == 2);
+  CHECK(stats.entries == 2);
+  CHECK_FALSE(interpreter->has_symbol("local"));
+}
+
+TEST_CASE("eval - parse cache stays bounded", "[unit][core][eval]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  for (int i = 0; i < 200; i++) {
+    auto call = slp::parse("(eval \"" + std::to_string(i) + "\")").take();
+    auto result = interpreter->eval(call);
+    REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+    CHECK(result.as_int() == i);
+  }
+
+  auto stats = interpreter->get_eval_cache_stats();
+  CHECK(stats.misses == 200);
+  CHECK(stats.entries <= 64);
+
+  // The most recent string is still cached, the first long evicted
+  auto recent = slp::parse("(eval \"199\")").take();
+  interpreter->eval(recent);
+  auto first = slp::parse("(eval \"0\")").take();
+  auto first_result = interpreter->eval(first);
+  REQUIRE(first_result.type() == slp::slp_type_e::INTEGER);
+  CHECK(first_result.as_int() == 0);
+
+  stats = interpreter->get_eval_cache_stats();
+  CHECK(stats.hits == 1);
+  CHECK(stats.misses == 201);
+}
+
+TEST_CASE("eval - malformed code is not cached", "[unit][core][eval]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  for (int i = 0; i < 2; i++) {
+    auto call = slp::parse(R"((eval "(unclosed"))").take();
+    CHECK_THROWS_AS(interpreter->eval(call), std::runtime_error);
+  }
+
+  auto stats = interpreter->get_eval_cache_stats();
+  CHECK(stats.hits == 0);
+  CHECK(stats.misses == 2);
+  CHECK(stats.entries == 0);
+}
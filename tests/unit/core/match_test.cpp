@@ -345,3 +345,31 @@ TEST_CASE("match - multiple types same value different result",
   CHECK(result_val.type() == slp::slp_type_e::DQ_LIST);
   CHECK(result_val.as_string().to_string() == "integer");
 }
+
+TEST_CASE("match - structured patterns", "[unit][core][match]") {
+  std::string source = R"([
+    (def rule '(set key "value" [1 2.5]))
+    (def result (match rule
+      ('(set key "value" [1 2.5 3]) 1)
+      ('(set key "other" [1 2.5]) 2)
+      ('(set key "value" [1 2.5]) 3)
+    ))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto obj = parse_result.take();
+  interpreter->eval(obj);
+
+  auto result_parsed = slp::parse("result");
+  REQUIRE(result_parsed.is_success());
+  auto result_obj = result_parsed.take();
+  auto result_val = interpreter->eval(result_obj);
+
+  CHECK(result_val.type() == slp::slp_type_e::INTEGER);
+  CHECK(result_val.as_int() == 3);
+}
@@ -211,3 +211,42 @@ TEST_CASE("nested scopes - scope isolation between siblings",
   CHECK_FALSE(interpreter->has_symbol("first-scope"));
   CHECK_FALSE(interpreter->has_symbol("second-scope"));
 }
+
+TEST_CASE("nested scopes - popping a frame restores shadowed bindings",
+          "[unit][core][nested][restore]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto eval_int = [&](const std::string &source) {
+    auto obj = slp::parse(source).take();
+    return interpreter->eval(obj).as_int();
+  };
+
+  auto outer = slp::slp_object_c::create_int(1);
+  REQUIRE(interpreter->define_symbol("x", outer));
+
+  interpreter->push_scope();
+  CHECK(interpreter->has_symbol("x"));
+  CHECK_FALSE(interpreter->has_symbol("x", true));
+
+  auto middle = slp::slp_object_c::create_int(2);
+  REQUIRE(interpreter->define_symbol("x", middle));
+  auto only_here = slp::slp_object_c::create_int(7);
+  REQUIRE(interpreter->define_symbol("y", only_here));
+  CHECK(interpreter->has_symbol("x", true));
+
+  interpreter->push_scope();
+  auto inner = slp::slp_object_c::create_int(3);
+  REQUIRE(interpreter->define_symbol("x", inner));
+  auto redefined = slp::slp_object_c::create_int(4);
+  REQUIRE(interpreter->define_symbol("x", redefined));
+  CHECK(eval_int("x") == 4);
+  CHECK(eval_int("y") == 7);
+
+  interpreter->pop_scope();
+  CHECK(eval_int("x") == 2);
+
+  interpreter->pop_scope();
+  CHECK(eval_int("x") == 1);
+  CHECK_FALSE(interpreter->has_symbol("y"));
+}
@@ -149,3 +149,106 @@ TEST_CASE("recover - both arguments must be bracket lists",
   auto obj = parse_result.take();
   CHECK_THROWS_AS(interpreter->eval(obj), std::runtime_error);
 }
+
+TEST_CASE("recover - errors raised deep in lambdas and loops are recovered",
+          "[unit][core][recover]") {
+  std::string source = R"([
+    (def fail (fn (x :int) :int [ (assert 0 "deep failure") x ]))
+    (def outer (fn (x :int) :int [ (def r (fail x)) r ]))
+    (def from-lambda (recover [ (outer 1) ] [ $exception ]))
+    (def from-loop (recover [
+      (do [ (def r (outer $iterations)) ])
+    ] [ $exception ]))
+    (def from-arity (recover [ (outer 1 2) ] [ 7 ]))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto obj = parse_result.take();
+  interpreter->eval(obj);
+
+  for (const char *name : {"from-lambda", "from-loop"}) {
+    auto name_obj = slp::parse(name).take();
+    auto value = interpreter->eval(name_obj);
+    REQUIRE(value.type() == slp::slp_type_e::DQ_LIST);
+    CHECK(value.as_string().to_string() == "deep failure");
+  }
+
+  auto arity_obj = slp::parse("from-arity").take();
+  auto arity = interpreter->eval(arity_obj);
+  REQUIRE(arity.type() == slp::slp_type_e::INTEGER);
+  CHECK(arity.as_int() == 7);
+}
+
+TEST_CASE("recover - scopes opened by the failed body are closed",
+          "[unit][core][recover]") {
+  std::string source = R"([
+    (def fail (fn () :int [ (def inner 1) (assert 0 "failed") 0 ]))
+    (recover [ (def body-local 1) (fail) ] [ 0 ])
+    (recover [ (do [ (def loop-local 1) (fail) ]) ] [ 0 ])
+    (def after 5)
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto obj = parse_result.take();
+  interpreter->eval(obj);
+
+  CHECK_FALSE(interpreter->has_symbol("inner"));
+  CHECK_FALSE(interpreter->has_symbol("loop-local"));
+  CHECK_FALSE(interpreter->is_in_loop());
+  CHECK(interpreter->has_symbol("after", true));
+}
+
+TEST_CASE("recover - message is passed through verbatim",
+          "[unit][core][recover]") {
+  std::string source = R"([
+    (def result (recover [
+      (assert 0 "has \"quotes\" and \\ slashes")
+    ] [ $exception ]))
+  ])";
+
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto obj = parse_result.take();
+  interpreter->eval(obj);
+
+  auto result_obj = slp::parse("result").take();
+  auto result_val = interpreter->eval(result_obj);
+  REQUIRE(result_val.type() == slp::slp_type_e::DQ_LIST);
+  CHECK(result_val.as_string().to_string() ==
+        std::string("has \"quotes\" and \\ slashes"));
+}
+
+TEST_CASE("recover - errors outside recover still throw",
+          "[unit][core][recover]") {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  auto interpreter = pkg::core::create_interpreter(symbols);
+
+  auto setup = slp::parse(R"([
+    (def fail (fn () :int [ (assert 0 "uncaught") 0 ]))
+  ])")
+                   .take();
+  interpreter->eval(setup);
+
+  auto call = slp::parse("(fail)").take();
+  CHECK_THROWS_AS(interpreter->eval(call), std::runtime_error);
+
+  // A throw leaves the interpreter usable
+  auto after = slp::parse("(recover [ (fail) ] [ 3 ])").take();
+  auto value = interpreter->eval(after);
+  REQUIRE(value.type() == slp::slp_type_e::INTEGER);
+  CHECK(value.as_int() == 3);
+}
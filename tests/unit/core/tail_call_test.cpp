@@ -0,0 +1,161 @@
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <fmt/core.h>
+#include <slp/slp.hpp>
+#include <snitch/snitch.hpp>
+
+namespace {
+
+// Deep enough that nesting a native frame per call would overflow the stack
+constexpr std::int64_t deep = 200000;
+
+/*
+    The core instructions have no arithmetic; the tests add a `dec` builtin
+    rather than depend on the alu kernel.
+*/
+std::unique_ptr<pkg::core::callable_context_if> make_interpreter() {
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+
+  pkg::core::callable_symbol_s dec;
+  dec.return_type = slp::slp_type_e::INTEGER;
+  dec.required_parameters = {{.name = "n", .type = slp::slp_type_e::INTEGER}};
+  dec.function = [](pkg::core::callable_context_if &context,
+                    slp::slp_object_c &args_list) -> slp::slp_object_c {
+    auto list = args_list.as_list();
+    auto arg = list.at(1);
+    return slp::slp_object_c::create_int(context.eval(arg).as_int() - 1);
+  };
+  symbols["dec"] = dec;
+
+  return pkg::core::create_interpreter(symbols);
+}
+
+slp::slp_object_c run(pkg::core::callable_context_if &interpreter,
+                      const std::string &source) {
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+  auto obj = parse_result.take();
+  return interpreter.eval(obj);
+}
+
+} // namespace
+
+TEST_CASE("tail calls - self recursion runs in constant stack",
+          "[unit][core][tail]") {
+  auto interpreter = make_interpreter();
+
+  run(*interpreter, R"([
+    (def count-down (fn (n :int) :int [
+      (if (eq n 0) 0 (count-down (dec n)))
+    ]))
+  ])");
+
+  auto result = run(*interpreter, fmt::format("(count-down {})", deep));
+  REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+  CHECK(result.as_int() == 0);
+}
+
+TEST_CASE("tail calls - mutual recursion through bracket branches",
+          "[unit][core][tail]") {
+  auto interpreter = make_interpreter();
+
+  run(*interpreter, R"([
+    (def is-even (fn (n :int) :int [
+      (if (eq n 0) 1 [ (is-odd (dec n)) ])
+    ]))
+    (def is-odd (fn (n :int) :int [
+      (if (eq n 0) 0 [ (is-even (dec n)) ])
+    ]))
+  ])");
+
+  auto even = run(*interpreter, fmt::format("(is-even {})", deep));
+  REQUIRE(even.type() == slp::slp_type_e::INTEGER);
+  CHECK(even.as_int() == 1);
+
+  auto odd = run(*interpreter, fmt::format("(is-even {})", deep + 1));
+  REQUIRE(odd.type() == slp::slp_type_e::INTEGER);
+  CHECK(odd.as_int() == 0);
+}
+
+TEST_CASE("tail calls - match and reflect handlers are tail positions",
+          "[unit][core][tail]") {
+  auto interpreter = make_interpreter();
+
+  run(*interpreter, R"([
+    (def by-match (fn (n :int) :int [
+      (match n (0 7) (n (by-match (dec n))))
+    ]))
+    (def by-reflect (fn (n :int) :int [
+      (reflect (if (eq n 0) "stop" n)
+        (:str 9)
+        (:int (by-reflect (dec n))))
+    ]))
+  ])");
+
+  auto matched = run(*interpreter, fmt::format("(by-match {})", deep));
+  REQUIRE(matched.type() == slp::slp_type_e::INTEGER);
+  CHECK(matched.as_int() == 7);
+
+  auto reflected = run(*interpreter, fmt::format("(by-reflect {})", deep));
+  REQUIRE(reflected.type() == slp::slp_type_e::INTEGER);
+  CHECK(reflected.as_int() == 9);
+}
+
+TEST_CASE("tail calls - callee still sees the caller's bindings",
+          "[unit][core][tail]") {
+  auto interpreter = make_interpreter();
+
+  run(*interpreter, R"([
+    (def read-local (fn () :int [ local ]))
+    (def caller (fn (n :int) :int [
+      (def local n)
+      (read-local)
+    ]))
+    (def make-and-call (fn (n :int) :int [
+      (def helper (fn (x :int) :int [ x ]))
+      (helper n)
+    ]))
+  ])");
+
+  auto seen = run(*interpreter, "(caller 42)");
+  REQUIRE(seen.type() == slp::slp_type_e::INTEGER);
+  CHECK(seen.as_int() == 42);
+  CHECK_FALSE(interpreter->has_symbol("local"));
+
+  auto helped = run(*interpreter, "(make-and-call 5)");
+  REQUIRE(helped.type() == slp::slp_type_e::INTEGER);
+  CHECK(helped.as_int() == 5);
+  CHECK_FALSE(interpreter->has_symbol("helper"));
+}
+
+TEST_CASE("tail calls - every return type in the chain is checked",
+          "[unit][core][tail]") {
+  auto interpreter = make_interpreter();
+
+  run(*interpreter, R"([
+    (def give-str (fn () :str [ "text" ]))
+    (def want-int (fn () :int [ (give-str) ]))
+    (def want-any (fn () :any [ (give-str) ]))
+  ])");
+
+  CHECK(run(*interpreter, "(want-int)").type() == slp::slp_type_e::ERROR);
+  CHECK(run(*interpreter, "(want-any)").type() == slp::slp_type_e::DQ_LIST);
+}
+
+TEST_CASE("tail calls - calls outside tail position still return",
+          "[unit][core][tail]") {
+  auto interpreter = make_interpreter();
+
+  run(*interpreter, R"([
+    (def id (fn (x :int) :int [ x ]))
+    (def twice (fn (x :int) :int [
+      (def first (id x))
+      (if (eq (id first) x) (id first) 0)
+    ]))
+    (def result (twice 3))
+  ])");
+
+  auto result = run(*interpreter, "result");
+  REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+  CHECK(result.as_int() == 3);
+}
@@ -0,0 +1,190 @@
+#include <core/instructions/generation/generation.hpp>
+#include <core/instructions/instructions.hpp>
+#include <core/interpreter.hpp>
+#include <core/vm/vm.hpp>
+#include <fstream>
+#include <slp/slp.hpp>
+#include <snitch/snitch.hpp>
+#include <sstream>
+
+namespace {
+
+std::string load_test_file(const std::string &filename) {
+  std::string path = std::string(TEST_DATA_DIR) + "/" + filename;
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open test file: " + path);
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+pkg::core::vm::byte_vector_t compile_to_bytes(const std::string &source) {
+  auto parse_result = slp::parse(source);
+  REQUIRE(parse_result.is_success());
+
+  auto symbols = pkg::core::instructions::get_standard_callable_symbols();
+  pkg::core::instructions::generation::generator_c generator(symbols);
+  auto obj = parse_result.take();
+  return pkg::core::vm::serialize_image(generator.generate(obj));
+}
+
+// Compiles, round trips the image through its serialized form and runs it
+slp::slp_object_c run_compiled(pkg::core::callable_context_if &context,
+                               const std::string &source) {
+  auto image = pkg::core::vm::load_image(compile_to_bytes(source));
+  pkg::core::vm::vm_c machine(
+      context, std::move(image),
+      pkg::core::instructions::get_standard_callable_symbols());
+  return machine.run();
+}
+
+slp::slp_object_c lookup(pkg::core::callable_context_if &context,
+                         const std::string &name) {
+  auto obj = slp::parse(name).take();
+  return context.eval(obj);
+}
+
+std::unique_ptr<pkg::core::callable_context_if> make_interpreter() {
+  return pkg::core::create_interpreter(
+      pkg::core::instructions::get_standard_callable_symbols());
+}
+
+} // namespace
+
+TEST_CASE("vm - image round trip", "[unit][core][vm][image]") {
+  auto bytes = compile_to_bytes(R"([
+    (def greeting "hello")
+    (def pick (fn (x :int) :str [(if x greeting "no")]))
+    (pick 1)
+  ])");
+
+  CHECK(pkg::core::vm::is_image(bytes));
+
+  auto image = pkg::core::vm::load_image(bytes);
+  CHECK(image.functions.size() > 1);
+  CHECK(image.constants.type() == slp::slp_type_e::BRACE_LIST);
+  CHECK(pkg::core::vm::serialize_image(image) == bytes);
+}
+
+TEST_CASE("vm - rejects malformed images", "[unit][core][vm][image]") {
+  auto bytes = compile_to_bytes("[(def x 1)]");
+
+  auto bad_magic = bytes;
+  bad_magic[0] = 'X';
+  CHECK_FALSE(pkg::core::vm::is_image(bad_magic));
+  CHECK_THROWS_AS(pkg::core::vm::load_image(bad_magic), std::runtime_error);
+
+  auto bad_version = bytes;
+  bad_version[4] = 0xFF;
+  CHECK_THROWS_AS(pkg::core::vm::load_image(bad_version), std::runtime_error);
+
+  auto truncated = bytes;
+  truncated.resize(bytes.size() / 2);
+  CHECK_THROWS_AS(pkg::core::vm::load_image(truncated), std::runtime_error);
+
+  auto image = pkg::core::vm::load_image(bytes);
+  image.functions[0] = {
+      static_cast<std::uint8_t>(pkg::core::vm::opcode_e::PUSH_CONST), 0xFF,
+      0xFF, 0, 0, static_cast<std::uint8_t>(pkg::core::vm::opcode_e::RETURN)};
+  auto interpreter = make_interpreter();
+  CHECK_THROWS_AS(pkg::core::vm::vm_c(
+                      *interpreter, std::move(image),
+                      pkg::core::instructions::get_standard_callable_symbols()),
+                  std::runtime_error);
+}
+
+TEST_CASE("vm - definitions and branches", "[unit][core][vm][def]") {
+  auto interpreter = make_interpreter();
+  run_compiled(*interpreter, R"([
+    (def a 10)
+    (def b (if 0 "yes" "no"))
+    (def c (if a "yes" "no"))
+    (def d [1 2 3])
+  ])");
+
+  CHECK(lookup(*interpreter, "a").as_int() == 10);
+  CHECK(lookup(*interpreter, "b").as_string().to_string() == "no");
+  CHECK(lookup(*interpreter, "c").as_string().to_string() == "yes");
+  CHECK(lookup(*interpreter, "d").as_int() == 3);
+
+  CHECK_THROWS_AS(run_compiled(*interpreter, "[(def a 11)]"),
+                  std::runtime_error);
+}
+
+TEST_CASE("vm - do loops", "[unit][core][vm][do]") {
+  auto interpreter = make_interpreter();
+  auto result = run_compiled(*interpreter, R"([
+    (def outer (do [
+      (def inner (do [
+        (if (eq $iterations 3) (done $iterations) 0)
+      ]))
+      (if (eq $iterations 5) (done inner) 0)
+    ]))
+    outer
+  ])");
+
+  REQUIRE(result.type() == slp::slp_type_e::INTEGER);
+  CHECK(result.as_int() == 3);
+  CHECK_FALSE(interpreter->has_symbol("inner"));
+
+  CHECK_THROWS_AS(run_compiled(*interpreter, "[(done 1)]"),
+                  std::runtime_error);
+}
+
+TEST_CASE("vm - lambdas", "[unit][core][vm][fn]") {
+  auto interpreter = make_interpreter();
+  auto result = run_compiled(*interpreter, R"([
+    (def pick (fn (flag :int a :str b :str) :str [
+      (if flag a b)
+    ]))
+    (def first (pick 1 "left" "right"))
+    (def second (pick 0 "left" "right"))
+    (def bad-return (fn () :int ["text"]))
+    (def returned (bad-return))
+    (def applied (apply pick {1 "applied" "x"}))
+    (pick 0 "a" "last")
+  ])");
+
+  CHECK(result.as_string().to_string() == "last");
+  CHECK(lookup(*interpreter, "first").as_string().to_string() == "left");
+  CHECK(lookup(*interpreter, "second").as_string().to_string() == "right");
+  CHECK(lookup(*interpreter, "returned").type() == slp::slp_type_e::ERROR);
+  CHECK(lookup(*interpreter, "applied").as_string().to_string() == "applied");
+
+  CHECK_THROWS_AS(run_compiled(*interpreter, "[(pick 1 \"a\")]"),
+                  std::runtime_error);
+  CHECK_THROWS_AS(run_compiled(*interpreter, "[(pick \"1\" \"a\" \"b\")]"),
+                  std::runtime_error);
+}
+
+TEST_CASE("vm - released lambdas are not callable",
+          "[unit][core][vm][fn][cleanup]") {
+  auto interpreter = make_interpreter();
+  CHECK_THROWS_AS(run_compiled(*interpreter, R"([
+    (def escaped (do [(done (fn () :int [1]))]))
+    (escaped)
+  ])"),
+                  std::runtime_error);
+}
+
+TEST_CASE("vm - runs the interpreter test programs",
+          "[unit][core][vm][programs]") {
+  for (const char *file :
+       {"test_basic_scoping.sxs", "test_functions.sxs", "test_nested_scopes.sxs",
+        "test_lambda_cleanup.sxs", "test_if.sxs", "test_reflect.sxs",
+        "test_try.sxs", "test_recover.sxs", "test_eval.sxs", "test_apply.sxs",
+        "test_match.sxs", "test_cast.sxs", "test_do_loop.sxs", "test_at.sxs",
+        "test_eq.sxs", "test_edge_cases.sxs", "test_lambda_types.sxs",
+        "test_assert.sxs"}) {
+    auto source = load_test_file(file);
+
+    auto interpreted = make_interpreter();
+    auto parsed = slp::parse(source).take();
+    REQUIRE_NOTHROW(interpreted->eval(parsed));
+
+    auto compiled = make_interpreter();
+    CHECK_NOTHROW(run_compiled(*compiled, source));
+  }
+}
@@ -1,16 +1,30 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <random>
 #include <slp/buffer.hpp>
+#include <slp/builder.hpp>
+#include <slp/constants.hpp>
+#include <slp/image.hpp>
+#include <slp/scan.hpp>
 #include <slp/slp.hpp>
+#include <slp/stream.hpp>
+#include <slp/symbols.hpp>
 #include <snitch/snitch.hpp>
 
 class slp_test_accessor {
 public:
   static const slp::slp_buffer_c &get_data(const slp::slp_object_c &obj) {
-    return obj.data_;
+    return obj.get_data();
   }
 
-  static const std::map<std::uint64_t, std::string> &
+  static std::map<std::uint64_t, std::string>
   get_symbols(const slp::slp_object_c &obj) {
-    return obj.symbols_;
+    return obj.get_symbols();
   }
 
   static const slp::slp_unit_of_store_t *
@@ -666,7 +680,7 @@ TEST_CASE("slp internal structure validation", "[unit][slp][internal]") {
     CHECK(symbols.size() == 1);
 
     const auto *view = slp_test_accessor::get_view(result.object());
-    std::uint64_t symbol_id = view->data.uint64;
+    std::uint64_t symbol_id = view->data;
     CHECK(symbols.find(symbol_id) != symbols.end());
     CHECK(symbols.at(symbol_id) == "hello");
   }
@@ -857,7 +871,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
     auto datum_elem = list.at(0);
     CHECK(datum_elem.type() == slp::slp_type_e::DATUM);
 
-    auto inner_offset = slp_test_accessor::get_view(datum_elem)->data.uint64;
+    auto inner_offset = datum_elem.inner().get_root_offset();
     auto inner_obj = slp::slp_object_c::from_data(
         datum_elem.get_data(), datum_elem.get_symbols(), inner_offset);
 
@@ -879,7 +893,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
 
     auto datum1 = list.at(0);
     CHECK(datum1.type() == slp::slp_type_e::DATUM);
-    auto inner1_offset = slp_test_accessor::get_view(datum1)->data.uint64;
+    auto inner1_offset = datum1.inner().get_root_offset();
     auto inner1 = slp::slp_object_c::from_data(
         datum1.get_data(), datum1.get_symbols(), inner1_offset);
     CHECK(inner1.type() == slp::slp_type_e::INTEGER);
@@ -887,7 +901,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
 
     auto datum2 = list.at(1);
     CHECK(datum2.type() == slp::slp_type_e::DATUM);
-    auto inner2_offset = slp_test_accessor::get_view(datum2)->data.uint64;
+    auto inner2_offset = datum2.inner().get_root_offset();
     auto inner2 = slp::slp_object_c::from_data(
         datum2.get_data(), datum2.get_symbols(), inner2_offset);
     CHECK(inner2.type() == slp::slp_type_e::SYMBOL);
@@ -895,7 +909,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
 
     auto datum3 = list.at(2);
     CHECK(datum3.type() == slp::slp_type_e::DATUM);
-    auto inner3_offset = slp_test_accessor::get_view(datum3)->data.uint64;
+    auto inner3_offset = datum3.inner().get_root_offset();
     auto inner3 = slp::slp_object_c::from_data(
         datum3.get_data(), datum3.get_symbols(), inner3_offset);
     CHECK(inner3.type() == slp::slp_type_e::REAL);
@@ -912,7 +926,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
     auto datum_elem = outer_list.at(0);
     CHECK(datum_elem.type() == slp::slp_type_e::DATUM);
 
-    auto inner_offset = slp_test_accessor::get_view(datum_elem)->data.uint64;
+    auto inner_offset = datum_elem.inner().get_root_offset();
     auto inner_obj = slp::slp_object_c::from_data(
         datum_elem.get_data(), datum_elem.get_symbols(), inner_offset);
 
@@ -948,7 +962,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
     auto datum_elem = middle_list.at(0);
     CHECK(datum_elem.type() == slp::slp_type_e::DATUM);
 
-    auto inner_offset = slp_test_accessor::get_view(datum_elem)->data.uint64;
+    auto inner_offset = datum_elem.inner().get_root_offset();
     auto inner_obj = slp::slp_object_c::from_data(
         datum_elem.get_data(), datum_elem.get_symbols(), inner_offset);
 
@@ -968,7 +982,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
 
     auto datum1 = list.at(1);
     CHECK(datum1.type() == slp::slp_type_e::DATUM);
-    auto inner1_offset = slp_test_accessor::get_view(datum1)->data.uint64;
+    auto inner1_offset = datum1.inner().get_root_offset();
     auto inner1 = slp::slp_object_c::from_data(
         datum1.get_data(), datum1.get_symbols(), inner1_offset);
     CHECK(inner1.type() == slp::slp_type_e::INTEGER);
@@ -979,7 +993,7 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
 
     auto datum2 = list.at(3);
     CHECK(datum2.type() == slp::slp_type_e::DATUM);
-    auto inner2_offset = slp_test_accessor::get_view(datum2)->data.uint64;
+    auto inner2_offset = datum2.inner().get_root_offset();
     auto inner2 = slp::slp_object_c::from_data(
         datum2.get_data(), datum2.get_symbols(), inner2_offset);
     CHECK(inner2.type() == slp::slp_type_e::INTEGER);
@@ -989,3 +1003,1265 @@ TEST_CASE("slp datum wrapper in lists", "[unit][slp][datum][offset]") {
     CHECK(list.at(4).as_int() == 5);
   }
 }
+
+TEST_CASE("slp shared store views", "[unit][slp][store]") {
+  SECTION("list elements share the parent buffer") {
+    auto result = slp::parse("(1 (2 3) \"four\")");
+    CHECK(result.is_success());
+    const auto &obj = result.object();
+    auto list = obj.as_list();
+
+    auto second = list.at(1);
+    CHECK(&slp_test_accessor::get_data(second) ==
+          &slp_test_accessor::get_data(obj));
+
+    auto nested = second.as_list().at(1);
+    CHECK(&slp_test_accessor::get_data(nested) ==
+          &slp_test_accessor::get_data(obj));
+    CHECK(nested.as_int() == 3);
+  }
+
+  SECTION("views outlive the object they came from") {
+    slp::slp_object_c element;
+    {
+      auto result = slp::parse("(alpha beta gamma)");
+      CHECK(result.is_success());
+      element = result.object().as_list().at(2);
+    }
+    CHECK(element.type() == slp::slp_type_e::SYMBOL);
+    CHECK(std::string(element.as_symbol()) == "gamma");
+  }
+
+  SECTION("share and view_at") {
+    auto result = slp::parse("'(a b)");
+    CHECK(result.is_success());
+    const auto &obj = result.object();
+
+    auto shared = obj.share();
+    CHECK(shared.type() == slp::slp_type_e::SOME);
+    CHECK(shared.get_root_offset() == obj.get_root_offset());
+
+    auto inner = obj.view_at(obj.inner().get_root_offset());
+    CHECK(inner.type() == slp::slp_type_e::PAREN_LIST);
+    CHECK(inner.as_list().size() == 2);
+  }
+
+  SECTION("view_at out of range is none") {
+    auto result = slp::parse("42");
+    CHECK(result.is_success());
+    auto view = result.object().view_at(4096);
+    CHECK(view.type() == slp::slp_type_e::NONE);
+    CHECK_FALSE(view.has_data());
+  }
+}
+
+TEST_CASE("slp direct builders", "[unit][slp][builder]") {
+  SECTION("create_real keeps full precision") {
+    double value = 0.1 + 0.2;
+    auto obj = slp::slp_object_c::create_real(value);
+    CHECK(obj.type() == slp::slp_type_e::REAL);
+    CHECK(obj.as_real() == value);
+
+    auto tiny = slp::slp_object_c::create_real(1.0e-300);
+    CHECK(tiny.as_real() == 1.0e-300);
+  }
+
+  SECTION("create_symbol never reinterprets the name") {
+    auto obj = slp::slp_object_c::create_symbol("42");
+    CHECK(obj.type() == slp::slp_type_e::SYMBOL);
+    CHECK(std::string(obj.as_symbol()) == "42");
+  }
+
+  SECTION("create_none is an empty paren list") {
+    auto obj = slp::slp_object_c::create_none();
+    CHECK(obj.type() == slp::slp_type_e::PAREN_LIST);
+    CHECK(obj.as_list().empty());
+  }
+
+  SECTION("lists keep nested and wrapped elements") {
+    auto nested = slp::parse("[(a \"q\\\"uote\") @(bad thing) '{1 2.5}]").take();
+    auto items = nested.as_list();
+    REQUIRE(items.size() == 3);
+
+    slp::slp_object_c elements[4] = {
+        slp::slp_object_c::create_int(7), items.at(0), items.at(1),
+        items.at(2)};
+    auto list = slp::slp_object_c::create_paren_list(elements, 4);
+
+    auto out = list.as_list();
+    REQUIRE(out.size() == 4);
+    CHECK(out.at(0).as_int() == 7);
+
+    auto inner = out.at(1);
+    REQUIRE(inner.type() == slp::slp_type_e::PAREN_LIST);
+    CHECK(std::string(inner.as_list().at(0).as_symbol()) == "a");
+    CHECK(inner.as_list().at(1).as_string().to_string() == "q\"uote");
+
+    auto err = out.at(2);
+    REQUIRE(err.type() == slp::slp_type_e::ERROR);
+    auto err_inner = err.inner();
+    CHECK(std::string(err_inner.as_list().at(1).as_symbol()) == "thing");
+
+    auto quoted = out.at(3);
+    REQUIRE(quoted.type() == slp::slp_type_e::SOME);
+    auto brace = quoted.inner();
+    REQUIRE(brace.type() == slp::slp_type_e::BRACE_LIST);
+    CHECK(brace.as_list().at(1).as_real() == 2.5);
+  }
+
+  SECTION("builder nests by offset") {
+    slp::slp_builder_c builder;
+    size_t inner[2] = {builder.add_symbol("x"), builder.add_string("hi")};
+    size_t list = builder.add_list(slp::slp_type_e::BRACKET_LIST, inner, 2);
+    size_t outer[2] = {builder.add_symbol("x"), list};
+    size_t root = builder.add_list(slp::slp_type_e::PAREN_LIST, outer, 2);
+    auto obj = builder.take(root);
+
+    CHECK(slp_test_accessor::get_symbols(obj).size() == 1);
+    auto elems = obj.as_list();
+    CHECK(std::string(elems.at(0).as_symbol()) == "x");
+    auto bracket_obj = elems.at(1);
+    auto bracket = bracket_obj.as_list();
+    CHECK(std::string(bracket.at(0).as_symbol()) == "x");
+    CHECK(bracket.at(1).as_string().to_string() == "hi");
+  }
+
+  SECTION("aberrant handles survive copies") {
+    auto handle = slp::slp_object_c::create_aberrant(99);
+    CHECK(handle.type() == slp::slp_type_e::ABERRANT);
+    auto list = slp::slp_object_c::create_bracket_list(&handle, 1);
+    auto copied = list.as_list().at(0);
+    CHECK(copied.type() == slp::slp_type_e::ABERRANT);
+    CHECK(copied.as_handle() == 99);
+  }
+}
+
+TEST_CASE("slp packed strings", "[unit][slp][string]") {
+  SECTION("view matches to_string and at") {
+    auto result = slp::parse("\"hello world\"");
+    REQUIRE(result.is_success());
+    auto str = result.object().as_string();
+    CHECK(str.size() == 11);
+    CHECK(str.view() == "hello world");
+    CHECK(str.to_string() == "hello world");
+    CHECK(str.at(4) == 'o');
+    CHECK(str.at(11) == '\0');
+  }
+
+  SECTION("escapes are decoded into the packed bytes") {
+    auto result = slp::parse("\"a\\tb\\\"c\\0d\"");
+    REQUIRE(result.is_success());
+    auto str = result.object().as_string();
+    CHECK(str.size() == 7);
+    CHECK(str.view() == std::string_view("a\tb\"c\0d", 7));
+  }
+
+  SECTION("empty string") {
+    auto result = slp::parse("\"\"");
+    REQUIRE(result.is_success());
+    auto str = result.object().as_string();
+    CHECK(str.empty());
+    CHECK(str.view().empty());
+    CHECK(str.to_string().empty());
+  }
+
+  SECTION("units after a string stay aligned") {
+    auto result = slp::parse("(\"abc\" 42 \"de\" 3.5 sym)");
+    REQUIRE(result.is_success());
+    auto list = result.object().as_list();
+    REQUIRE(list.size() == 5);
+    for (size_t i = 0; i < list.size(); i++) {
+      auto elem = list.at(i);
+      CHECK(slp_test_accessor::get_root_offset(elem) % 8 == 0);
+    }
+    CHECK(list.at(0).as_string().view() == "abc");
+    CHECK(list.at(1).as_int() == 42);
+    CHECK(list.at(2).as_string().view() == "de");
+    CHECK(list.at(3).as_real() == 3.5);
+  }
+
+  SECTION("string storage is one unit plus the bytes") {
+    std::string text(1000, 'x');
+    auto obj = slp::slp_object_c::create_string(text);
+    CHECK(slp_test_accessor::get_data(obj).size() <
+          sizeof(slp::slp_unit_of_store_t) + text.size() + 8);
+    CHECK(obj.as_string().view() == text);
+  }
+}
+
+TEST_CASE("slp symbol interning", "[unit][slp][symbols]") {
+  SECTION("identical symbols share an id across parses") {
+    auto a = slp::parse("(shared-name other)").take();
+    auto b = slp::parse("shared-name").take();
+    auto a_first = a.as_list().at(0);
+    CHECK(a_first.as_symbol_id() != 0);
+    CHECK(a_first.as_symbol_id() == b.as_symbol_id());
+    CHECK(a.as_list().at(1).as_symbol_id() != b.as_symbol_id());
+    CHECK(slp::symbol_table().find("shared-name") == b.as_symbol_id());
+  }
+
+  SECTION("repeated symbols in one parse share an id") {
+    auto obj = slp::parse("(x y x)").take();
+    auto list = obj.as_list();
+    CHECK(list.at(0).as_symbol_id() == list.at(2).as_symbol_id());
+    CHECK(slp_test_accessor::get_symbols(obj).size() == 2);
+  }
+
+  SECTION("non symbols have no id") {
+    CHECK(slp::slp_object_c::create_int(1).as_symbol_id() == 0);
+    CHECK(slp::symbol_table().name(0) == nullptr);
+  }
+
+  SECTION("from_data remaps ids by name") {
+    auto obj = slp::parse("(remap-me 1)").take();
+    auto symbols = obj.get_symbols();
+    std::uint64_t original = obj.as_list().at(0).as_symbol_id();
+
+    std::map<std::uint64_t, std::string> foreign;
+    foreign[original + 100000] = symbols.at(original);
+
+    slp::slp_buffer_c data = obj.get_data();
+    auto *unit = reinterpret_cast<slp::slp_unit_of_store_t *>(
+        &data[obj.as_list().at(0).get_root_offset()]);
+    unit->data = static_cast<std::uint32_t>(original + 100000);
+
+    auto restored = slp::slp_object_c::from_data(data, foreign,
+                                                 obj.get_root_offset());
+    CHECK(restored.as_list().at(0).as_symbol_id() == original);
+    CHECK(std::string(restored.as_list().at(0).as_symbol()) == "remap-me");
+  }
+}
+
+namespace {
+
+// Serves source in pieces of at most piece bytes
+slp::slp_stream_parser_c::read_fn_t piece_reader(const std::string &source,
+                                                 size_t piece) {
+  auto offset = std::make_shared<size_t>(0);
+  return [source, piece, offset](char *buffer, size_t capacity) {
+    size_t count = std::min({piece, capacity, source.size() - *offset});
+    source.copy(buffer, count, *offset);
+    *offset += count;
+    return count;
+  };
+}
+
+std::vector<std::pair<std::uint64_t, std::string>>
+drain(slp::slp_stream_parser_c &stream) {
+  std::vector<std::pair<std::uint64_t, std::string>> forms;
+  while (auto form = stream.next()) {
+    REQUIRE(form->result.is_success());
+    auto obj = form->result.take();
+    std::string summary = std::to_string(static_cast<int>(obj.type()));
+    if (obj.type() == slp::slp_type_e::INTEGER) {
+      summary += ":" + std::to_string(obj.as_int());
+    } else if (obj.type() == slp::slp_type_e::SYMBOL) {
+      summary += ":" + std::string(obj.as_symbol());
+    } else if (obj.type() == slp::slp_type_e::DQ_LIST) {
+      summary += ":" + obj.as_string().to_string();
+    } else {
+      summary += ":" + std::to_string(obj.as_list().size());
+    }
+    forms.emplace_back(form->byte_position, summary);
+  }
+  return forms;
+}
+
+} // namespace
+
+TEST_CASE("slp stream parser", "[unit][slp][stream]") {
+  const std::string source = "(a b c) 12345 ; trailing comment (x)\n"
+                             "\"a string\" '(quoted) [nested (list 1 2)]\n"
+                             "symbol-at-end";
+
+  SECTION("memory source yields every top level form with positions") {
+    slp::slp_stream_parser_c stream{std::string_view(source)};
+    auto forms = drain(stream);
+    REQUIRE(forms.size() == 6);
+    CHECK(forms[0].first == 0);
+    CHECK(forms[0].second == "2:3");
+    CHECK(forms[1].first == 8);
+    CHECK(forms[1].second == "9:12345");
+    CHECK(forms[2].first == source.find("\"a string"));
+    CHECK(forms[2].second == "5:a string");
+    CHECK(forms[3].first == source.find("'(quoted)"));
+    CHECK(forms[4].first == source.find("[nested"));
+    CHECK(forms[4].second == "11:2");
+    CHECK(forms[5].second == "7:symbol-at-end");
+    CHECK_FALSE(stream.next().has_value());
+  }
+
+  SECTION("chunked reads match the memory source at any chunk size") {
+    slp::slp_stream_parser_c whole{std::string_view(source)};
+    auto expected = drain(whole);
+
+    for (size_t chunk : {1, 2, 3, 7, 64}) {
+      slp::slp_stream_parser_c stream(piece_reader(source, chunk), chunk);
+      CHECK(drain(stream) == expected);
+    }
+  }
+
+  SECTION("errors end the stream with an absolute position") {
+    const std::string broken = "(ok) (fine) (never closed";
+    slp::slp_stream_parser_c stream(piece_reader(broken, 4), 4);
+
+    REQUIRE(stream.next()->result.is_success());
+    REQUIRE(stream.next()->result.is_success());
+    auto form = stream.next();
+    REQUIRE(form.has_value());
+    REQUIRE(form->result.is_error());
+    CHECK(form->result.error().error_code ==
+          slp::slp_parse_error_e::UNCLOSED_PAREN_LIST);
+    CHECK(form->result.error().byte_position == broken.find("(never"));
+    CHECK_FALSE(stream.next().has_value());
+  }
+
+  SECTION("empty and blank sources yield nothing") {
+    slp::slp_stream_parser_c empty{std::string_view()};
+    CHECK_FALSE(empty.next().has_value());
+
+    slp::slp_stream_parser_c blank(piece_reader("  ; only a comment", 3), 3);
+    CHECK_FALSE(blank.next().has_value());
+  }
+
+  SECTION("mapped files") {
+    auto path = std::filesystem::temp_directory_path() / "slp_stream_test.slp";
+    {
+      std::ofstream out(path);
+      for (int i = 0; i < 1000; i++) {
+        out << "(record " << i << " \"value\")\n";
+      }
+    }
+
+    auto stream = slp::slp_stream_parser_c::open_file(path.string());
+    REQUIRE(stream != nullptr);
+    int count = 0;
+    while (auto form = stream->next()) {
+      auto obj = form->result.take();
+      CHECK(obj.as_list().at(1).as_int() == count);
+      count++;
+    }
+    CHECK(count == 1000);
+
+    std::filesystem::remove(path);
+    CHECK(slp::slp_stream_parser_c::open_file(path.string()) == nullptr);
+  }
+}
+
+TEST_CASE("slp structural index", "[unit][slp][scan]") {
+  const std::string alphabet = " \t\n\r\v\fab19.-+()[]{};\"\\'@#?\x80\xff";
+  std::mt19937 rng(1234);
+
+  SECTION("every scan level classifies like the scalar one") {
+    for (size_t size : {0, 1, 15, 63, 64, 65, 127, 200, 5000}) {
+      std::string source;
+      for (size_t i = 0; i < size; i++) {
+        source += alphabet[rng() % alphabet.size()];
+      }
+
+      for (auto level : {slp::slp_scan_level_e::SSE2,
+                         slp::slp_scan_level_e::AVX2}) {
+        slp::slp_structural_index_c scalar(source,
+                                           slp::slp_scan_level_e::SCALAR);
+        slp::slp_structural_index_c simd(source, level);
+        for (size_t pos = 0; pos <= size; pos++) {
+          REQUIRE(simd.skip_whitespace(pos) == scalar.skip_whitespace(pos));
+          REQUIRE(simd.atom_end(pos) == scalar.atom_end(pos));
+          REQUIRE(simd.string_special(pos) == scalar.string_special(pos));
+          REQUIRE(simd.structural(pos) == scalar.structural(pos));
+        }
+      }
+    }
+  }
+
+  SECTION("positions match a byte by byte scan") {
+    std::string source(9000, 'x');
+    source[10] = ' ';
+    source[4200] = '}';
+    source[8999] = '"';
+    slp::slp_structural_index_c index(source);
+
+    CHECK(index.atom_end(0) == 10);
+    CHECK(index.atom_end(11) == 4200);
+    CHECK(index.string_special(0) == 8999);
+    CHECK(index.skip_whitespace(10) == 11);
+    CHECK(index.atom_end(4201) == source.size());
+    CHECK(index.structural(0) == 4200);
+    CHECK(index.structural(4201) == 8999);
+  }
+}
+
+TEST_CASE("slp numeric literals", "[unit][slp][number]") {
+  CHECK(slp::parse("+42").object().as_int() == 42);
+  CHECK(slp::parse("1.").object().as_real() == 1.0);
+  CHECK(slp::parse("-2.5e2").object().as_real() == -250.0);
+
+  auto overflow = slp::parse("99999999999999999999");
+  REQUIRE(overflow.is_error());
+  CHECK(overflow.error().error_code ==
+        slp::slp_parse_error_e::MALFORMED_NUMERIC_LITERAL);
+
+  auto lone_dot = slp::parse("(1 .)");
+  REQUIRE(lone_dot.is_error());
+  CHECK(lone_dot.error().byte_position == 3);
+}
+
+namespace {
+
+// Renders an object as text so trees from different stores can be compared
+std::string render(const slp::slp_object_c &obj) {
+  switch (obj.type()) {
+  case slp::slp_type_e::INTEGER:
+    return std::to_string(obj.as_int());
+  case slp::slp_type_e::REAL:
+    return std::to_string(obj.as_real());
+  case slp::slp_type_e::SYMBOL:
+    return obj.as_symbol();
+  case slp::slp_type_e::DQ_LIST:
+    return "\"" + obj.as_string().to_string() + "\"";
+  case slp::slp_type_e::SOME:
+  case slp::slp_type_e::ERROR:
+  case slp::slp_type_e::DATUM:
+  case slp::slp_type_e::ABERRANT:
+    return std::to_string(static_cast<int>(obj.type())) + ":" +
+           render(obj.inner());
+  default: {
+    std::string text = std::to_string(static_cast<int>(obj.type())) + "(";
+    auto list = obj.as_list();
+    for (size_t i = 0; i < list.size(); i++) {
+      text += render(list.at(i)) + " ";
+    }
+    return text + ")";
+  }
+  }
+}
+
+std::string make_parallel_source(size_t bytes) {
+  std::string source = "; leading comment\n[\n";
+  for (size_t i = 0; source.size() < bytes; i++) {
+    auto n = std::to_string(i);
+    source += "  (def item-" + n + " {" + n + " -" + n + ".5 \"s (" + n +
+              ") \\\" ]\"})\n";
+    source += "  '(quoted " + n + ") #[datum] @(\"err\") ; (note ]\n";
+    source += "  \"\" () sym-" + n + " 0.1 " + n + "000000000 3e2\n";
+  }
+  return source + "]\n";
+}
+
+} // namespace
+
+TEST_CASE("slp parallel parse", "[unit][slp][parallel]") {
+  const std::string source = make_parallel_source(512 * 1024);
+  auto expected = slp::parse(source);
+  REQUIRE(expected.is_success());
+
+  SECTION("matches the sequential parse at any thread count") {
+    for (size_t threads : {0, 1, 2, 3, 8}) {
+      auto result = slp::parse_parallel(source, threads);
+      REQUIRE(result.is_success());
+      CHECK(result.object().as_list().size() ==
+            expected.object().as_list().size());
+      CHECK(render(result.object()) == render(expected.object()));
+    }
+  }
+
+  SECTION("every offset lands inside one store") {
+    auto result = slp::parse_parallel(source, 4);
+    REQUIRE(result.is_success());
+    auto last = result.object().as_list().at(
+        result.object().as_list().size() - 1);
+    CHECK(last.as_real() == 300.0);
+    CHECK(&slp_test_accessor::get_data(last) ==
+          &slp_test_accessor::get_data(result.object()));
+  }
+
+  SECTION("errors read the same as the sequential parse") {
+    size_t line = source.find('\n', source.size() / 2) + 1;
+    for (const std::string &broken :
+         {source.substr(0, source.size() - 2),
+          source.substr(0, line) + " 99999999999999999999 " +
+              source.substr(line)}) {
+      auto sequential = slp::parse(broken);
+      auto parallel = slp::parse_parallel(broken, 4);
+      REQUIRE(sequential.is_error());
+      REQUIRE(parallel.is_error());
+      CHECK(parallel.error().error_code == sequential.error().error_code);
+      CHECK(parallel.error().byte_position == sequential.error().byte_position);
+    }
+  }
+
+  SECTION("atoms holding brackets or quotes fall back to the sequential parse") {
+    std::string odd = "(" + std::string(300 * 1024, ' ') + "a(b c\"d \"e)f";
+    odd += std::string(300 * 1024, ' ') + ")";
+    auto sequential = slp::parse(odd);
+    auto parallel = slp::parse_parallel(odd, 4);
+    REQUIRE(sequential.is_success() == parallel.is_success());
+    if (sequential.is_success()) {
+      CHECK(render(parallel.object()) == render(sequential.object()));
+    }
+  }
+
+  SECTION("trailing text is ignored as parse() ignores it") {
+    for (const std::string &tail : {" )", " (b", " [c] (d)"}) {
+      auto sequential = slp::parse(source + tail);
+      auto parallel = slp::parse_parallel(source + tail, 4);
+      REQUIRE(sequential.is_success());
+      REQUIRE(parallel.is_success());
+      CHECK(render(parallel.object()) == render(sequential.object()));
+    }
+  }
+
+  SECTION("sources that are not a list parse as usual") {
+    std::string atom(200 * 1024, 'x');
+    auto result = slp::parse_parallel(atom, 4);
+    REQUIRE(result.is_success());
+    CHECK(result.object().type() == slp::slp_type_e::SYMBOL);
+  }
+}
+
+TEST_CASE("slp parallel form parse", "[unit][slp][parallel]") {
+  std::string forms;
+  for (size_t i = 0; i < 40000; i++) {
+    forms += "(item " + std::to_string(i) + " \"v\")\n";
+  }
+  forms += "; trailing comment";
+
+  std::vector<std::string> expected;
+  slp::slp_stream_parser_c stream(forms);
+  while (auto form = stream.next()) {
+    REQUIRE(form->result.is_success());
+    expected.push_back(render(form->result.object()));
+  }
+  REQUIRE(expected.size() == 40000);
+
+  SECTION("every form comes back in order at any thread count") {
+    for (size_t threads : {0, 1, 2, 4}) {
+      auto result = slp::parse_parallel_forms(forms, threads);
+      REQUIRE(result.is_success());
+      REQUIRE(result.size() == expected.size());
+      CHECK(render(result.at(0)) == expected.front());
+      CHECK(render(result.at(20000)) == expected[20000]);
+      CHECK(render(result.at(result.size() - 1)) == expected.back());
+      CHECK(&slp_test_accessor::get_data(result.at(0)) ==
+            &slp_test_accessor::get_data(result.at(result.size() - 1)));
+    }
+  }
+
+  SECTION("one list and a sequence of forms read differently") {
+    auto list = slp::parse_parallel_forms("[a b]", 4);
+    REQUIRE(list.is_success());
+    REQUIRE(list.size() == 1);
+    CHECK(list.at(0).type() == slp::slp_type_e::BRACKET_LIST);
+    CHECK(list.at(0).as_list().size() == 2);
+
+    auto atoms = slp::parse_parallel_forms("a b", 4);
+    REQUIRE(atoms.is_success());
+    REQUIRE(atoms.size() == 2);
+    CHECK(atoms.at(0).type() == slp::slp_type_e::SYMBOL);
+
+    auto single = slp::parse_parallel(forms, 4);
+    REQUIRE(single.is_success());
+    CHECK(render(single.object()) == expected.front());
+
+    auto empty = slp::parse_parallel_forms(" ; nothing\n", 4);
+    REQUIRE(empty.is_success());
+    CHECK(empty.size() == 0);
+  }
+
+  SECTION("a failing form is reported where the stream parser reports it") {
+    std::string broken = forms.substr(0, forms.size() / 2) + "\n(item \"open";
+    std::optional<slp::slp_parse_error_s> streamed;
+    slp::slp_stream_parser_c check(broken);
+    while (auto form = check.next()) {
+      if (form->result.is_error()) {
+        streamed = form->result.error();
+      }
+    }
+    REQUIRE(streamed.has_value());
+
+    auto result = slp::parse_parallel_forms(broken, 4);
+    REQUIRE(result.is_error());
+    CHECK(result.error().error_code == streamed->error_code);
+    CHECK(result.error().byte_position == streamed->byte_position);
+  }
+}
+
+TEST_CASE("slp subtree compaction", "[unit][slp][compact]") {
+  std::string source = "(";
+  for (int i = 0; i < 200; i++) {
+    source += "(entry " + std::to_string(i) + " \"payload text\") ";
+  }
+  source += "[keep 'me {1 2.5 \"s\"} @(err) #datum])";
+
+  auto parsed = slp::parse(source);
+  REQUIRE(parsed.is_success());
+  const auto &root = parsed.object();
+
+  SECTION("a compacted element owns only its own bytes") {
+    auto element = root.as_list().at(200);
+    size_t footprint = element.footprint();
+    CHECK(footprint < root.get_data().size() / 10);
+
+    auto compacted = element.compact();
+    CHECK(compacted.get_data().size() == footprint);
+    CHECK(&compacted.get_data() != &root.get_data());
+    CHECK(render(compacted) == render(element));
+    CHECK(compacted.get_symbols() == element.get_symbols());
+  }
+
+  SECTION("a store holding nothing else is shared, not copied") {
+    CHECK(root.footprint() == root.get_data().size());
+    auto same = root.compact();
+    CHECK(&same.get_data() == &root.get_data());
+
+    auto element = root.as_list().at(7).compact();
+    auto again = element.compact();
+    CHECK(&again.get_data() == &element.get_data());
+  }
+
+  SECTION("scalars and empty lists compact to a single unit") {
+    auto number = root.as_list().at(3).as_list().at(1).compact();
+    CHECK(number.as_int() == 3);
+    CHECK(number.get_data().size() == sizeof(slp::slp_unit_of_store_t));
+    CHECK(slp::slp_object_c().compact().type() == slp::slp_type_e::NONE);
+  }
+}
+
+TEST_CASE("slp images", "[unit][slp][image]") {
+  const std::string source =
+      "[(def greeting \"hello\") {1 -2.5 sym-a sym-a} '(q) @(\"bad\") "
+      "#d ?x () \"\" (nested (deeper [sym-b 7]))]";
+  auto parsed = slp::parse(source);
+  REQUIRE(parsed.is_success());
+  const auto &tree = parsed.object();
+
+  SECTION("memory images round trip") {
+    auto image = slp::write_image(tree);
+    REQUIRE(slp::is_image(std::string_view(
+        reinterpret_cast<const char *>(image.data()), image.size())));
+
+    slp::slp_object_c loaded;
+    std::string error;
+    REQUIRE(slp::read_image(
+        std::string_view(reinterpret_cast<const char *>(image.data()),
+                         image.size()),
+        loaded, error));
+    CHECK(render(loaded) == render(tree));
+    CHECK(loaded.get_symbols() == tree.get_symbols());
+  }
+
+  SECTION("equal trees encode to equal bytes") {
+    auto element = tree.as_list().at(1);
+    auto reparsed = slp::parse("{1 -2.5 sym-a sym-a}");
+    CHECK(slp::write_image(element) == slp::write_image(reparsed.object()));
+    CHECK(slp::write_image(element).size() <
+          slp::write_image(tree).size());
+  }
+
+  SECTION("mapped images view the file in place") {
+    auto path = std::filesystem::temp_directory_path() / "slp_image_test.slpi";
+    auto image = slp::write_image(tree);
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<const char *>(image.data()),
+                static_cast<std::streamsize>(image.size()));
+    }
+
+    slp::slp_object_c mapped;
+    std::string error;
+    REQUIRE(slp::map_image(path.string(), mapped, error));
+    std::filesystem::remove(path);
+
+    CHECK(slp_test_accessor::get_data(mapped).borrowed());
+    CHECK(render(mapped) == render(tree));
+    auto deeper = mapped.as_list().at(8).as_list().at(1).as_list().at(1);
+    CHECK(std::string(deeper.as_list().at(0).as_symbol()) == "sym-b");
+    CHECK(deeper.compact().get_data().borrowed() == false);
+  }
+
+  SECTION("compression round trips when available") {
+    slp::slp_image_options_s options;
+    options.compress = true;
+    auto image = slp::write_image(tree, options);
+
+    slp::slp_object_c loaded;
+    std::string error;
+    REQUIRE(slp::read_image(
+        std::string_view(reinterpret_cast<const char *>(image.data()),
+                         image.size()),
+        loaded, error));
+    CHECK(render(loaded) == render(tree));
+  }
+
+  SECTION("empty objects round trip") {
+    auto image = slp::write_image(slp::slp_object_c());
+    slp::slp_object_c loaded;
+    std::string error;
+    REQUIRE(slp::read_image(
+        std::string_view(reinterpret_cast<const char *>(image.data()),
+                         image.size()),
+        loaded, error));
+    CHECK(loaded.type() == slp::slp_type_e::NONE);
+  }
+
+  SECTION("damaged images are rejected, never read out of bounds") {
+    auto image = slp::write_image(tree);
+    auto as_view = [](const std::vector<std::uint8_t> &bytes) {
+      return std::string_view(reinterpret_cast<const char *>(bytes.data()),
+                              bytes.size());
+    };
+
+    slp::slp_object_c loaded;
+    std::string error;
+
+    auto wrong_version = image;
+    wrong_version[4] = 99;
+    CHECK_FALSE(slp::read_image(as_view(wrong_version), loaded, error));
+    CHECK(error.find("version") != std::string::npos);
+
+    for (size_t size = 0; size < image.size(); size += 7) {
+      std::vector<std::uint8_t> truncated(image.begin(), image.begin() + size);
+      CHECK_FALSE(slp::read_image(as_view(truncated), loaded, error));
+    }
+
+    std::mt19937 rng(99);
+    for (int round = 0; round < 2000; round++) {
+      auto damaged = image;
+      for (int flips = 0; flips < 3; flips++) {
+        damaged[8 + rng() % (damaged.size() - 8)] ^=
+            static_cast<std::uint8_t>(1u << (rng() % 8));
+      }
+      if (slp::read_image(as_view(damaged), loaded, error)) {
+        render(loaded);
+      }
+    }
+  }
+}
+
+TEST_CASE("slp borrowed buffers", "[unit][slp][buffer]") {
+  const std::uint8_t bytes[] = {1, 2, 3, 4};
+  auto buffer = slp::slp_buffer_c::borrow(bytes, sizeof(bytes));
+  CHECK(buffer.borrowed());
+  CHECK(buffer.data() == bytes);
+
+  buffer.resize(2);
+  CHECK_FALSE(buffer.borrowed());
+  CHECK(buffer.data() != bytes);
+  CHECK(buffer[1] == 2);
+
+  auto again = slp::slp_buffer_c::borrow(bytes, sizeof(bytes));
+  slp::slp_buffer_c copy = again;
+  CHECK_FALSE(copy.borrowed());
+  CHECK(copy == again);
+}
+
+TEST_CASE("slp buffer storage", "[unit][slp][buffer]") {
+  constexpr size_t inline_capacity = slp::slp_buffer_c::inline_capacity;
+
+  SECTION("small buffers stay inline across moves") {
+    slp::slp_buffer_c buffer;
+    const std::uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    buffer.insert(0, bytes, sizeof(bytes));
+    CHECK(buffer.capacity() == inline_capacity);
+
+    slp::slp_buffer_c moved = std::move(buffer);
+    CHECK(moved.size() == sizeof(bytes));
+    CHECK(moved[8] == 9);
+    CHECK(buffer.empty());
+
+    slp::slp_buffer_c assigned;
+    assigned = std::move(moved);
+    CHECK(assigned[0] == 1);
+    CHECK(assigned.capacity() == inline_capacity);
+
+    buffer.resize(4);
+    CHECK(buffer[3] == 0);
+  }
+
+  SECTION("growth at least doubles") {
+    slp::slp_buffer_c buffer;
+    size_t last = buffer.capacity();
+    size_t growths = 0;
+    for (size_t i = 0; i < 100000; i++) {
+      std::uint8_t byte = static_cast<std::uint8_t>(i);
+      buffer.insert(buffer.size(), &byte, 1);
+      if (buffer.capacity() != last) {
+        CHECK(buffer.capacity() >= last * 2);
+        last = buffer.capacity();
+        growths++;
+      }
+    }
+    CHECK(growths <= 13);
+    CHECK(buffer[99999] == static_cast<std::uint8_t>(99999));
+
+    slp::slp_buffer_c heap = std::move(buffer);
+    CHECK(heap.size() == 100000);
+    CHECK(buffer.capacity() == inline_capacity);
+  }
+
+  SECTION("scalars fit inline") {
+    CHECK(slp::slp_object_c::create_int(7).get_data().capacity() ==
+          inline_capacity);
+    auto wide = slp::slp_object_c::create_int(1ll << 40);
+    CHECK(wide.get_data().capacity() == inline_capacity);
+    CHECK(wide.as_int() == (1ll << 40));
+    CHECK(slp::slp_object_c::create_real(1.0 / 3.0).as_real() == 1.0 / 3.0);
+    CHECK(slp::slp_object_c::create_aberrant(1ull << 40).as_handle() ==
+          (1ull << 40));
+  }
+}
+
+TEST_CASE("slp unit layout", "[unit][slp][layout]") {
+  constexpr size_t unit = sizeof(slp::slp_unit_of_store_t);
+  CHECK(unit == 8);
+
+  SECTION("small values live in their unit") {
+    auto obj = slp::parse("(1 -2 2.5 sym \"\" ())").take();
+    CHECK(obj.get_data().size() == 7 * unit);
+    CHECK(obj.footprint() == obj.get_data().size());
+    CHECK(obj.as_list().at(1).as_int() == -2);
+    CHECK(obj.as_list().at(2).as_real() == 2.5);
+  }
+
+  SECTION("list elements sit side by side") {
+    auto obj = slp::parse("[a (b c) \"text\" 4 '5]").take();
+    auto list = obj.as_list();
+    size_t first = list.at(0).get_root_offset();
+    for (size_t i = 1; i < list.size(); i++) {
+      CHECK(list.at(i).get_root_offset() == first + i * unit);
+    }
+  }
+
+  SECTION("values too wide for a unit keep every bit") {
+    const std::int64_t ints[] = {
+        std::numeric_limits<std::int32_t>::max(),
+        std::numeric_limits<std::int32_t>::min(),
+        std::int64_t(std::numeric_limits<std::int32_t>::max()) + 1,
+        std::numeric_limits<std::int64_t>::max(),
+        std::numeric_limits<std::int64_t>::min()};
+    for (auto value : ints) {
+      CHECK(slp::slp_object_c::create_int(value).as_int() == value);
+    }
+
+    const double reals[] = {0.1, 1e300, -0.0, 3.4e38, 1e-320};
+    for (auto value : reals) {
+      auto real = slp::slp_object_c::create_real(value);
+      CHECK(real.as_real() == value);
+      CHECK(std::signbit(real.as_real()) == std::signbit(value));
+    }
+    CHECK(std::isnan(
+        slp::slp_object_c::create_real(std::nan("")).as_real()));
+    CHECK(slp::slp_object_c::create_real(2.5).get_data().size() == unit);
+    CHECK(slp::slp_object_c::create_real(0.1).get_data().size() == 2 * unit);
+
+    auto parsed = slp::parse("(5000000000 -0.1 7)").take();
+    CHECK(parsed.as_list().at(0).as_int() == 5000000000);
+    CHECK(parsed.as_list().at(1).as_real() == -0.1);
+    CHECK(parsed.footprint() == parsed.get_data().size());
+
+    std::uint64_t big = std::uint64_t(1) << 40;
+    auto handle = slp::slp_object_c::create_aberrant(big);
+    auto held = slp::slp_object_c::create_paren_list(&handle, 1);
+    CHECK(held.as_list().at(0).as_handle() == big);
+    CHECK(held.as_list().at(0).inner().type() == slp::slp_type_e::NONE);
+  }
+
+  SECTION("strings longer than the count field") {
+    std::string text(slp::SLP_UNIT_FIELD_LONG + 5, 'y');
+    text.back() = 'z';
+    auto obj = slp::slp_object_c::create_string(text);
+    CHECK(obj.as_string().size() == text.size());
+    CHECK(obj.as_string().view() == text);
+    CHECK(obj.footprint() == obj.get_data().size());
+
+    auto image = slp::write_image(obj);
+    slp::slp_object_c loaded;
+    std::string error;
+    REQUIRE(slp::read_image(
+        std::string_view(reinterpret_cast<const char *>(image.data()),
+                         image.size()),
+        loaded, error));
+    CHECK(loaded.as_string().view() == text);
+  }
+
+  SECTION("wide values round trip through images") {
+    auto obj = slp::parse("{5000000000 0.1 @(-9000000000) sym}").take();
+    auto image = slp::write_image(obj);
+    slp::slp_object_c loaded;
+    std::string error;
+    REQUIRE(slp::read_image(
+        std::string_view(reinterpret_cast<const char *>(image.data()),
+                         image.size()),
+        loaded, error));
+    CHECK(render(loaded) == render(obj));
+    CHECK(loaded.as_list().at(1).as_real() == 0.1);
+  }
+}
+
+namespace {
+
+void put_le(std::vector<std::uint8_t> &out, std::uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) {
+    out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+  }
+}
+
+// (sym 7 "str" '-1.5) in the 16 byte unit layout, symbol ids as given
+std::vector<std::uint8_t> legacy_units(std::uint64_t symbol_id,
+                                       size_t &root) {
+  std::vector<std::uint8_t> units;
+  auto add = [&](slp::slp_type_e type, std::uint32_t flags,
+                 std::uint64_t data) {
+    size_t at = units.size();
+    put_le(units, static_cast<std::uint32_t>(type), 4);
+    put_le(units, flags, 4);
+    put_le(units, data, 8);
+    return at;
+  };
+  double real = -1.5;
+  std::uint64_t real_bits;
+  std::memcpy(&real_bits, &real, sizeof(real_bits));
+
+  size_t symbol = add(slp::slp_type_e::SYMBOL, 0, symbol_id);
+  size_t number = add(slp::slp_type_e::INTEGER, 0, 7);
+  size_t string = add(slp::slp_type_e::DQ_LIST, 3, units.size() + 16);
+  put_le(units, 0x727473, 8);
+  size_t inner = add(slp::slp_type_e::REAL, 0, real_bits);
+  size_t quoted = add(slp::slp_type_e::SOME, 0, inner);
+  size_t offsets = units.size();
+  for (size_t element : {symbol, number, string, quoted}) {
+    put_le(units, element, 8);
+  }
+  root = add(slp::slp_type_e::PAREN_LIST, 4, offsets);
+  return units;
+}
+
+} // namespace
+
+TEST_CASE("slp legacy layout", "[unit][slp][legacy]") {
+  auto expected = slp::parse("(sym 7 \"str\" '-1.5)").take();
+  size_t root = 0;
+
+  SECTION("version 1 images are rebuilt") {
+    auto units = legacy_units(0, root);
+    std::vector<std::uint8_t> symbols;
+    put_le(symbols, 1, 4);
+    put_le(symbols, 3, 4);
+    symbols.insert(symbols.end(), {'s', 'y', 'm'});
+    std::vector<std::uint8_t> relocations;
+    put_le(relocations, 1, 4);
+    put_le(relocations, 0, 4);
+
+    std::vector<std::uint8_t> image = {'S', 'L', 'P', 'I'};
+    put_le(image, 1, 2);
+    put_le(image, 0, 2);
+    put_le(image, 3, 4);
+    put_le(image, 0, 4);
+    put_le(image, root, 8);
+    size_t at = 24 + 3 * 32;
+    for (auto *section : {&units, &symbols, &relocations}) {
+      put_le(image, section == &units ? 1 : section == &symbols ? 2 : 3, 4);
+      put_le(image, 0, 4);
+      put_le(image, at, 8);
+      put_le(image, section->size(), 8);
+      put_le(image, section->size(), 8);
+      at += section->size();
+    }
+    for (auto *section : {&units, &symbols, &relocations}) {
+      image.insert(image.end(), section->begin(), section->end());
+    }
+
+    slp::slp_object_c loaded;
+    std::string error;
+    auto view = std::string_view(reinterpret_cast<const char *>(image.data()),
+                                 image.size());
+    REQUIRE(slp::read_image(view, loaded, error));
+    CHECK(render(loaded) == render(expected));
+    CHECK(loaded.footprint() == loaded.get_data().size());
+
+    image[24 + 3 * 32 + root + 4] = 0xFF;
+    CHECK_FALSE(slp::read_image(view, loaded, error));
+  }
+
+  SECTION("raw stores are rebuilt with their symbols renamed") {
+    auto units = legacy_units(424242, root);
+    slp::slp_buffer_c buffer;
+    buffer.insert(0, units.data(), units.size());
+
+    slp::slp_object_c loaded;
+    std::string error;
+    REQUIRE(slp::read_legacy_units(buffer, root, {{424242, "sym"}}, loaded,
+                                   error));
+    CHECK(render(loaded) == render(expected));
+    CHECK(loaded.as_list().at(0).as_symbol_id() ==
+          expected.as_list().at(0).as_symbol_id());
+
+    CHECK_FALSE(slp::read_legacy_units(buffer, root + 8, {}, loaded, error));
+    CHECK_FALSE(
+        slp::read_legacy_units(buffer, units.size(), {}, loaded, error));
+  }
+}
+
+TEST_CASE("slp structural equality", "[unit][slp][equality]") {
+  const std::string source =
+      "(def rule [1 -2.5 \"text\" 'sym {4000000000 0.1} @(err) #(x)])";
+  auto lhs = slp::parse(source).take();
+  auto rhs = slp::parse("(def   rule [1 -2.5 \"text\" 'sym\n"
+                        "  {4000000000 0.1} @(err) #(x)])")
+                 .take();
+
+  SECTION("equal trees in different stores") {
+    CHECK(&lhs.get_data() != &rhs.get_data());
+    CHECK(lhs.equals(rhs));
+    CHECK(rhs.equals(lhs));
+    CHECK(lhs.hash() == rhs.hash());
+    CHECK(lhs.hash() == lhs.hash());
+    CHECK(lhs.as_list().at(2).equals(rhs.as_list().at(2)));
+  }
+
+  SECTION("any difference is seen") {
+    const char *others[] = {
+        "(def rule [1 -2.5 \"text\" 'sym {4000000000 0.1} @(err) #(y)])",
+        "(def rule [1 -2.5 \"texts\" 'sym {4000000000 0.1} @(err) #(x)])",
+        "(def rule [1 -2.5 \"text\" 'sym {4000000001 0.1} @(err) #(x)])",
+        "(def rule [1 -2.5 \"text\" 'sym (4000000000 0.1) @(err) #(x)])",
+        "(def rule [1 -2.5 \"text\" 'sym {4000000000 0.1} @(err)])",
+        "(def rule [1 -2.5 \"text\" sym {4000000000 0.1} @(err) #(x)])",
+        "(def rule [1.0 -2.5 \"text\" 'sym {4000000000 0.1} @(err) #(x)])",
+    };
+    for (const char *text : others) {
+      auto other = slp::parse(text).take();
+      CHECK_FALSE(lhs.equals(other));
+      CHECK_FALSE(other.equals(lhs));
+      CHECK(lhs.hash() != other.hash());
+    }
+  }
+
+  SECTION("views of one unit compare without a walk") {
+    auto view = lhs.share();
+    CHECK(view.equals(lhs));
+    auto element = lhs.as_list().at(2);
+    CHECK(element.equals(lhs.as_list().at(2)));
+    CHECK_FALSE(element.equals(lhs.as_list().at(1)));
+  }
+
+  SECTION("scalars") {
+    CHECK(slp::slp_object_c::create_real(0.0).equals(
+        slp::slp_object_c::create_real(-0.0)));
+    CHECK(slp::slp_object_c::create_real(0.0).hash() ==
+          slp::slp_object_c::create_real(-0.0).hash());
+    CHECK_FALSE(slp::slp_object_c::create_int(0).equals(
+        slp::slp_object_c::create_real(0.0)));
+    CHECK(slp::slp_object_c::create_aberrant(7).equals(
+        slp::slp_object_c::create_aberrant(7)));
+    CHECK_FALSE(slp::slp_object_c::create_aberrant(7).equals(
+        slp::slp_object_c::create_aberrant(8)));
+    CHECK(slp::slp_object_c().equals(slp::slp_object_c()));
+    CHECK(slp::slp_object_c::create_none().equals(
+        slp::slp_object_c::create_paren_list(nullptr, 0)));
+    CHECK_FALSE(slp::slp_object_c().equals(
+        slp::slp_object_c::create_paren_list(nullptr, 0)));
+  }
+
+  SECTION("hash consing shares repeated subtrees") {
+    std::string text = "[";
+    for (int i = 0; i < 64; i++) {
+      text += "(rule \"when matched\" 4000000000 {a b}) ";
+    }
+    text += "(rule \"other\" 1 {a b})]";
+    auto parsed = slp::parse(text).take();
+
+    slp::slp_builder_c builder;
+    builder.set_hash_consing(true);
+    auto consed = builder.take(builder.add_object(parsed));
+
+    CHECK(consed.equals(parsed));
+    CHECK(consed.hash() == parsed.hash());
+    CHECK(consed.get_data().size() * 8 < parsed.get_data().size());
+
+    auto list = consed.as_list();
+    auto first = slp_test_accessor::get_view(list.at(0));
+    auto last = slp_test_accessor::get_view(list.at(63));
+    CHECK(first->header == last->header);
+    CHECK(first->data == last->data);
+    CHECK(list.at(0).equals(list.at(63)));
+    CHECK_FALSE(list.at(0).equals(list.at(64)));
+    CHECK(list.at(64).as_list().at(3).equals(list.at(0).as_list().at(3)));
+    CHECK(render(consed) == render(parsed));
+  }
+}
+
+TEST_CASE("slp constants", "[unit][slp][constants]") {
+  SECTION("small integers share one store per value") {
+    auto a = slp::constant_int(42);
+    auto b = slp::slp_object_c::create_int(42);
+    CHECK(a.as_int() == 42);
+    CHECK(&a.get_data() == &b.get_data());
+    CHECK(a.get_data().size() == sizeof(slp::slp_unit_of_store_t));
+    CHECK(&slp::constant_int(41).get_data() != &a.get_data());
+
+    CHECK(slp::constant_int(slp::constant_int_min).as_int() ==
+          slp::constant_int_min);
+    CHECK(slp::constant_int(slp::constant_int_max).as_int() ==
+          slp::constant_int_max);
+    auto large = slp::constant_int(slp::constant_int_max + 1);
+    CHECK(large.as_int() == slp::constant_int_max + 1);
+    CHECK(&large.get_data() !=
+          &slp::constant_int(slp::constant_int_max + 1).get_data());
+
+    CHECK(slp::constant_bool(true).as_int() == 1);
+    CHECK(slp::constant_bool(false).as_int() == 0);
+  }
+
+  SECTION("none") {
+    auto none = slp::constant_none();
+    CHECK(none.type() == slp::slp_type_e::PAREN_LIST);
+    CHECK(none.as_list().empty());
+    CHECK(&slp::slp_object_c::create_none().get_data() == &none.get_data());
+  }
+
+  SECTION("errors keep the shape parsing gives them") {
+    auto error = slp::constant_error("index out of bounds");
+    CHECK(error.type() == slp::slp_type_e::ERROR);
+    CHECK(error.equals(slp::parse("@(index out of bounds)").object()));
+    CHECK(&slp::constant_error("index out of bounds").get_data() ==
+          &error.get_data());
+
+    auto unparsable = slp::constant_error("unclosed \"quote");
+    CHECK(unparsable.type() == slp::slp_type_e::ERROR);
+    CHECK(unparsable.inner().as_string().to_string() == "unclosed \"quote");
+  }
+
+  SECTION("errors built directly") {
+    auto message = slp::slp_object_c::create_error("disk full");
+    CHECK(message.type() == slp::slp_type_e::ERROR);
+    CHECK(message.equals(slp::parse("@\"disk full\"").object()));
+
+    auto inner = slp::parse("(code 404 \"not found\")").take();
+    auto wrapped = slp::slp_object_c::create_error(inner);
+    CHECK(wrapped.equals(
+        slp::parse("@(code 404 \"not found\")").object()));
+    CHECK(wrapped.get_data().size() == wrapped.footprint());
+  }
+}
+
+TEST_CASE("slp list edits", "[unit][slp][edit]") {
+  auto number = [](long long value) {
+    return slp::slp_object_c::create_int(value);
+  };
+
+  SECTION("set, append, remove and splice") {
+    auto list = slp::parse("(a \"b\" 3 [4 5])").take();
+    CHECK(list.set(1, slp::parse("{x 2.5}").object()));
+    CHECK(list.append(slp::slp_object_c::create_string("tail")));
+    CHECK(list.remove(0));
+    CHECK(list.equals(slp::parse("({x 2.5} 3 [4 5] \"tail\")").object()));
+
+    auto items = slp::parse("(p q)").take();
+    const slp::slp_object_c inserted[] = {items.as_list().at(0),
+                                          items.as_list().at(1)};
+    CHECK(list.splice(1, 2, inserted, 2));
+    CHECK(list.equals(slp::parse("({x 2.5} p q \"tail\")").object()));
+    CHECK(list.splice(2, 100, nullptr, 0));
+    CHECK(list.equals(slp::parse("({x 2.5} p)").object()));
+    CHECK(list.hash() == slp::parse("({x 2.5} p)").object().hash());
+
+    CHECK(list.remove(0));
+    CHECK(list.remove(0));
+    CHECK(list.as_list().empty());
+    CHECK(list.type() == slp::slp_type_e::PAREN_LIST);
+    CHECK(list.append(number(9)));
+    CHECK(list.equals(slp::parse("(9)").object()));
+  }
+
+  SECTION("out of range and non lists change nothing") {
+    auto list = slp::parse("[1 2]").take();
+    CHECK_FALSE(list.set(2, number(0)));
+    CHECK_FALSE(list.remove(2));
+    CHECK_FALSE(list.splice(3, 0, nullptr, 0));
+    CHECK(list.equals(slp::parse("[1 2]").object()));
+
+    auto text = slp::slp_object_c::create_string("abc");
+    CHECK_FALSE(text.append(number(1)));
+    CHECK_FALSE(slp::slp_object_c().append(number(1)));
+  }
+
+  SECTION("shared stores are copied, not written") {
+    auto original = slp::parse("{1 2 3}").take();
+    auto before = original.get_data();
+    auto edited = original.share();
+    CHECK(edited.set(0, number(7)));
+    CHECK(edited.append(number(8)));
+    CHECK(edited.equals(slp::parse("{7 2 3 8}").object()));
+    CHECK(original.equals(slp::parse("{1 2 3}").object()));
+    CHECK(original.get_data() == before);
+    CHECK(&edited.get_data() != &original.get_data());
+
+    auto element = original.as_list().at(1);
+    auto nested = slp::parse("(x (y z))").take();
+    auto inner = nested.as_list().at(1);
+    CHECK(inner.append(element));
+    CHECK(inner.equals(slp::parse("(y z 2)").object()));
+    CHECK(nested.equals(slp::parse("(x (y z))").object()));
+
+    auto none = slp::slp_object_c::create_none();
+    CHECK(none.append(number(1)));
+    CHECK(slp::slp_object_c::create_none().as_list().empty());
+  }
+
+  SECTION("a store held alone is edited where it lies") {
+    auto list = slp::parse("(1)").take();
+    CHECK(list.append(number(2)));
+    const auto *data = &list.get_data();
+    for (long long i = 3; i <= 1000; i++) {
+      REQUIRE(list.append(number(i)));
+    }
+    CHECK(&list.get_data() == data);
+    // Doubling the element run leaves the store within a small multiple of
+    // what the list needs
+    CHECK(list.get_data().size() < list.footprint() * 4);
+
+    auto elements = list.as_list();
+    REQUIRE(elements.size() == 1000);
+    for (size_t i = 0; i < elements.size(); i++) {
+      REQUIRE(elements.at(i).as_int() == static_cast<long long>(i + 1));
+    }
+
+    CHECK(list.append(list));
+    CHECK(list.as_list().size() == 1001);
+    CHECK(list.as_list().at(1000).as_list().size() == 1000);
+  }
+
+  SECTION("replaced elements are reclaimed") {
+    auto list = slp::parse("(\"a\" \"b\")").take();
+    std::string payload(256, 'x');
+    for (int i = 0; i < 500; i++) {
+      REQUIRE(list.set(0, slp::slp_object_c::create_string(payload)));
+    }
+    CHECK(list.get_data().size() < list.footprint() * 3);
+    CHECK(list.as_list().at(0).as_string().to_string() == payload);
+    CHECK(list.as_list().at(1).as_string().to_string() == "b");
+  }
+}
+
+TEST_CASE("slp integer rewrite", "[unit][slp][edit]") {
+  auto counter = slp::slp_object_c::create_int(1000);
+  CHECK(counter.set_int(1001));
+  CHECK(counter.as_int() == 1001);
+  CHECK(counter.equals(slp::slp_object_c::create_int(1001)));
+
+  auto held = counter.share();
+  CHECK_FALSE(counter.set_int(1002));
+  CHECK(held.as_int() == 1001);
+
+  auto wide = slp::slp_object_c::create_int(1ll << 40);
+  CHECK(wide.set_int(-5));
+  CHECK(wide.as_int() == -5);
+  auto narrow = slp::slp_object_c::create_int(70000);
+  CHECK_FALSE(narrow.set_int(1ll << 40));
+  CHECK(narrow.as_int() == 70000);
+
+  CHECK_FALSE(slp::constant_int(7).set_int(8));
+  CHECK(slp::constant_int(7).as_int() == 7);
+  CHECK_FALSE(slp::slp_object_c::create_real(1.5).set_int(1));
+}
@@ -70,3 +70,18 @@ TEST_CASE("type_checker file test - test_error_handling.sxs",
   pkg::core::type_checker::type_checker_c checker(logger, {}, ".");
   CHECK(checker.check_source(source, "test_error_handling.sxs"));
 }
+
+TEST_CASE("type_checker file test - hands back the checked program",
+          "[unit][type_checker][file]") {
+  auto source = load_test_file("test_functions.sxs");
+  auto logger = create_test_logger();
+
+  pkg::core::type_checker::type_checker_c checker(logger, {}, ".");
+  slp::slp_object_c program;
+  REQUIRE(checker.check_source(source, "test_functions.sxs", program));
+
+  auto reparsed = slp::parse(source).take();
+  CHECK(program.type() == reparsed.type());
+  CHECK(program.get_data().size() == reparsed.get_data().size());
+  CHECK(program.get_root_offset() == reparsed.get_root_offset());
+}
@@ -1,4 +1,6 @@
+#include <core/kernels/kernels.hpp>
 #include <core/type_checker/type_checker.hpp>
+#include <filesystem>
 #include <snitch/snitch.hpp>
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/spdlog.h>
@@ -533,3 +535,30 @@ TEST_CASE("kernel error - nonexistent kernel fails",
   CHECK_THROWS_AS(checker.check_expression("#(load \"nonexistent_kernel\")"),
                   std::exception);
 }
+
+TEST_CASE("kernel load - shared definition cache parses kernel.sxs once",
+          "[unit][type_checker][kernel][cache]") {
+  auto logger = create_test_logger();
+  auto kernel_root =
+      std::filesystem::temp_directory_path() / "sxs_kernel_cache_test";
+  std::filesystem::remove_all(kernel_root);
+  std::filesystem::create_directories(kernel_root);
+  std::filesystem::copy(std::filesystem::path(get_test_kernel_path()) / "io",
+                        kernel_root / "io");
+
+  pkg::core::kernels::kernel_definition_cache_c cache;
+  pkg::core::type_checker::type_checker_c checker(
+      logger, {kernel_root.string()}, ".", &cache);
+  checker.check_expression("#(load \"io\")");
+
+  // Served from the cache once the checker has read it
+  std::filesystem::remove(kernel_root / "io" / "kernel.sxs");
+  slp::slp_object_c definition;
+  CHECK(cache.get((kernel_root / "io").string(), logger, definition));
+  CHECK(definition.type() != slp::slp_type_e::NONE);
+
+  pkg::core::kernels::kernel_definition_cache_c empty;
+  CHECK_FALSE(empty.get((kernel_root / "io").string(), logger, definition));
+
+  std::filesystem::remove_all(kernel_root);
+}